@@ -281,7 +281,7 @@ main(int argc, char** argv) {
       prefixMgrInitializationEventsQueue.getReader("spark");
 
   // LinkMonitor -> Spark
-  ReplicateQueue<InterfaceDatabase> interfaceUpdatesQueue;
+  ReplicateQueue<InterfaceDatabaseDelta> interfaceUpdatesQueue;
   auto sparkInterfaceUpdatesQueueReader =
       interfaceUpdatesQueue.getReader("spark");
 
@@ -460,15 +460,18 @@ main(int argc, char** argv) {
   watchdog->addQueue(prefixUpdatesQueue, "prefixUpdatesQueue");
 
   // Start NeighborMonitor
- /* if (config->isNeighborMonitorEnabled()) {
+  if (config->isNeighborMonitorEnabled()) {
     startEventBase(
         allThreads,
         orderedEvbs,
         watchdog,
-        "neighbor-monitor",
-        std::make_unique<NeighborMonitor>(addrEventsQueue));
+        "neighbor_monitor",
+        std::make_unique<NeighborMonitor>(
+            nlSock.get(),
+            netlinkEventsQueue.getReader("neighborMonitor"),
+            addrEventsQueue));
     watchdog->addQueue(addrEventsQueue, "addrEventsQueue");
-  }*/
+  }
 
   // Start Spark
   auto spark = startEventBase(
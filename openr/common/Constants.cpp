@@ -12,6 +12,7 @@ namespace openr {
 constexpr folly::StringPiece Constants::kAdjDbMarker;
 constexpr folly::StringPiece Constants::kDefaultArea;
 constexpr folly::StringPiece Constants::kEventLogCategory;
+constexpr folly::StringPiece Constants::kHeapProfileFilePrefix;
 constexpr folly::StringPiece Constants::kOpenrCtrlSessionContext;
 constexpr folly::StringPiece Constants::kPlatformHost;
 constexpr folly::StringPiece Constants::kPrefixDbMarker;
@@ -27,8 +28,13 @@ constexpr int32_t Constants::kOpenrSupportedVersion;
 constexpr int32_t Constants::kOpenrVersion;
 constexpr int64_t Constants::kDefaultAdjWeight;
 constexpr int64_t Constants::kTtlInfinity;
+constexpr size_t Constants::kInterfaceSyncChunkSize;
 constexpr size_t Constants::kMaxFullSyncPendingCountThreshold;
+constexpr uint64_t Constants::kTransportCompressionSampleRate;
+constexpr int64_t Constants::kTransportCompressionSampleMaxBytes;
 constexpr size_t Constants::kNumTimeSeries;
+constexpr size_t Constants::kTraceRingBufferSize;
+constexpr size_t Constants::kPageMaxScanBucketsPerEntry;
 constexpr std::chrono::milliseconds Constants::kAdjacencyThrottleTimeout;
 constexpr std::chrono::milliseconds Constants::kFibInitialBackoff;
 constexpr std::chrono::milliseconds Constants::kFibMaxBackoff;
@@ -41,8 +47,10 @@ constexpr std::chrono::milliseconds Constants::kKvStoreSyncThrottleTimeout;
 constexpr std::chrono::milliseconds Constants::kLinkImmediateTimeout;
 constexpr std::chrono::milliseconds Constants::kLinkThrottleTimeout;
 constexpr std::chrono::milliseconds Constants::kLongPollReqHoldTime;
+constexpr std::chrono::milliseconds Constants::kNodeSnapshotRefreshInterval;
 constexpr std::chrono::milliseconds Constants::kMaxBackoff;
 constexpr std::chrono::milliseconds Constants::kMaxTtlUpdateInterval;
+constexpr std::chrono::milliseconds Constants::kNetlinkEventLossCheckInterval;
 constexpr std::chrono::milliseconds Constants::kPersistentStoreInitialBackoff;
 constexpr std::chrono::milliseconds Constants::kPersistentStoreMaxBackoff;
 constexpr std::chrono::milliseconds Constants::kPlatformConnTimeout;
@@ -60,11 +68,14 @@ constexpr std::chrono::milliseconds Constants::kTtlThreshold;
 constexpr std::chrono::seconds Constants::kConvergenceMaxDuration;
 constexpr std::chrono::seconds Constants::kCounterSubmitInterval;
 constexpr std::chrono::seconds Constants::kFloodTopoDumpInterval;
+constexpr std::chrono::seconds Constants::kInterfaceAuditInterval;
 constexpr std::chrono::seconds Constants::kMemoryThresholdTime;
 constexpr std::chrono::seconds Constants::kPlatformSyncInterval;
 constexpr std::chrono::seconds Constants::kPlatformThriftIdleTimeout;
 constexpr std::chrono::seconds Constants::kThriftClientKeepAliveInterval;
 constexpr uint16_t Constants::kPerfBufferSize;
 constexpr uint32_t Constants::kMaxAllowedPps;
+constexpr uint32_t Constants::kMaxPrefixDbShardCount;
+constexpr uint32_t Constants::kPolicyResultCacheSize;
 
 } // namespace openr
@@ -47,6 +47,12 @@ class Constants {
   // event log category
   static constexpr folly::StringPiece kEventLogCategory{"perfpipe_aquaman"};
 
+  // path prefix of heap profiles dumped on demand
+  static constexpr folly::StringPiece kHeapProfileFilePrefix{"/tmp/openr"};
+
+  // capacity of per-thread trace span ring buffer, must be power of two
+  static constexpr size_t kTraceRingBufferSize{4096};
+
   // ExponentialBackoff durations
   // Link-monitor, KvStore
   static constexpr std::chrono::milliseconds kInitialBackoff{64};
@@ -74,6 +80,14 @@ class Constants {
   // kMaxBackoff to send the next sync request
   static constexpr size_t kMaxFullSyncPendingCountThreshold{32};
 
+  // One out of this many full-sync responses is sampled to estimate
+  // transport compression savings
+  static constexpr uint64_t kTransportCompressionSampleRate{16};
+
+  // Max key-value bytes of a sampled full-sync response compressed to
+  // estimate transport compression savings. Bounds the work on KvStore evb.
+  static constexpr int64_t kTransportCompressionSampleMaxBytes{256 * 1024};
+
   // Invalid version for thrift::Value
   // If version is undefined, then thrift::Value
   // is not valid
@@ -116,6 +130,23 @@ class Constants {
   // Adjacency DOWN event is immediately advertised.
   static constexpr std::chrono::milliseconds kAdjacencyThrottleTimeout{1000};
 
+  // LinkMonitor relies on netlink LINK/ADDR events to track interfaces. Full
+  // interface dump from netlink is done at startup, upon detected event loss
+  // (checked every kNetlinkEventLossCheckInterval) or every
+  // kInterfaceAuditInterval as a safety net.
+  static constexpr std::chrono::milliseconds kNetlinkEventLossCheckInterval{
+      1000};
+  static constexpr std::chrono::seconds kInterfaceAuditInterval{1800};
+
+  // Number of interfaces applied from full dump before yielding to other
+  // fibers, e.g. netlink event processing
+  static constexpr size_t kInterfaceSyncChunkSize{256};
+
+  // Max number of hash buckets scanned for a paginated dump, per entry of
+  // requested page size. Bounds the time a module spends on a single page when
+  // most entries are filtered out.
+  static constexpr size_t kPageMaxScanBucketsPerEntry{16};
+
   //
   // Spark specific
   //
@@ -193,6 +224,12 @@ class Constants {
   static constexpr folly::StringPiece kAdjDbMarker{"adj:"};
   static constexpr folly::StringPiece kPrefixDbMarker{"prefix:"};
 
+  // max number of bulk prefix database shards a node advertises per area
+  static constexpr uint32_t kMaxPrefixDbShardCount{4096};
+
+  // max number of memoized policy evaluation results in PolicyManager
+  static constexpr uint32_t kPolicyResultCacheSize{200000};
+
   static constexpr folly::StringPiece kOpenrCtrlSessionContext{"OpenrCtrl"};
 
   // max interval to update TTL for each key in kvstore w/ finite TTL
@@ -217,6 +254,11 @@ class Constants {
   // hold time for longPoll requests in openrCtrl thrift server
   static constexpr std::chrono::milliseconds kLongPollReqHoldTime{20000};
 
+  // max age of cached node snapshot served by getNodeSnapshot(). Older one is
+  // re-collected on demand.
+  static constexpr std::chrono::milliseconds kNodeSnapshotRefreshInterval{
+      5000};
+
   //
   // Prefix manager specific
   //
@@ -68,3 +68,15 @@ DEFINE_int32(
     stream_expire_time,
     0,
     "Server side streaming expiration timeout in millisecond. If 0, then it's infinite.");
+
+DEFINE_bool(
+    enable_module_arenas,
+    false,
+    "Bind every module thread to its own jemalloc arena to account memory "
+    "allocated per module. No-op if not running with jemalloc.");
+
+DEFINE_uint32(
+    decision_rib_compute_threads,
+    4,
+    "Number of Decision worker threads computing route databases of many "
+    "nodes in batch, e.g. all nodes RIB requested by a controller");
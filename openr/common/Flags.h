@@ -37,3 +37,9 @@ DECLARE_string(rib_policy_file);
 
 // streaming related property
 DECLARE_int32(stream_expire_time);
+
+// per-module memory accounting
+DECLARE_bool(enable_module_arenas);
+
+// batch route computation of multiple nodes
+DECLARE_uint32(decision_rib_compute_threads);
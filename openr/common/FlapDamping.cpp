@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cmath>
+
+#include <folly/logging/xlog.h>
+
+#include <openr/common/FlapDamping.h>
+
+namespace openr {
+
+FlapDamping::FlapDamping(const thrift::FlapDampingConfig& config)
+    : penaltyPerFlap_(*config.penalty_per_flap()),
+      suppressThreshold_(*config.suppress_threshold()),
+      reuseThreshold_(*config.reuse_threshold()),
+      halfLife_(*config.half_life_ms()) {
+  XCHECK_GT(halfLife_.count(), 0) << "Half-life must be positive value";
+  XCHECK_LT(reuseThreshold_, suppressThreshold_)
+      << "Reuse threshold must be less than suppress threshold";
+
+  maxPenalty_ = reuseThreshold_ *
+      std::exp2(
+          static_cast<double>(*config.max_suppress_ms()) / halfLife_.count());
+}
+
+double
+FlapDamping::getPenalty(Clock::time_point now) const {
+  if (penalty_ == 0 or now <= lastUpdateTime_) {
+    return penalty_;
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      now - lastUpdateTime_);
+  return penalty_ *
+      std::exp2(-static_cast<double>(elapsed.count()) / halfLife_.count());
+}
+
+bool
+FlapDamping::reportFlap(Clock::time_point now) {
+  penalty_ = std::min(getPenalty(now) + penaltyPerFlap_, maxPenalty_);
+  lastUpdateTime_ = now;
+
+  if (not suppressed_ and penalty_ >= suppressThreshold_) {
+    suppressed_ = true;
+    return true;
+  }
+  return false;
+}
+
+bool
+FlapDamping::isSuppressed(Clock::time_point now) {
+  if (suppressed_ and getPenalty(now) < reuseThreshold_) {
+    suppressed_ = false;
+  }
+  return suppressed_;
+}
+
+std::chrono::milliseconds
+FlapDamping::getTimeUntilReuse(Clock::time_point now) const {
+  if (not suppressed_) {
+    return std::chrono::milliseconds(0);
+  }
+  const auto penalty = getPenalty(now);
+  if (penalty < reuseThreshold_) {
+    return std::chrono::milliseconds(0);
+  }
+  // penalty * 2^(-t / halfLife) < reuse => t > halfLife * log2(penalty/reuse)
+  return std::chrono::milliseconds(
+      static_cast<int64_t>(
+          std::ceil(halfLife_.count() * std::log2(penalty / reuseThreshold_))) +
+      1);
+}
+
+bool
+FlapDamping::isDecayed(Clock::time_point now) const {
+  return (not suppressed_) and getPenalty(now) < 1;
+}
+
+} // namespace openr
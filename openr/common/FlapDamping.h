@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include <openr/if/gen-cpp2/OpenrConfig_types.h>
+
+namespace openr {
+
+/**
+ * Figure-of-merit flap damping.
+ *
+ * Every flap adds a fixed penalty which decays exponentially over time with
+ * configured half-life. Once penalty reaches suppress threshold, the object is
+ * suppressed until penalty decays below reuse threshold. Unlike exponential
+ * backoff, penalty accumulates across flaps spaced wider than the backoff
+ * window, so periodic flapping eventually gets suppressed.
+ */
+class FlapDamping {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit FlapDamping(const thrift::FlapDampingConfig& config);
+
+  /**
+   * Record a flap. Return true if object transitions into suppressed state.
+   */
+  bool reportFlap(Clock::time_point now = Clock::now());
+
+  /**
+   * Whether object is suppressed. Clears suppression once penalty decays
+   * below reuse threshold.
+   */
+  bool isSuppressed(Clock::time_point now = Clock::now());
+
+  /**
+   * Current penalty after decay
+   */
+  double getPenalty(Clock::time_point now = Clock::now()) const;
+
+  /**
+   * Time remaining until suppressed object can be reused. Zero if object is
+   * not suppressed.
+   */
+  std::chrono::milliseconds getTimeUntilReuse(
+      Clock::time_point now = Clock::now()) const;
+
+  /**
+   * Whether penalty has decayed enough for the state to be discarded
+   */
+  bool isDecayed(Clock::time_point now = Clock::now()) const;
+
+ private:
+  const double penaltyPerFlap_{0};
+  const double suppressThreshold_{0};
+  const double reuseThreshold_{0};
+  const std::chrono::milliseconds halfLife_{0};
+
+  // Ceiling of penalty so that suppression lasts at most `max_suppress_ms`
+  // after last flap
+  double maxPenalty_{0};
+
+  // Penalty as of `lastUpdateTime_`
+  double penalty_{0};
+  Clock::time_point lastUpdateTime_{};
+
+  bool suppressed_{false};
+};
+
+} // namespace openr
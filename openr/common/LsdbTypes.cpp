@@ -5,7 +5,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <limits>
+
 #include <fmt/core.h>
+#include <folly/hash/Hash.h>
 
 #include <openr/common/LsdbTypes.h>
 
@@ -50,4 +53,48 @@ PrefixKey::fromStr(const std::string& key, const std::string& areaIn) {
   return PrefixKey(node, network, areaIn);
 }
 
+PrefixShardKey::PrefixShardKey(std::string const& node, uint32_t shardId)
+    : node_(node),
+      shardId_(shardId),
+      prefixShardKeyString_(fmt::format(
+          "{}{}:{}", Constants::kPrefixDbMarker.toString(), node, shardId)) {}
+
+folly::Expected<PrefixShardKey, std::string>
+PrefixShardKey::fromStr(const std::string& key) {
+  std::string node{};
+  uint64_t shardId{0};
+
+  auto patt = RE2::FullMatch(
+      key, PrefixShardKey::getPrefixShardRE2(), &node, &shardId);
+  if (not patt or shardId > std::numeric_limits<uint32_t>::max()) {
+    return folly::makeUnexpected(
+        fmt::format("Invalid format for key: {}.", key));
+  }
+  return PrefixShardKey(node, static_cast<uint32_t>(shardId));
+}
+
+uint32_t
+PrefixShardKey::getShardId(
+    folly::CIDRNetwork const& prefix, uint32_t numShards) {
+  CHECK_GT(numShards, 0);
+
+  // Hash of prefix must be stable across restarts and releases, hence do NOT
+  // use std::hash.
+  uint64_t key = folly::hash::fnv64(folly::IPAddress::networkToString(prefix));
+
+  // Jump consistent hash (Lamping & Veach). Only ~1/numShards of prefixes
+  // move to another shard when the number of shards changes.
+  int64_t bucket{-1};
+  int64_t next{0};
+  while (next < static_cast<int64_t>(numShards)) {
+    bucket = next;
+    key = key * 2862933555777941757ULL + 1;
+    next = static_cast<int64_t>(
+        (bucket + 1) *
+        (static_cast<double>(1LL << 31) /
+         static_cast<double>((key >> 33) + 1)));
+  }
+  return static_cast<uint32_t>(bucket);
+}
+
 } // namespace openr
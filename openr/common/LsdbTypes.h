@@ -119,6 +119,12 @@ struct NeighborEvent {
    */
   bool adjOnlyUsedByOtherNode{false};
 
+  /**
+   * trace id of convergence event triggered by this neighbor event. Zero if
+   * not traced.
+   */
+  int64_t traceId{0};
+
   NeighborEvent(
       const NeighborEventType& eventType,
       const std::string& nodeName,
@@ -188,15 +194,15 @@ enum class PrefixEventType {
 };
 
 /**
- * Event for indicating that a IPv6 addr's resolvabllity to Spark, with
+ * Event for indicating that a neighbor addr's resolvabllity to Spark, with
  * the interface information. Only used for inter module communication
  */
 struct AddressEvent {
   // Whether is address is resolvable (can be reached directly).
   bool resolvable = false;
 
-  // The IPv6 Address of intrest.
-  thrift::BinaryAddress v6Addr;
+  // The IPv6 link-local or IPv4 Address of intrest.
+  thrift::BinaryAddress addr;
 
   // The interface name that this address belong to.
   std::string ifName;
@@ -421,6 +427,35 @@ struct InterfaceInfo {
  */
 using InterfaceDatabase = std::vector<InterfaceInfo>;
 
+/**
+ * Interface updates published by LinkMonitor towards Spark. It carries either
+ * the full snapshot of interfaces (`isFullSync` set, any interface not in
+ * `updatedInterfaces` is considered removed) or only the interfaces that got
+ * added/changed since the last publication. LinkMonitor never forgets an
+ * interface, a deleted link is published as down.
+ */
+struct InterfaceDatabaseDelta {
+  /**
+   * True if `updatedInterfaces` represents the entire interface database
+   */
+  bool isFullSync{false};
+
+  /**
+   * Interfaces added or changed since last publication
+   */
+  InterfaceDatabase updatedInterfaces{};
+
+  InterfaceDatabaseDelta() {}
+
+  /* implicit */ InterfaceDatabaseDelta(InterfaceDatabase ifDb)
+      : isFullSync(true), updatedInterfaces(std::move(ifDb)) {}
+
+  bool
+  empty() const {
+    return (not isFullSync) and updatedInterfaces.empty();
+  }
+};
+
 /**
  * PrefixKey class to form and parse a PrefixKey. PrefixKey can be instantiated
  * by passing parameters to form a key, or by passing the key string to parse
@@ -496,6 +531,63 @@ class PrefixKey {
   std::string const prefixKeyStringV2_;
 };
 
+/**
+ * PrefixShardKey class to form and parse key of a bulk prefix database shard.
+ * With sharded encoding, a node packs all prefixes it advertises into an area
+ * into a bounded number of keys of format `prefix:<node>:<shardId>`. Each
+ * prefix is assigned to a shard by consistent hashing, so one prefix change
+ * only rewrites one shard.
+ */
+class PrefixShardKey {
+ public:
+  // constructor using node and shard id
+  PrefixShardKey(std::string const& node, uint32_t shardId);
+
+  // construct PrefixShardKey object from a give key string
+  static folly::Expected<PrefixShardKey, std::string> fromStr(
+      const std::string& key);
+
+  // return shard id of the prefix for given number of shards
+  static uint32_t getShardId(
+      folly::CIDRNetwork const& prefix, uint32_t numShards);
+
+  static const RE2&
+  getPrefixShardRE2() {
+    static const RE2 prefixShardKeyPattern{fmt::format(
+        "{}(?P<node>[a-zA-Z\\d\\.\\-\\_]+):(?P<shard>[\\d]{{1,10}})",
+        Constants::kPrefixDbMarker.toString())};
+    return prefixShardKeyPattern;
+  }
+
+  // return node name
+  inline std::string const&
+  getNodeName() const {
+    return node_;
+  }
+
+  // return shard id
+  inline uint32_t
+  getShardId() const {
+    return shardId_;
+  }
+
+  // return raw prefix shard key string from kvstore
+  inline std::string const&
+  getPrefixShardKey() const {
+    return prefixShardKeyString_;
+  }
+
+ private:
+  // node name
+  std::string const node_;
+
+  // shard id within [0, numShards)
+  uint32_t const shardId_{0};
+
+  // raw key string from KvStore
+  std::string const prefixShardKeyString_;
+};
+
 } // namespace openr
 
 template <>
@@ -13,6 +13,7 @@
 #include <folly/logging/xlog.h>
 
 #include <openr/common/Constants.h>
+#include <openr/if/gen-cpp2/KvStore_types.h>
 #include <thrift/lib/cpp2/async/RocketClientChannel.h>
 
 namespace openr {
@@ -20,10 +21,25 @@ namespace openr {
 namespace detail {
 
 static void
-setCompressionTransform(apache::thrift::ClientChannel* channel) {
+setCompressionTransform(
+    apache::thrift::ClientChannel* channel,
+    const thrift::TransportCompressionConfig& config) {
   CHECK(channel);
   apache::thrift::CompressionConfig compressionConfig;
-  compressionConfig.codecConfig().ensure().set_zstdConfig();
+  switch (*config.codec()) {
+  case thrift::TransportCompressionCodec::NONE:
+    return;
+  case thrift::TransportCompressionCodec::ZLIB:
+    compressionConfig.codecConfig().ensure().set_zlibConfig();
+    break;
+  case thrift::TransportCompressionCodec::ZSTD:
+  default:
+    compressionConfig.codecConfig().ensure().set_zstdConfig();
+  }
+  if (*config.min_compress_size_bytes() > 0) {
+    compressionConfig.compressionSizeLimit() =
+        *config.min_compress_size_bytes();
+  }
   channel->setDesiredCompressionConfig(compressionConfig);
 }
 
@@ -65,7 +81,8 @@ getOpenrCtrlPlainTextClient(
     std::chrono::milliseconds processingTimeout =
         Constants::kServiceProcTimeout,
     const folly::SocketAddress& bindAddr = folly::AsyncSocket::anyAddress(),
-    std::optional<int> maybeIpTos = std::nullopt) {
+    std::optional<int> maybeIpTos = std::nullopt,
+    const thrift::TransportCompressionConfig& compressionConfig = {}) {
   // NOTE: It is possible to have caching for socket. We're not doing it as
   // we expect clients to be persistent/sticky.
   std::unique_ptr<ClientType> client{nullptr};
@@ -91,7 +108,7 @@ getOpenrCtrlPlainTextClient(
     // Enable compression for efficient transport when available. This will
     // incur CPU cost but it is insignificant for usual queries.
     if (typeid(ClientChannel) == typeid(apache::thrift::RocketClientChannel)) {
-      detail::setCompressionTransform(channel.get());
+      detail::setCompressionTransform(channel.get(), compressionConfig);
     }
 
     // Create client
@@ -118,7 +135,8 @@ getOpenrCtrlSecureClient(
     std::chrono::milliseconds processingTimeout =
         Constants::kServiceProcTimeout,
     const folly::SocketAddress& bindAddr = folly::AsyncSocket::anyAddress(),
-    std::optional<int> maybeIpTos = std::nullopt) {
+    std::optional<int> maybeIpTos = std::nullopt,
+    const thrift::TransportCompressionConfig& compressionConfig = {}) {
   // NOTE: It is possible to have caching for socket. We're not doing it as
   // we expect clients to be persistent/sticky.
   std::unique_ptr<ClientType> client{nullptr};
@@ -144,7 +162,7 @@ getOpenrCtrlSecureClient(
 
     // Enable compression for efficient transport when available. This will
     // incur CPU cost but it is insignificant for usual queries.
-    detail::setCompressionTransform(channel.get());
+    detail::setCompressionTransform(channel.get(), compressionConfig);
 
     // Create client
     client = std::make_unique<ClientType>(std::move(channel));
@@ -5,14 +5,28 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
+#include <fmt/format.h>
 #include <folly/fibers/FiberManagerMap.h>
 #include <folly/logging/xlog.h>
 
+#include <openr/common/Flags.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/Util.h>
+
+namespace fb303 = facebook::fb303;
 
 namespace openr {
 
 namespace {
+// One out of this many loop iterations and callbacks is sampled into
+// event-base health metrics
+constexpr uint32_t kHealthSampleRate{8};
+
+// Buckets of event-base health histograms, in microseconds
+constexpr int64_t kHealthHistogramBucketUs{500};
+constexpr int64_t kHealthHistogramMaxUs{50000};
+
 folly::fibers::FiberManager::Options
 getFmOptions() {
   folly::fibers::FiberManager::Options options;
@@ -20,6 +34,42 @@ getFmOptions() {
   options.stackSize = 256 * 1024;
   return options;
 }
+
+void
+addHealthHistogram(const std::string& key) {
+  fb303::fbData->addHistogram(
+      key, kHealthHistogramBucketUs, 0, kHealthHistogramMaxUs);
+  fb303::fbData->exportHistogramPercentile(key, 50, 95, 99);
+}
+
+int64_t
+getElapsedUs(std::chrono::steady_clock::time_point startTs) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - startTs)
+      .count();
+}
+
+/*
+ * Report busy time of sampled event loop iterations, i.e. time spent running
+ * callbacks excluding time blocked waiting for events.
+ */
+class LoopBusyTimeObserver : public folly::EventBaseObserver {
+ public:
+  explicit LoopBusyTimeObserver(std::string key) : key_(std::move(key)) {}
+
+  uint32_t
+  getSampleRate() const override {
+    return kHealthSampleRate;
+  }
+
+  void
+  loopSample(int64_t busyTimeUs, int64_t /* idleTimeUs */) override {
+    fb303::fbData->addHistogramValue(key_, busyTimeUs);
+  }
+
+ private:
+  const std::string key_;
+};
 } // namespace
 
 EventBaseStopSignalHandler::EventBaseStopSignalHandler(folly::EventBase* evb)
@@ -37,12 +87,11 @@ EventBaseStopSignalHandler::signalReceived(int signal) noexcept {
 }
 
 OpenrEventBase::OpenrEventHandler::OpenrEventHandler(
-    folly::EventBase* evb, int fd, int events, SocketCallback callback)
-    : folly::EventHandler(evb, folly::NetworkSocket::fromFd(fd)),
+    OpenrEventBase* parent, int fd, int events, SocketCallback callback)
+    : folly::EventHandler(parent->getEvb(), folly::NetworkSocket::fromFd(fd)),
+      parent_(parent),
       callback_(std::move(callback)),
       events_(events) {
-  // Make sure evb is not nullptr
-  CHECK(evb);
 
   // Register handler
   registerHandler(folly::EventHandler::PERSIST | events_);
@@ -52,7 +101,13 @@ void
 OpenrEventBase::OpenrEventHandler::handlerReady(uint16_t events) noexcept {
   // Invoke callback if there is an overlap
   if (events & events_) {
+    if (not parent_->shouldSampleCallback()) {
+      callback_(events);
+      return;
+    }
+    const auto startTs = Clock::now();
     callback_(events);
+    parent_->recordCallback(startTs);
   }
 }
 
@@ -65,6 +120,9 @@ OpenrEventBase::OpenrEventBase()
   timeout_ = folly::AsyncTimeout::make(evb_, [this]() noexcept {
     timestamp_.store(
         std::chrono::steady_clock::now().time_since_epoch().count());
+    if (healthMetricsEnabled_) {
+      sampleFiberHealth();
+    }
     timeout_->scheduleTimeout(std::chrono::seconds(1));
   });
   timeout_->scheduleTimeout(0);
@@ -72,8 +130,79 @@ OpenrEventBase::OpenrEventBase()
 
 OpenrEventBase::~OpenrEventBase() {}
 
+void
+OpenrEventBase::setEvbName(std::string name) {
+  evbName_ = std::move(name);
+
+  loopBusyKey_ = fmt::format("evb.{}.loop_busy_us", evbName_);
+  callbackKey_ = fmt::format("evb.{}.callback_us", evbName_);
+  queueDelayKey_ = fmt::format("evb.{}.queue_delay_us", evbName_);
+  fiberRunnableKey_ = fmt::format("evb.{}.fiber_runnable_us", evbName_);
+  fiberQueueDepthKey_ = fmt::format("evb.{}.fiber_queue_depth", evbName_);
+  for (const auto& key :
+       {loopBusyKey_, callbackKey_, queueDelayKey_, fiberRunnableKey_}) {
+    addHealthHistogram(key);
+  }
+  evb_.setObserver(std::make_shared<LoopBusyTimeObserver>(loopBusyKey_));
+  healthMetricsEnabled_ = true;
+}
+
+bool
+OpenrEventBase::shouldSampleCallback() noexcept {
+  return healthMetricsEnabled_ and
+      numCallbacks_.fetch_add(1, std::memory_order_relaxed) %
+          kHealthSampleRate ==
+      0;
+}
+
+void
+OpenrEventBase::recordCallback(Clock::time_point startTs) noexcept {
+  fb303::fbData->addHistogramValue(callbackKey_, getElapsedUs(startTs));
+}
+
+void
+OpenrEventBase::sampleFiberHealth() noexcept {
+  fb303::fbData->addStatValue(
+      fiberQueueDepthKey_, fiberManager_.runQueueSize(), fb303::AVG);
+
+  // Probe how long a newly ready fiber waits before it gets to run
+  fiberManager_.addTask([this, readyTs = Clock::now()]() noexcept {
+    fb303::fbData->addHistogramValue(fiberRunnableKey_, getElapsedUs(readyTs));
+  });
+}
+
+void
+OpenrEventBase::runInEventBaseThread(folly::EventBase::Func callback) {
+  if (not shouldSampleCallback()) {
+    evb_.runInEventBaseThread(std::move(callback));
+    return;
+  }
+
+  evb_.runInEventBaseThread([this,
+                             enqueueTs = Clock::now(),
+                             callback = std::move(callback)]() mutable {
+    const auto startTs = Clock::now();
+    fb303::fbData->addHistogramValue(
+        queueDelayKey_,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            startTs - enqueueTs)
+            .count());
+    callback();
+    recordCallback(startTs);
+  });
+}
+
 void
 OpenrEventBase::run() {
+  // Account memory of named (module) event-bases in dedicated arena. Thread
+  // running the loop can change across restarts, always (re)bind it.
+  if (not evbName_.empty() and FLAGS_enable_module_arenas) {
+    if (arena_.has_value()) {
+      memory::bindThreadArena(*arena_);
+    } else {
+      arena_ = memory::createModuleArena(evbName_);
+    }
+  }
   evb_.loopForever();
 }
 
@@ -105,15 +234,26 @@ OpenrEventBase::waitUntilStopped() {
 void
 OpenrEventBase::scheduleTimeout(
     std::chrono::milliseconds timeout, folly::EventBase::Func callback) {
-  evb_.scheduleAt(
-      std::move(callback), timeout + std::chrono::steady_clock::now());
+  scheduleTimeoutAt(
+      timeout + std::chrono::steady_clock::now(), std::move(callback));
 }
 
 void
 OpenrEventBase::scheduleTimeoutAt(
     std::chrono::steady_clock::time_point scheduleTime,
     folly::EventBase::Func callback) {
-  evb_.scheduleAt(std::move(callback), scheduleTime);
+  if (not shouldSampleCallback()) {
+    evb_.scheduleAt(std::move(callback), scheduleTime);
+    return;
+  }
+
+  evb_.scheduleAt(
+      [this, callback = std::move(callback)]() mutable {
+        const auto startTs = Clock::now();
+        callback();
+        recordCallback(startTs);
+      },
+      scheduleTime);
 }
 
 void
@@ -124,7 +264,7 @@ OpenrEventBase::addSocketFd(int socketFd, int events, SocketCallback callback) {
   fdHandlers_.emplace(
       std::piecewise_construct,
       std::forward_as_tuple(socketFd),
-      std::forward_as_tuple(&evb_, socketFd, events, std::move(callback)));
+      std::forward_as_tuple(this, socketFd, events, std::move(callback)));
 }
 
 void
@@ -63,10 +63,7 @@ class OpenrEventBase {
   /**
    * EventBase API aliases
    */
-  void
-  runInEventBaseThread(folly::EventBase::Func callback) {
-    evb_.runInEventBaseThread(std::move(callback));
-  }
+  void runInEventBaseThread(folly::EventBase::Func callback);
 
   /**
    * Get latest timestamp of health check timer
@@ -118,19 +115,28 @@ class OpenrEventBase {
     return evbName_;
   }
 
-  void
-  setEvbName(std::string name) {
-    evbName_ = name;
-  }
+  /**
+   * Name event-base and enable its health metrics, exported through fb303
+   * under `evb.<name>.` prefix:
+   *  - loop_busy_us: busy time of event loop iteration
+   *  - callback_us: execution time of callbacks run through this class
+   *  - queue_delay_us: delay of `runInEventBaseThread()` callbacks
+   *  - fiber_runnable_us: delay of ready fiber until it gets to run
+   *  - fiber_queue_depth: number of fibers ready to run
+   * Loop iterations and callbacks are sampled. Must be called before `run()`.
+   */
+  void setEvbName(std::string name);
 
  private:
+  using Clock = std::chrono::steady_clock;
+
   /**
    * Event handler class for sockets and fds
    */
   class OpenrEventHandler : public folly::EventHandler {
    public:
     OpenrEventHandler(
-        folly::EventBase* evb, int fd, int events, SocketCallback callback);
+        OpenrEventBase* parent, int fd, int events, SocketCallback callback);
 
     virtual ~OpenrEventHandler() override {}
 
@@ -138,6 +144,9 @@ class OpenrEventBase {
     // EventHandler callback. Unblocks read/write wait
     void handlerReady(uint16_t events) noexcept override;
 
+    // Owning event-base, used for health metrics
+    OpenrEventBase* parent_{nullptr};
+
     // Callback for handling event
     SocketCallback callback_;
 
@@ -161,6 +170,32 @@ class OpenrEventBase {
 
   // Unique name to identify eventbase
   std::string evbName_;
+
+  // Dedicated jemalloc arena of this event-base, see `memory::` utils
+  std::optional<unsigned> arena_;
+
+  /**
+   * [Health Metrics]
+   */
+
+  // Decide whether next callback is sampled into health metrics
+  bool shouldSampleCallback() noexcept;
+
+  // Record callback execution time, started at `startTs`
+  void recordCallback(Clock::time_point startTs) noexcept;
+
+  // Sample fiber manager state. Called periodically from health check timer.
+  void sampleFiberHealth() noexcept;
+
+  bool healthMetricsEnabled_{false};
+  std::atomic<uint64_t> numCallbacks_{0};
+
+  // fb303 keys, see `setEvbName()`
+  std::string loopBusyKey_;
+  std::string callbackKey_;
+  std::string queueDelayKey_;
+  std::string fiberRunnableKey_;
+  std::string fiberQueueDepthKey_;
 };
 
 } // namespace openr
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include <folly/IPAddress.h>
+
+namespace openr {
+
+/*
+ * Binary (uni-bit) trie keyed by IP network. Lookup of all stored networks
+ * containing a given address walks at most one node per address bit, i.e.
+ * O(32) for v4 and O(128) for v6, independent of the number of networks
+ * stored. V4 and V6 networks are kept in separate sub-tries.
+ *
+ * Meant for small and mostly static sets of networks (e.g. originated
+ * aggregates) which are matched against a large stream of addresses.
+ */
+template <typename ValueType>
+class PrefixTrie {
+ public:
+  /*
+   * Insert or overwrite value for the given network. Return true if the
+   * network was not present before.
+   */
+  bool
+  insert(const folly::CIDRNetwork& network, ValueType value) {
+    const auto& [addr, len] = network;
+    auto* node = &root(addr);
+    for (uint8_t i = 0; i < len; ++i) {
+      auto& child = node->children[addr.getNthMSBit(i)];
+      if (not child) {
+        child = std::make_unique<Node>();
+      }
+      node = child.get();
+    }
+    const bool inserted = not node->value.has_value();
+    node->value = std::move(value);
+    size_ += inserted ? 1 : 0;
+    return inserted;
+  }
+
+  /*
+   * Return value stored for the exact network, if any.
+   */
+  const ValueType*
+  find(const folly::CIDRNetwork& network) const {
+    const auto& [addr, len] = network;
+    const auto* node = &root(addr);
+    for (uint8_t i = 0; i < len and node; ++i) {
+      node = node->children[addr.getNthMSBit(i)].get();
+    }
+    return (node and node->value.has_value()) ? &node->value.value() : nullptr;
+  }
+
+  /*
+   * Invoke `fn(network, value)` for every stored network containing `addr`,
+   * from the least to the most specific one.
+   */
+  template <typename Fn>
+  void
+  forEachContaining(const folly::IPAddress& addr, Fn&& fn) const {
+    const auto* node = &root(addr);
+    const auto bitCount = addr.bitCount();
+    for (size_t i = 0; node; ++i) {
+      if (node->value.has_value()) {
+        fn(folly::CIDRNetwork{addr.mask(i), static_cast<uint8_t>(i)},
+           node->value.value());
+      }
+      if (i == bitCount) {
+        break;
+      }
+      node = node->children[addr.getNthMSBit(i)].get();
+    }
+  }
+
+  size_t
+  size() const {
+    return size_;
+  }
+
+  bool
+  empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  struct Node {
+    std::optional<ValueType> value{std::nullopt};
+    std::unique_ptr<Node> children[2];
+  };
+
+  Node&
+  root(const folly::IPAddress& addr) {
+    return addr.isV4() ? v4Root_ : v6Root_;
+  }
+
+  const Node&
+  root(const folly::IPAddress& addr) const {
+    return addr.isV4() ? v4Root_ : v6Root_;
+  }
+
+  Node v4Root_;
+  Node v6Root_;
+  size_t size_{0};
+};
+
+} // namespace openr
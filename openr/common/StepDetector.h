@@ -7,11 +7,126 @@
 
 #pragma once
 
-#include <folly/stats/BucketedTimeSeries.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <glog/logging.h>
 #include <openr/if/gen-cpp2/OpenrConfig_types.h>
 
 namespace openr {
 
+/*
+ * Streaming mean estimator used by StepDetector. Every operation is O(1) and
+ * memory is bounded by the window size.
+ *
+ * - SLIDING_WINDOW: ring buffer of the last `windowSize` samples with a
+ *   running sum. Samples older than `windowSize * samplePeriod` are evicted,
+ *   which mimics a time based sliding window.
+ * - EWMA: exponentially weighted moving average with the smoothing factor
+ *   derived from the window size, i.e. alpha = 2 / (windowSize + 1). Only the
+ *   current average is kept.
+ */
+template <typename ValueType, typename TimeType>
+class StreamingMean {
+ public:
+  StreamingMean(
+      thrift::StepDetectorType type, uint64_t windowSize, TimeType samplePeriod)
+      : type_(type),
+        capacity_(std::max<uint64_t>(windowSize, 1)),
+        duration_(samplePeriod * capacity_),
+        alpha_(2.0 / (capacity_ + 1)) {
+    if (type_ == thrift::StepDetectorType::SLIDING_WINDOW) {
+      samples_.resize(capacity_);
+    }
+  }
+
+  // add the value 'val' at time 'now'. Return false if sample is too old.
+  bool
+  addValue(TimeType now, const ValueType& val) {
+    if (count_ and now + duration_ < latest_) {
+      return false;
+    }
+    latest_ = std::max(latest_, now);
+
+    if (type_ == thrift::StepDetectorType::EWMA) {
+      avg_ = count_ ? avg_ + alpha_ * (val - avg_) : static_cast<double>(val);
+      // saturate since it is only used to tell if there are enough samples
+      count_ = std::min(count_ + 1, capacity_);
+      return true;
+    }
+
+    // evict samples out of the time window, as well as the oldest one if full
+    while (count_ and samples_[head_].first + duration_ <= latest_) {
+      evict();
+    }
+    if (count_ == capacity_) {
+      evict();
+    }
+    samples_[(head_ + count_) % capacity_] = std::make_pair(now, val);
+    sum_ += val;
+    ++count_;
+    return true;
+  }
+
+  uint64_t
+  count() const {
+    return count_;
+  }
+
+  double
+  avg() const {
+    if (type_ == thrift::StepDetectorType::EWMA) {
+      return avg_;
+    }
+    return count_ ? static_cast<double>(sum_) / count_ : 0;
+  }
+
+ private:
+  void
+  evict() {
+    sum_ -= samples_[head_].second;
+    head_ = (head_ + 1) % capacity_;
+    --count_;
+
+    // recompute running sum once in a while to avoid accumulating floating
+    // point error. Amortized O(1).
+    if (++numEvicted_ >= capacity_) {
+      numEvicted_ = 0;
+      sum_ = 0;
+      for (uint64_t i = 0; i < count_; ++i) {
+        sum_ += samples_[(head_ + i) % capacity_].second;
+      }
+    }
+  }
+
+  const thrift::StepDetectorType type_;
+
+  // max number of samples in window
+  const uint64_t capacity_{0};
+
+  // time span of the window
+  const TimeType duration_;
+
+  // smoothing factor for EWMA
+  const double alpha_{0};
+
+  // [SLIDING_WINDOW] ring buffer of (time, value), head and running sum
+  std::vector<std::pair<TimeType, ValueType>> samples_;
+  uint64_t head_{0};
+  uint64_t numEvicted_{0};
+  ValueType sum_{0};
+
+  // [EWMA] current average
+  double avg_{0};
+
+  // number of samples in window
+  uint64_t count_{0};
+
+  // time of the latest sample
+  TimeType latest_{0};
+};
+
 /*
  * This class detects abrupt changes, i.e., steps, in the mean level of a time
  * series or signal. Often, the step is small and the time series is corrupted
@@ -29,6 +144,9 @@ namespace openr {
  * to catch this case.
  * Notes: we assume the underlying time series is stable for longer than slow
  * sliding window between steps.
+ * Hysteresis: the difference must stay below lower threshold for half of the
+ * fast window before signaling the falling edge, and a transient spike which
+ * settles back within lower threshold of the last reported mean is ignored.
  */
 template <typename ValueType, typename TimeType>
 class StepDetector {
@@ -45,8 +163,11 @@ class StepDetector {
         loThreshold_(*stepConfig.lower_threshold()),
         hiThreshold_(*stepConfig.upper_threshold()),
         absThreshold_(*stepConfig.ads_threshold()),
-        fastSlideWindow_(fastWndSize_, samplePeriod * fastWndSize_),
-        slowSlideWindow_(slowWndSize_, samplePeriod * slowWndSize_),
+        minStableSamples_(std::max<uint64_t>(fastWndSize_ / 2, 1)),
+        fastSlideWindow_(
+            *stepConfig.detector_type(), fastWndSize_, samplePeriod),
+        slowSlideWindow_(
+            *stepConfig.detector_type(), slowWndSize_, samplePeriod),
         stepCb_(std::move(stepCb)) {
     CHECK_LT(loThreshold_, hiThreshold_);
     CHECK_LT(fastWndSize_, slowWndSize_);
@@ -77,9 +198,26 @@ class StepDetector {
 
     // state machine transition
     if (inTransit_) {
-      if (diff <= loThreshold_) {
+      if (diff > loThreshold_) {
+        numStableSamples_ = 0;
+      } else if (++numStableSamples_ < minStableSamples_) {
+        // hysteresis: fast and slow mean may cross each other while the time
+        // series is still moving, e.g. on a transient spike. Wait for them to
+        // stay close before declaring the falling edge.
+        return fastSuccess && slowSuccess;
+      } else {
         // falling edge
         inTransit_ = false;
+        numStableSamples_ = 0;
+        // hysteresis: skip the transient spike if the mean settles back to
+        // the one reported last time
+        if (lastAvgInit_ and lastAvg_ and
+            std::abs((fastAvg - lastAvg_) / static_cast<double>(lastAvg_)) *
+                    100 <
+                loThreshold_) {
+          VLOG(4) << "Transient spike ignored at time: " << now.count();
+          return fastSuccess && slowSuccess;
+        }
         VLOG(4) << "Step detected at time: " << now.count()
                 << ", new mean: " << fastAvg;
         // report fast average since slow average may not have caught up with
@@ -130,13 +268,14 @@ class StepDetector {
   // absolute step threshold to detect gradual change
   const ValueType absThreshold_{0};
 
+  // number of consecutive samples below lower threshold to end a transition
+  const uint64_t minStableSamples_{1};
+
   // fast sliding window
-  folly::BucketedTimeSeries<ValueType, folly::LegacyStatsClock<TimeType>>
-      fastSlideWindow_;
+  StreamingMean<ValueType, TimeType> fastSlideWindow_;
 
-  // slow sliding window size
-  folly::BucketedTimeSeries<ValueType, folly::LegacyStatsClock<TimeType>>
-      slowSlideWindow_;
+  // slow sliding window
+  StreamingMean<ValueType, TimeType> slowSlideWindow_;
 
   // callback when step is detected
   const std::function<void(const ValueType&)> stepCb_{nullptr};
@@ -150,5 +289,8 @@ class StepDetector {
   // current state of time series, between upper threshold on the rising edge
   // and lower threshold on the falling
   bool inTransit_{false};
+
+  // consecutive samples below lower threshold while in transition
+  uint64_t numStableSamples_{0};
 };
 } // namespace openr
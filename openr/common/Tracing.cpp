@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/Random.h>
+#include <folly/dynamic.h>
+#include <folly/json.h>
+#include <folly/logging/xlog.h>
+#include <folly/system/ThreadId.h>
+
+#include <openr/common/Tracing.h>
+
+namespace openr {
+
+TraceRecorder::TraceRecorder(size_t ringBufferSize)
+    : ringBufferSize_(ringBufferSize) {
+  XCHECK(
+      ringBufferSize_ > 0 and (ringBufferSize_ & (ringBufferSize_ - 1)) == 0)
+      << "Ring buffer size must be power of two";
+}
+
+TraceRecorder&
+TraceRecorder::get() {
+  // ATTN: intentionally leaked to stay valid during static destruction
+  static auto* recorder = new TraceRecorder();
+  return *recorder;
+}
+
+int64_t
+TraceRecorder::generateTraceId() {
+  return static_cast<int64_t>(folly::Random::rand64() >> 1) | 1;
+}
+
+TraceRecorder::Ring&
+TraceRecorder::getThreadRing() {
+  auto& ring = *threadRing_;
+  if (not ring) {
+    ring = std::make_shared<Ring>(ringBufferSize_, folly::getOSThreadID());
+    rings_.wlock()->emplace_back(ring);
+  }
+  return *ring;
+}
+
+void
+TraceRecorder::record(
+    int64_t traceId,
+    const char* name,
+    int64_t startUs,
+    int64_t durationUs) noexcept {
+  auto& ring = getThreadRing();
+  const auto index = ring.head.load(std::memory_order_relaxed);
+  auto& slot = ring.slots[index & ring.mask];
+
+  // seqlock style write, readers discard slot if `seq` changed under them
+  slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.traceId.store(traceId, std::memory_order_relaxed);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.startUs.store(startUs, std::memory_order_relaxed);
+  slot.durationUs.store(durationUs, std::memory_order_relaxed);
+  slot.seq.store(2 * (index + 1), std::memory_order_release);
+  ring.head.store(index + 1, std::memory_order_release);
+}
+
+std::vector<TraceSpan>
+TraceRecorder::collect(int64_t traceId) const {
+  auto rings = rings_.copy();
+
+  std::vector<TraceSpan> spans;
+  for (const auto& ring : rings) {
+    const auto head = ring->head.load(std::memory_order_acquire);
+    const auto size = static_cast<uint64_t>(ring->slots.size());
+    for (auto index = head > size ? head - size : 0; index < head; ++index) {
+      const auto& slot = ring->slots[index & ring->mask];
+      const auto seq = slot.seq.load(std::memory_order_acquire);
+      TraceSpan span;
+      span.traceId = slot.traceId.load(std::memory_order_relaxed);
+      span.name = slot.name.load(std::memory_order_relaxed);
+      span.startUs = slot.startUs.load(std::memory_order_relaxed);
+      span.durationUs = slot.durationUs.load(std::memory_order_relaxed);
+      span.threadId = ring->threadId;
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      // Skip slot overwritten by a newer span while being read
+      if (seq != 2 * (index + 1) or
+          slot.seq.load(std::memory_order_relaxed) != seq) {
+        continue;
+      }
+      if (traceId != 0 and span.traceId != traceId) {
+        continue;
+      }
+      spans.emplace_back(span);
+    }
+  }
+
+  std::sort(spans.begin(), spans.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.startUs < rhs.startUs;
+  });
+  return spans;
+}
+
+std::string
+TraceRecorder::toChromeTrace(const std::vector<TraceSpan>& spans) {
+  auto events = folly::dynamic::array();
+  for (const auto& span : spans) {
+    folly::StringPiece name(span.name);
+    folly::dynamic event = folly::dynamic::object;
+    event["name"] = name;
+    event["cat"] = name.subpiece(0, name.find('.'));
+    event["ph"] = "X"; // complete event, i.e. with duration
+    event["ts"] = span.startUs;
+    event["dur"] = span.durationUs;
+    event["pid"] = 0;
+    event["tid"] = static_cast<int64_t>(span.threadId);
+    event["args"] = folly::dynamic::object;
+    if (span.traceId != 0) {
+      event["args"]["trace_id"] = fmt::format("{:#x}", span.traceId);
+    }
+    events.push_back(std::move(event));
+  }
+
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(events);
+  trace["displayTimeUnit"] = "ms";
+  return folly::toJson(trace);
+}
+
+ScopedTraceSpan::~ScopedTraceSpan() {
+  const auto end = Clock::now();
+  TraceRecorder::get().record(
+      traceId_,
+      name_,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          start_.time_since_epoch())
+          .count(),
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start_)
+          .count());
+}
+
+} // namespace openr
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <folly/Synchronized.h>
+#include <folly/ThreadLocal.h>
+
+#include <openr/common/Constants.h>
+
+namespace openr {
+
+/**
+ * Unit of work done by a module on behalf of one convergence event. Spans
+ * sharing the same non-zero `traceId` belong to the same event, e.g. Spark
+ * neighbor down -> LinkMonitor adj update -> KvStore flood -> Decision
+ * rebuild -> Fib programming. Trace id travels between modules inside the
+ * messaging queue payloads (`NeighborEvent`, `PersistKeyValueRequest` and
+ * `thrift::PerfEvents`).
+ */
+struct TraceSpan {
+  int64_t traceId{0};
+
+  // ATTN: must point to string literal, i.e. static storage duration
+  const char* name{nullptr};
+
+  // unix timestamp and duration in microseconds
+  int64_t startUs{0};
+  int64_t durationUs{0};
+
+  uint64_t threadId{0};
+};
+
+/**
+ * Always-on span recorder. Each thread records into its own fixed size ring
+ * buffer without any locking, oldest spans get overwritten. Readers copy
+ * all rings and drop slots being overwritten concurrently.
+ */
+class TraceRecorder {
+ public:
+  explicit TraceRecorder(
+      size_t ringBufferSize = Constants::kTraceRingBufferSize);
+
+  // process wide recorder used by all modules
+  static TraceRecorder& get();
+
+  // Random positive trace id. Zero stands for untraced work.
+  static int64_t generateTraceId();
+
+  void record(
+      int64_t traceId,
+      const char* name,
+      int64_t startUs,
+      int64_t durationUs) noexcept;
+
+  /**
+   * Copy spans currently held by all rings, ordered by start time. Only
+   * spans of given trace are returned if `traceId` is non-zero.
+   */
+  std::vector<TraceSpan> collect(int64_t traceId = 0) const;
+
+  /**
+   * Render spans in Chrome trace event (JSON) format, which can be loaded
+   * into chrome://tracing or Perfetto UI. Module name is taken from span
+   * name prefix before the first '.', e.g. "fib" for "fib.program_routes".
+   */
+  static std::string toChromeTrace(const std::vector<TraceSpan>& spans);
+
+ private:
+  struct Slot {
+    // even and equal to 2 * (index + 1) once slot holds span at `index`,
+    // odd while being written
+    std::atomic<uint64_t> seq{0};
+    std::atomic<int64_t> traceId{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> startUs{0};
+    std::atomic<int64_t> durationUs{0};
+  };
+
+  struct Ring {
+    Ring(size_t size, uint64_t threadId)
+        : slots(size), mask(size - 1), threadId(threadId) {}
+
+    std::vector<Slot> slots;
+    const size_t mask{0};
+    const uint64_t threadId{0};
+    // number of spans ever written, ONLY modified by owner thread
+    std::atomic<uint64_t> head{0};
+  };
+
+  Ring& getThreadRing();
+
+  const size_t ringBufferSize_{0};
+
+  // ring of calling thread, registered in `rings_` on first use
+  folly::ThreadLocal<std::shared_ptr<Ring>> threadRing_;
+
+  // all rings ever created. Kept after thread exits to preserve its spans.
+  folly::Synchronized<std::vector<std::shared_ptr<Ring>>> rings_;
+};
+
+/**
+ * RAII helper recording a span covering its own lifetime into the process
+ * wide recorder.
+ */
+class ScopedTraceSpan {
+ public:
+  ScopedTraceSpan(int64_t traceId, const char* name)
+      : traceId_(traceId), name_(name), start_(Clock::now()) {}
+
+  ~ScopedTraceSpan();
+
+  ScopedTraceSpan(const ScopedTraceSpan&) = delete;
+  ScopedTraceSpan& operator=(const ScopedTraceSpan&) = delete;
+
+ private:
+  using Clock = std::chrono::system_clock;
+
+  const int64_t traceId_{0};
+  const char* name_{nullptr};
+  const Clock::time_point start_;
+};
+
+} // namespace openr
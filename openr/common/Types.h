@@ -162,6 +162,16 @@ class PersistKeyValueRequest {
     return value;
   }
 
+  inline int64_t
+  getTraceId() const {
+    return traceId;
+  }
+
+  inline void
+  setTraceId(int64_t id) {
+    traceId = id;
+  }
+
  private:
   /**
    * Area identifier. By default key is published to default area kvstore
@@ -176,6 +186,11 @@ class PersistKeyValueRequest {
    * Value to advertise to the consumer.
    */
   std::string value;
+  /**
+   * Trace id of convergence event which triggered this request. Zero if not
+   * traced.
+   */
+  int64_t traceId{0};
 };
 
 /**
@@ -235,8 +250,80 @@ class ClearKeyValueRequest {
   bool setValue{false};
 };
 
-using KeyValueRequest = std::
-    variant<SetKeyValueRequest, PersistKeyValueRequest, ClearKeyValueRequest>;
+/**
+ * Batch of authoritative persist and unset requests for many keys within one
+ * area. Consumer applies the whole batch at once and floods the resulting
+ * key-vals in a single publication, instead of handling one request per key.
+ *
+ * Semantics of each key follow `PersistKeyValueRequest` and
+ * `ClearKeyValueRequest` with `setValue` flag set. If the same key is added
+ * more than once, the last operation wins.
+ */
+class BatchKeyValueRequest {
+ public:
+  explicit BatchKeyValueRequest(const AreaId& area) : area(area) {}
+
+  inline void
+  addPersistKey(const std::string& key, std::string value) {
+    keysToUnset.erase(key);
+    keysToPersist.insert_or_assign(key, std::move(value));
+  }
+
+  inline void
+  addUnsetKey(const std::string& key, std::string value) {
+    CHECK(not value.empty())
+        << "Must specify value to unset key in BatchKeyValueRequest.";
+    keysToPersist.erase(key);
+    keysToUnset.insert_or_assign(key, std::move(value));
+  }
+
+  inline AreaId const&
+  getArea() const {
+    return area;
+  }
+
+  inline std::unordered_map<std::string, std::string> const&
+  getKeysToPersist() const {
+    return keysToPersist;
+  }
+
+  inline std::unordered_map<std::string, std::string> const&
+  getKeysToUnset() const {
+    return keysToUnset;
+  }
+
+  inline size_t
+  size() const {
+    return keysToPersist.size() + keysToUnset.size();
+  }
+
+  inline bool
+  empty() const {
+    return keysToPersist.empty() and keysToUnset.empty();
+  }
+
+ private:
+  /**
+   * Area identifier.
+   */
+  AreaId area;
+  /**
+   * Key-values to advertise authoritatively.
+   */
+  std::unordered_map<std::string /* key */, std::string /* value */>
+      keysToPersist;
+  /**
+   * Key-values to unset, i.e. set new value and stop ttl-refreshing.
+   */
+  std::unordered_map<std::string /* key */, std::string /* value */>
+      keysToUnset;
+};
+
+using KeyValueRequest = std::variant<
+    SetKeyValueRequest,
+    PersistKeyValueRequest,
+    ClearKeyValueRequest,
+    BatchKeyValueRequest>;
 
 /**
  * TODO: remove this once openr_intialization is by default enabled
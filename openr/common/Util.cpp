@@ -14,7 +14,9 @@ namespace fs = std::experimental::filesystem;
 #endif
 
 #include <fb303/ServiceData.h>
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
+#include <folly/memory/Malloc.h>
 #include <openr/common/Constants.h>
 #include <openr/common/Util.h>
 
@@ -192,6 +194,89 @@ getThreadBytesImpl(bool isAllocated) {
   }
   return bytes;
 }
+
+namespace {
+// module name to index of its dedicated arena
+folly::Synchronized<std::map<std::string, unsigned>>&
+moduleArenas() {
+  static folly::Synchronized<std::map<std::string, unsigned>> arenas;
+  return arenas;
+}
+} // namespace
+
+std::optional<unsigned>
+createModuleArena(const std::string& module) {
+  if (not folly::usingJEMalloc()) {
+    return std::nullopt;
+  }
+  unsigned arena{0};
+  try {
+    folly::mallctlRead("arenas.create", &arena);
+    folly::mallctlWrite("thread.arena", arena);
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to create arena for " << module << ": " << ex.what();
+    return std::nullopt;
+  }
+  moduleArenas().wlock()->insert_or_assign(module, arena);
+  XLOG(INFO) << "Bound " << module << " thread to jemalloc arena " << arena;
+  return arena;
+}
+
+void
+bindThreadArena(unsigned arena) {
+  try {
+    folly::mallctlWrite("thread.arena", arena);
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to bind thread to arena " << arena << ": "
+              << ex.what();
+  }
+}
+
+std::map<std::string, int64_t>
+getModuleArenaAllocatedBytes() {
+  std::map<std::string, int64_t> allocatedBytes;
+  const auto arenas = moduleArenas().copy();
+  if (arenas.empty()) {
+    return allocatedBytes;
+  }
+
+  try {
+    // Refresh cached jemalloc stats
+    folly::mallctlWrite<uint64_t>("epoch", 1);
+    for (const auto& [module, arena] : arenas) {
+      size_t small{0}, large{0};
+      folly::mallctlRead(
+          fmt::format("stats.arenas.{}.small.allocated", arena).c_str(),
+          &small);
+      folly::mallctlRead(
+          fmt::format("stats.arenas.{}.large.allocated", arena).c_str(),
+          &large);
+      allocatedBytes.emplace(module, small + large);
+    }
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Failed to read arena stats: " << ex.what();
+  }
+  return allocatedBytes;
+}
+
+folly::Expected<folly::Unit, std::string>
+dumpHeapProfile(const std::string& filePath) {
+  if (not folly::usingJEMalloc()) {
+    return folly::makeUnexpected(std::string("jemalloc is not in use"));
+  }
+  try {
+    bool profActive{false};
+    folly::mallctlRead("prof.active", &profActive);
+    if (not profActive) {
+      return folly::makeUnexpected(
+          std::string("jemalloc heap profiling is not active"));
+    }
+    folly::mallctlWrite("prof.dump", filePath.c_str());
+  } catch (const std::exception& ex) {
+    return folly::makeUnexpected(std::string(ex.what()));
+  }
+  return folly::unit;
+}
 } // namespace memory
 
 std::string
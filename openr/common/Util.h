@@ -8,6 +8,7 @@
 #pragma once
 
 #include <boost/functional/hash.hpp>
+#include <folly/Expected.h>
 #include <folly/memory/MallctlHelper.h>
 #include <openr/common/Constants.h>
 #include <openr/common/Types.h>
@@ -173,8 +174,76 @@ readThriftObjStr(const std::string& buf, Serializer& serializer) {
   return obj;
 }
 
+/**
+ * Visit one page of entries of an unordered map for a paginated dump, see
+ * `thrift::PageParams`. Entries are visited bucket by bucket starting from
+ * `cursor`, until `budget` entries are accepted by `fn(key, value)` (returning
+ * true) or the scan bound is hit. `budget` is decremented accordingly.
+ *
+ * Return the cursor (within the same section) to continue from, or
+ * `std::nullopt` once all entries have been visited. Throws
+ * `std::invalid_argument` if the map has been resized since the cursor was
+ * created.
+ */
+template <typename Map, typename Fn>
+std::optional<thrift::PageCursor>
+visitPage(
+    const Map& map, const thrift::PageCursor& cursor, size_t& budget, Fn&& fn) {
+  size_t bucket{0};
+  if (*cursor.bucketCount() != 0) {
+    if (static_cast<size_t>(*cursor.bucketCount()) != map.bucket_count()) {
+      throw std::invalid_argument(
+          "Table resized since previous page. Restart the dump.");
+    }
+    bucket = static_cast<size_t>(*cursor.bucketIndex());
+  }
+
+  auto scanBudget = budget * Constants::kPageMaxScanBucketsPerEntry;
+  for (; bucket < map.bucket_count(); ++bucket) {
+    if (budget == 0 or scanBudget == 0) {
+      thrift::PageCursor nextCursor;
+      nextCursor.section() = *cursor.section();
+      nextCursor.bucketCount() = map.bucket_count();
+      nextCursor.bucketIndex() = bucket;
+      return nextCursor;
+    }
+    --scanBudget;
+    for (auto it = map.begin(bucket); it != map.end(bucket); ++it) {
+      if (fn(it->first, it->second) and budget > 0) {
+        --budget;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
 namespace memory {
 uint64_t getThreadBytesImpl(bool isAllocated);
+
+/*
+ * [Module Arenas]
+ *
+ * Module threads can be bound to dedicated jemalloc arenas. Memory is
+ * returned to the arena it was allocated from, regardless of the thread
+ * freeing it, so per-arena stats attribute live memory to the allocating
+ * module. Payloads handed over to other modules through queues are
+ * accounted to the producer until they are freed.
+ */
+
+// Create new arena, bind calling thread to it and register it for `module`.
+// Return arena index, or std::nullopt if jemalloc is not in use.
+std::optional<unsigned> createModuleArena(const std::string& module);
+
+// Bind calling thread to existing arena
+void bindThreadArena(unsigned arena);
+
+// Bytes currently allocated from each registered module arena
+std::map<std::string /* module */, int64_t> getModuleArenaAllocatedBytes();
+
+// Dump heap profile of the process into given file. Requires jemalloc heap
+// profiling to be enabled, e.g. MALLOC_CONF=prof:true
+folly::Expected<folly::Unit, std::string> dumpHeapProfile(
+    const std::string& filePath);
 } // namespace memory
 
 std::string toString(const thrift::KeyDumpParams& filter);
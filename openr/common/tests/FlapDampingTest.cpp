@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/FlapDamping.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+openr::thrift::FlapDampingConfig
+getTestConfig() {
+  openr::thrift::FlapDampingConfig config;
+  config.penalty_per_flap() = 1000;
+  config.half_life_ms() = 1000;
+  config.suppress_threshold() = 2000;
+  config.reuse_threshold() = 750;
+  config.max_suppress_ms() = 4000;
+  return config;
+}
+} // namespace
+
+TEST(FlapDampingTest, PenaltyDecay) {
+  openr::FlapDamping damping(getTestConfig());
+  const auto t0 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(damping.getPenalty(t0), 0);
+  EXPECT_FALSE(damping.reportFlap(t0));
+  EXPECT_DOUBLE_EQ(damping.getPenalty(t0), 1000);
+
+  // penalty halves every half-life
+  EXPECT_DOUBLE_EQ(damping.getPenalty(t0 + 1s), 500);
+  EXPECT_DOUBLE_EQ(damping.getPenalty(t0 + 2s), 250);
+  EXPECT_FALSE(damping.isSuppressed(t0 + 2s));
+  EXPECT_FALSE(damping.isDecayed(t0 + 2s));
+  EXPECT_TRUE(damping.isDecayed(t0 + 20s));
+}
+
+TEST(FlapDampingTest, SuppressAndReuse) {
+  openr::FlapDamping damping(getTestConfig());
+  const auto t0 = std::chrono::steady_clock::now();
+
+  // Flaps spaced by half of half-life accumulate penalty:
+  // 1000 -> 1707 -> 2207 (suppressed)
+  EXPECT_FALSE(damping.reportFlap(t0));
+  EXPECT_FALSE(damping.reportFlap(t0 + 500ms));
+  EXPECT_TRUE(damping.reportFlap(t0 + 1000ms));
+  EXPECT_TRUE(damping.isSuppressed(t0 + 1000ms));
+
+  // Further flaps don't re-trigger transition
+  EXPECT_FALSE(damping.reportFlap(t0 + 1100ms));
+
+  // Remains suppressed until penalty decays below reuse threshold
+  const auto reuseIn = damping.getTimeUntilReuse(t0 + 1100ms);
+  EXPECT_GT(reuseIn, 0ms);
+  EXPECT_TRUE(damping.isSuppressed(t0 + 1100ms + reuseIn - 10ms));
+  EXPECT_FALSE(damping.isSuppressed(t0 + 1100ms + reuseIn));
+  EXPECT_EQ(damping.getTimeUntilReuse(t0 + 1100ms + reuseIn), 0ms);
+}
+
+TEST(FlapDampingTest, MaxSuppressTime) {
+  openr::FlapDamping damping(getTestConfig());
+  const auto t0 = std::chrono::steady_clock::now();
+
+  // Flap a lot in short time. Penalty is capped so that reuse happens no
+  // later than max_suppress_ms after last flap.
+  for (int i = 0; i < 100; ++i) {
+    damping.reportFlap(t0);
+  }
+  EXPECT_TRUE(damping.isSuppressed(t0));
+  EXPECT_LE(damping.getTimeUntilReuse(t0), 4001ms);
+  EXPECT_FALSE(damping.isSuppressed(t0 + 4001ms));
+}
+
+int
+main(int argc, char** argv) {
+  // Basic initialization
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
@@ -7,6 +7,7 @@
 
 #include <sys/eventfd.h>
 
+#include <fb303/ServiceData.h>
 #include <folly/futures/Promise.h>
 #include <folly/init/Init.h>
 #include <folly/synchronization/Baton.h>
@@ -14,6 +15,8 @@
 
 #include <openr/common/OpenrEventBase.h>
 
+namespace fb303 = facebook::fb303;
+
 using namespace openr;
 
 class OpenrEventBaseTestFixture : public ::testing::Test {
@@ -176,6 +179,35 @@ TEST_F(OpenrEventBaseTestFixture, SocketFdPollTest) {
   EXPECT_TRUE(true);
 }
 
+TEST(OpenrEventBaseTest, HealthMetrics) {
+  OpenrEventBase evb;
+  evb.setEvbName("health_test");
+
+  std::thread evbThread([&]() { evb.run(); });
+  evb.waitUntilRunning();
+
+  // First callback is always sampled
+  folly::Baton waitBaton;
+  evb.runInEventBaseThread([&]() {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    waitBaton.post();
+  });
+  waitBaton.wait();
+
+  evb.stop();
+  evb.waitUntilStopped();
+  evbThread.join();
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_GE(counters.at("evb.health_test.callback_us.p99"), 4000);
+  EXPECT_EQ(1, counters.count("evb.health_test.queue_delay_us.p99"));
+  EXPECT_EQ(1, counters.count("evb.health_test.loop_busy_us.p99"));
+
+  // Health check timer fires as soon as loop starts and samples fibers
+  EXPECT_EQ(1, counters.count("evb.health_test.fiber_queue_depth.avg"));
+}
+
 int
 main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/PrefixTrie.h>
+
+namespace {
+using Matches = std::vector<std::pair<std::string, int>>;
+
+Matches
+getContaining(const openr::PrefixTrie<int>& trie, const std::string& addr) {
+  Matches result;
+  trie.forEachContaining(
+      folly::IPAddress(addr),
+      [&](const folly::CIDRNetwork& network, const int& value) {
+        result.emplace_back(folly::IPAddress::networkToString(network), value);
+      });
+  return result;
+}
+} // namespace
+
+TEST(PrefixTrieTest, InsertAndFind) {
+  openr::PrefixTrie<int> trie;
+  EXPECT_TRUE(trie.empty());
+
+  EXPECT_TRUE(trie.insert(folly::IPAddress::createNetwork("10.0.0.0/8"), 1));
+  EXPECT_TRUE(trie.insert(folly::IPAddress::createNetwork("10.1.0.0/16"), 2));
+  EXPECT_TRUE(trie.insert(folly::IPAddress::createNetwork("fc00::/7"), 3));
+  // overwrite existing network
+  EXPECT_FALSE(trie.insert(folly::IPAddress::createNetwork("10.0.0.0/8"), 4));
+  EXPECT_EQ(3, trie.size());
+
+  auto* value = trie.find(folly::IPAddress::createNetwork("10.0.0.0/8"));
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(4, *value);
+  value = trie.find(folly::IPAddress::createNetwork("fc00::/7"));
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(3, *value);
+
+  // intermediate nodes and missing networks
+  EXPECT_EQ(nullptr, trie.find(folly::IPAddress::createNetwork("10.0.0.0/9")));
+  EXPECT_EQ(nullptr, trie.find(folly::IPAddress::createNetwork("11.0.0.0/8")));
+  EXPECT_EQ(nullptr, trie.find(folly::IPAddress::createNetwork("fc00::/8")));
+}
+
+TEST(PrefixTrieTest, ForEachContaining) {
+  openr::PrefixTrie<int> trie;
+  trie.insert(folly::IPAddress::createNetwork("0.0.0.0/0"), 0);
+  trie.insert(folly::IPAddress::createNetwork("10.0.0.0/8"), 1);
+  trie.insert(folly::IPAddress::createNetwork("10.1.0.0/16"), 2);
+  trie.insert(folly::IPAddress::createNetwork("10.1.1.1/32"), 3);
+  trie.insert(folly::IPAddress::createNetwork("fc00::/64"), 4);
+
+  // least to most specific
+  EXPECT_EQ(
+      Matches(
+          {{"0.0.0.0/0", 0},
+           {"10.0.0.0/8", 1},
+           {"10.1.0.0/16", 2},
+           {"10.1.1.1/32", 3}}),
+      getContaining(trie, "10.1.1.1"));
+  EXPECT_EQ(
+      Matches({{"0.0.0.0/0", 0}, {"10.0.0.0/8", 1}}),
+      getContaining(trie, "10.2.0.1"));
+  EXPECT_EQ(Matches({{"0.0.0.0/0", 0}}), getContaining(trie, "192.168.0.1"));
+
+  // v4 and v6 networks never match each other
+  EXPECT_EQ(Matches({{"fc00::/64", 4}}), getContaining(trie, "fc00::1"));
+  EXPECT_TRUE(getContaining(trie, "fc00:0:0:1::1").empty());
+}
+
+int
+main(int argc, char** argv) {
+  // Basic initialization
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
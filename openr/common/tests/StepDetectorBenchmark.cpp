@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <random>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <openr/common/StepDetector.h>
+
+#define BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param_name, ...) \
+  BENCHMARK_IMPL_COUNTERS(                                             \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param_name)),             \
+      FOLLY_PP_STRINGIZE(name) "(" FOLLY_PP_STRINGIZE(param_name) ")", \
+      counters,                                                        \
+      iters,                                                           \
+      unsigned,                                                        \
+      iters) {                                                         \
+    name(counters, iters, ##__VA_ARGS__);                              \
+  }
+
+using namespace openr;
+
+namespace {
+// number of samples fed per iteration for noisy time series
+const size_t kNumNoisySamples{10000};
+
+// RTT distribution in microseconds: mean, stddev and spike magnitude
+const double kRttMeanUs{1000};
+const double kRttStddevUs{50};
+const double kRttSpikeUs{1000};
+
+// one sample out of kSpikeInterval is a spike
+const size_t kSpikeInterval{200};
+
+thrift::StepDetectorConfig
+getConfig(thrift::StepDetectorType type, int64_t slowWindowSize) {
+  thrift::StepDetectorConfig config;
+  config.fast_window_size() = std::max<int64_t>(slowWindowSize / 6, 1);
+  config.slow_window_size() = slowWindowSize;
+  config.detector_type() = type;
+  return config;
+}
+} // namespace
+
+/*
+ * Per sample cost of StepDetector::addValue() with given window size. Should
+ * be flat with respect to window size.
+ */
+void
+BM_StepDetectorAddValue(
+    uint32_t iters, thrift::StepDetectorType type, int64_t slowWindowSize) {
+  auto suspender = folly::BenchmarkSuspender();
+  StepDetector<int64_t, std::chrono::milliseconds> stepDetector(
+      getConfig(type, slowWindowSize),
+      std::chrono::milliseconds(1) /* sampling period */,
+      [](const int64_t&) {});
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    stepDetector.addValue(std::chrono::milliseconds(i), 1000 + (i % 7));
+  }
+}
+
+/*
+ * Noisy RTT with occasional spikes and no real step. Report the number of
+ * steps detected which would turn into RTT change re-advertisements.
+ */
+void
+BM_StepDetectorNoisyRtt(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    thrift::StepDetectorType type) {
+  auto suspender = folly::BenchmarkSuspender();
+  std::default_random_engine generator;
+  std::normal_distribution<double> distribution(kRttMeanUs, kRttStddevUs);
+  std::vector<int64_t> samples(kNumNoisySamples);
+  for (size_t i = 0; i < kNumNoisySamples; ++i) {
+    samples[i] = distribution(generator) +
+        ((i % kSpikeInterval) == kSpikeInterval - 1 ? kRttSpikeUs : 0);
+  }
+
+  size_t numSteps{0};
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    StepDetector<int64_t, std::chrono::milliseconds> stepDetector(
+        getConfig(type, 60),
+        std::chrono::milliseconds(1) /* sampling period */,
+        [&numSteps](const int64_t&) { ++numSteps; });
+
+    suspender.dismiss(); // Start measuring benchmark time
+    for (size_t i = 0; i < kNumNoisySamples; ++i) {
+      stepDetector.addValue(std::chrono::milliseconds(i), samples[i]);
+    }
+    suspender.rehire(); // Stop measuring benchmark time
+  }
+  counters["steps_reported_per_10k_samples"] = numSteps / iters;
+}
+
+BENCHMARK_NAMED_PARAM(
+    BM_StepDetectorAddValue,
+    SLIDING_WINDOW_60,
+    thrift::StepDetectorType::SLIDING_WINDOW,
+    60);
+BENCHMARK_NAMED_PARAM(
+    BM_StepDetectorAddValue,
+    SLIDING_WINDOW_600,
+    thrift::StepDetectorType::SLIDING_WINDOW,
+    600);
+BENCHMARK_NAMED_PARAM(
+    BM_StepDetectorAddValue,
+    SLIDING_WINDOW_6000,
+    thrift::StepDetectorType::SLIDING_WINDOW,
+    6000);
+BENCHMARK_NAMED_PARAM(
+    BM_StepDetectorAddValue, EWMA_60, thrift::StepDetectorType::EWMA, 60);
+BENCHMARK_NAMED_PARAM(
+    BM_StepDetectorAddValue, EWMA_6000, thrift::StepDetectorType::EWMA, 6000);
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_StepDetectorNoisyRtt,
+    counters,
+    SLIDING_WINDOW,
+    thrift::StepDetectorType::SLIDING_WINDOW);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_StepDetectorNoisyRtt, counters, EWMA, thrift::StepDetectorType::EWMA);
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
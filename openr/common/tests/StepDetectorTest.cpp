@@ -38,7 +38,9 @@ genGaussianSamples(double mean, double stddev, size_t numOfSamples) {
 }
 
 openr::thrift::StepDetectorConfig
-getTestConfig() {
+getTestConfig(
+    openr::thrift::StepDetectorType type =
+        openr::thrift::StepDetectorType::SLIDING_WINDOW) {
   // generate a config for testing
   openr::thrift::StepDetectorConfig stepDetectorConfig;
 
@@ -47,6 +49,7 @@ getTestConfig() {
   stepDetectorConfig.lower_threshold() = LOWER_THRESHOLD;
   stepDetectorConfig.upper_threshold() = UPPER_THRESHOLD;
   stepDetectorConfig.ads_threshold() = ABS_THRESHOLD;
+  stepDetectorConfig.detector_type() = type;
 
   return stepDetectorConfig;
 }
@@ -178,6 +181,94 @@ TEST(StepDetectorTest, SlowBoiling) {
   }
 }
 
+// transient spike settling back to the same mean is not a step
+TEST(StepDetectorTest, TransientSpike) {
+  uint32_t changeCount = 0;
+  uint32_t timeStamp = 0;
+
+  auto stepCb = [&](const double& avg) {
+    ++changeCount;
+    LOG(INFO) << "Unexpected step reported: " << avg;
+  };
+
+  openr::StepDetector<double, std::chrono::seconds> stepDetector(
+      getTestConfig(),
+      std::chrono::seconds(1) /* sampling period */,
+      stepCb /* callback function */);
+
+  {
+    // stable mean w/o step
+    auto samples = genGaussianSamples(100, 1, 50);
+    for (auto sample : samples) {
+      stepDetector.addValue(std::chrono::seconds(timeStamp++), sample);
+    }
+    EXPECT_EQ(0, changeCount);
+  }
+
+  {
+    // short spike followed by the same mean
+    auto spike = genGaussianSamples(150, 1, 5);
+    auto samples = genGaussianSamples(100, 1, 50);
+    for (auto sample : spike) {
+      stepDetector.addValue(std::chrono::seconds(timeStamp++), sample);
+    }
+    for (auto sample : samples) {
+      stepDetector.addValue(std::chrono::seconds(timeStamp++), sample);
+    }
+    EXPECT_EQ(0, changeCount);
+  }
+}
+
+// time series consists of large jumps, detected with EWMA
+TEST(StepDetectorTest, LargeStepEwma) {
+  uint32_t changeCount = 0;
+  uint32_t timeStamp = 0;
+  double expectedAvg = 0.0;
+  double delta = 1.0;
+
+  auto stepCb = [&](const double& avg) {
+    ++changeCount;
+    LOG(INFO) << expectedAvg << " vs " << avg;
+    EXPECT_GE(avg, expectedAvg - delta);
+    EXPECT_LE(avg, expectedAvg + delta);
+  };
+
+  openr::StepDetector<double, std::chrono::seconds> stepDetector(
+      getTestConfig(openr::thrift::StepDetectorType::EWMA),
+      std::chrono::seconds(1) /* sampling period */,
+      stepCb /* callback function */);
+
+  {
+    // stable mean w/o step
+    expectedAvg = 100;
+    auto samples = genGaussianSamples(expectedAvg, 1, 100);
+    for (auto sample : samples) {
+      stepDetector.addValue(std::chrono::seconds(timeStamp++), sample);
+    }
+    EXPECT_EQ(0, changeCount);
+  }
+
+  {
+    // mean increase
+    expectedAvg += 50;
+    auto samples = genGaussianSamples(expectedAvg, 1, 100);
+    for (auto sample : samples) {
+      stepDetector.addValue(std::chrono::seconds(timeStamp++), sample);
+    }
+    EXPECT_EQ(1, changeCount);
+  }
+
+  {
+    // mean decrease
+    expectedAvg -= 50;
+    auto samples = genGaussianSamples(expectedAvg, 1, 100);
+    for (auto sample : samples) {
+      stepDetector.addValue(std::chrono::seconds(timeStamp++), sample);
+    }
+    EXPECT_EQ(2, changeCount);
+  }
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
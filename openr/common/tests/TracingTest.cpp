@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <thread>
+
+#include <folly/json.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/Tracing.h>
+
+using namespace openr;
+
+TEST(TracingTest, RecordAndCollect) {
+  TraceRecorder recorder(8);
+  EXPECT_TRUE(recorder.collect().empty());
+
+  recorder.record(1, "spark.neighbor_event", 200, 5);
+  recorder.record(2, "decision.rebuild_routes", 100, 10);
+  recorder.record(1, "fib.program_routes", 300, 20);
+
+  // spans are ordered by start time
+  auto spans = recorder.collect();
+  ASSERT_EQ(3, spans.size());
+  EXPECT_STREQ("decision.rebuild_routes", spans.at(0).name);
+  EXPECT_EQ(2, spans.at(0).traceId);
+  EXPECT_EQ(100, spans.at(0).startUs);
+  EXPECT_EQ(10, spans.at(0).durationUs);
+  EXPECT_STREQ("spark.neighbor_event", spans.at(1).name);
+  EXPECT_STREQ("fib.program_routes", spans.at(2).name);
+
+  // filter by trace id
+  spans = recorder.collect(1);
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ(1, spans.at(0).traceId);
+  EXPECT_EQ(1, spans.at(1).traceId);
+}
+
+TEST(TracingTest, RingWrapAround) {
+  TraceRecorder recorder(4);
+  for (int64_t i = 0; i < 10; ++i) {
+    recorder.record(i + 1, "kvstore.persist_key", i, 1);
+  }
+
+  // ONLY the most recent spans are kept
+  auto spans = recorder.collect();
+  ASSERT_EQ(4, spans.size());
+  for (int64_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(6 + i, spans.at(i).startUs);
+    EXPECT_EQ(7 + i, spans.at(i).traceId);
+  }
+}
+
+TEST(TracingTest, PerThreadRings) {
+  const int64_t kNumThreads{4};
+  const size_t kNumSpans{16};
+  TraceRecorder recorder(64);
+
+  std::vector<std::thread> threads;
+  for (int64_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&recorder, t]() {
+      for (int64_t i = 0; i < static_cast<int64_t>(kNumSpans); ++i) {
+        recorder.record(t + 1, "link_monitor.neighbor_event", i, 1);
+      }
+    });
+  }
+  // read concurrently with writers, spans MUST never be torn
+  for (int i = 0; i < 100; ++i) {
+    for (const auto& span : recorder.collect()) {
+      EXPECT_STREQ("link_monitor.neighbor_event", span.name);
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // spans of exited threads are preserved
+  EXPECT_EQ(kNumThreads * kNumSpans, recorder.collect().size());
+  for (int64_t t = 0; t < kNumThreads; ++t) {
+    auto spans = recorder.collect(t + 1);
+    ASSERT_EQ(kNumSpans, spans.size());
+    for (const auto& span : spans) {
+      EXPECT_EQ(spans.front().threadId, span.threadId);
+    }
+  }
+}
+
+TEST(TracingTest, ScopedTraceSpan) {
+  const auto traceId = TraceRecorder::generateTraceId();
+  EXPECT_GT(traceId, 0);
+  {
+    ScopedTraceSpan span(traceId, "fib.program_routes");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+
+  auto spans = TraceRecorder::get().collect(traceId);
+  ASSERT_EQ(1, spans.size());
+  EXPECT_STREQ("fib.program_routes", spans.at(0).name);
+  EXPECT_GE(spans.at(0).durationUs, 2000);
+}
+
+TEST(TracingTest, ChromeTraceFormat) {
+  TraceRecorder recorder(8);
+  recorder.record(0x1234, "kvstore.persist_key", 100, 7);
+  recorder.record(0, "untraced", 200, 3);
+
+  auto trace =
+      folly::parseJson(TraceRecorder::toChromeTrace(recorder.collect()));
+  const auto& events = trace.at("traceEvents");
+  ASSERT_EQ(2, events.size());
+
+  const auto& traced = events.at(0);
+  EXPECT_EQ("kvstore.persist_key", traced.at("name").asString());
+  EXPECT_EQ("kvstore", traced.at("cat").asString());
+  EXPECT_EQ("X", traced.at("ph").asString());
+  EXPECT_EQ(100, traced.at("ts").asInt());
+  EXPECT_EQ(7, traced.at("dur").asInt());
+  EXPECT_EQ("0x1234", traced.at("args").at("trace_id").asString());
+
+  // module defaults to full name, no trace id for untraced span
+  const auto& untraced = events.at(1);
+  EXPECT_EQ("untraced", untraced.at("cat").asString());
+  EXPECT_EQ(0, untraced.at("args").count("trace_id"));
+}
+
+int
+main(int argc, char** argv) {
+  // Basic initialization
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
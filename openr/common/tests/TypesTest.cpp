@@ -54,6 +54,48 @@ TEST(TypesTest, fromStrTest) {
   EXPECT_TRUE(PrefixKey::fromStr(invalidStrWithBadPrefixV2, areaId).hasError());
 }
 
+TEST(TypesTest, PrefixShardKeyTest) {
+  const std::string nodeName{"node-1"};
+  const auto prefixKeyStr =
+      PrefixKey(nodeName, folly::IPAddress::createNetwork("1.1.1.1/32"), "0")
+          .getPrefixKeyV2();
+
+  // form and parse shard key
+  const PrefixShardKey shardKey(nodeName, 17);
+  EXPECT_EQ(
+      fmt::format("{}{}:17", Constants::kPrefixDbMarker.toString(), nodeName),
+      shardKey.getPrefixShardKey());
+  auto maybeShardKey = PrefixShardKey::fromStr(shardKey.getPrefixShardKey());
+  ASSERT_FALSE(maybeShardKey.hasError());
+  EXPECT_EQ(nodeName, maybeShardKey->getNodeName());
+  EXPECT_EQ(17, maybeShardKey->getShardId());
+
+  // per-prefix key and shard key can not be mistaken for each other
+  EXPECT_TRUE(PrefixShardKey::fromStr(prefixKeyStr).hasError());
+  EXPECT_TRUE(PrefixKey::fromStr(shardKey.getPrefixShardKey()).hasError());
+  EXPECT_TRUE(PrefixShardKey::fromStr("adj:node-1:17").hasError());
+  EXPECT_TRUE(PrefixShardKey::fromStr("prefix:node-1:99999999999").hasError());
+
+  // shard assignment is stable and within range. Growing number of shards
+  // only moves a fraction of prefixes.
+  const uint32_t numShards{16};
+  const uint32_t numPrefixes{4096};
+  uint32_t numMoved{0};
+  for (uint32_t i = 0; i < numPrefixes; ++i) {
+    const auto prefix = folly::IPAddress::createNetwork(
+        fmt::format("10.{}.{}.0/24", i / 256, i % 256));
+    const auto shardId = PrefixShardKey::getShardId(prefix, numShards);
+    EXPECT_LT(shardId, numShards);
+    EXPECT_EQ(shardId, PrefixShardKey::getShardId(prefix, numShards));
+    if (shardId != PrefixShardKey::getShardId(prefix, numShards + 1)) {
+      ++numMoved;
+    }
+  }
+  // expect ~1/17 of the prefixes to move
+  EXPECT_LT(numMoved, numPrefixes / 8);
+  EXPECT_GT(numMoved, 0);
+}
+
 TEST(TypesTest, RegexSetTest) {
   EXPECT_NO_THROW(RegexSet{{"prefix:good"}});
 
@@ -5,19 +5,28 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
+#include <folly/Conv.h>
 #include <folly/FileUtil.h>
+#include <folly/String.h>
 #include <folly/io/IOBuf.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/MemoryMapping.h>
 
 #include <openr/common/Util.h>
 #include <openr/config-store/PersistentStore.h>
 #include <openr/config/Config.h>
 
+namespace fb303 = facebook::fb303;
+
 using std::exception;
 
 namespace {
 
-static const long kDbFlushRatio = 10000;
+constexpr folly::StringPiece kSegmentSuffix{".log"};
+
+constexpr folly::StringPiece kEnqueueToDurableHistogram{
+    "persistent_store.enqueue_to_durable_ms"};
 
 } // anonymous namespace
 
@@ -28,7 +37,19 @@ PersistentStore::PersistentStore(
     bool dryrun,
     bool periodicallySaveToDisk)
     : storageFilePath_(*config->getConfig().persistent_config_store_path()),
+      segmentSizeBytes_(
+          *config->getPersistentStoreConfig().segment_size_bytes()),
+      enableFdatasync_(*config->getPersistentStoreConfig().enable_fdatasync()),
       dryrun_(dryrun) {
+  ioEvbThread_ =
+      std::make_unique<folly::ScopedEventBaseThread>("PersistentStoreIo");
+
+  // Latency from enqueueing an update till it is written (and synced) to disk
+  fb303::fbData->addHistogram(
+      kEnqueueToDurableHistogram, 10 /* bucket width */, 0, 1000);
+  fb303::fbData->exportHistogramPercentile(
+      kEnqueueToDurableHistogram, 50, 95, 99);
+
   if (periodicallySaveToDisk) {
     // Create timer and backoff mechanism only if backoff is requested
     saveDbTimerBackoff_ =
@@ -36,16 +57,17 @@ PersistentStore::PersistentStore(
             Constants::kPersistentStoreInitialBackoff,
             Constants::kPersistentStoreMaxBackoff);
 
-    saveDbTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
-      if (savePersistentObjectToDisk()) {
-        saveDbTimerBackoff_->reportSuccess();
-      } else {
-        // Report error and schedule next-try
-        saveDbTimerBackoff_->reportError();
-        saveDbTimer_->scheduleTimeout(
-            saveDbTimerBackoff_->getTimeRemainingUntilRetry());
-      }
-    });
+    saveDbTimer_ = folly::AsyncTimeout::make(
+        *ioEvbThread_->getEventBase(), [this]() noexcept {
+          if (savePersistentObjectToDisk()) {
+            saveDbTimerBackoff_->reportSuccess();
+          } else {
+            // Report error and schedule next-try
+            saveDbTimerBackoff_->reportError();
+            saveDbTimer_->scheduleTimeout(
+                saveDbTimerBackoff_->getTimeRemainingUntilRetry());
+          }
+        });
   }
 
   // Load initial database. On failure we will just report error and continue
@@ -54,10 +76,44 @@ PersistentStore::PersistentStore(
     XLOG(ERR) << "Failed to load config-database from file: "
               << storageFilePath_;
   }
+
+  // Append to a fresh segment and fold segments left over from previous run
+  // into the snapshot in background
+  auto segmentIds = listSegmentIds();
+  if (not segmentIds.empty()) {
+    activeSegmentId_ = segmentIds.back() + 1;
+  }
+  if (not dryrun_) {
+    sealedSegmentIds_ = std::move(segmentIds);
+    maybeStartCompaction();
+  }
 }
 
 PersistentStore::~PersistentStore() {
-  saveDatabaseToDisk();
+  // Stop I/O thread. Pending objects are covered by the snapshot below.
+  ioEvbThread_->getEventBase()->runInEventBaseThreadAndWait(
+      [this]() noexcept { saveDbTimer_.reset(); });
+  ioEvbThread_.reset();
+
+  if (compactionThread_.joinable()) {
+    compactionThread_.join();
+  }
+  activeSegment_.closeNoThrow();
+
+  // Snapshot covers the whole database, log segments are no longer needed
+  if (saveDatabaseToDisk()) {
+    for (auto segmentId : listSegmentIds()) {
+      std::error_code ec;
+      fs::remove(getSegmentFilePath(storageFilePath_, segmentId), ec);
+    }
+  }
+}
+
+fs::path
+PersistentStore::getSegmentFilePath(
+    const fs::path& storageFilePath, uint64_t segmentId) {
+  return fs::path(fmt::format(
+      "{}.{}{}", storageFilePath.string(), segmentId, kSegmentSuffix.str()));
 }
 
 folly::SemiFuture<folly::Unit>
@@ -72,9 +128,7 @@ PersistentStore::store(std::string key, std::string value) {
                  << " to config-store";
     // Override previous value if any
     database_.insert_or_assign(key, value);
-    auto pObject = toPersistentObject(ActionType::ADD, key, value);
-    pObjects_.emplace_back(std::move(pObject));
-    maybeSaveObjectToDisk();
+    enqueueObject(toPersistentObject(ActionType::ADD, key, value));
     p.setValue();
   });
   return sf;
@@ -88,9 +142,7 @@ PersistentStore::erase(std::string key) {
       [this, p = std::move(p), key = std::move(key)]() mutable noexcept {
         SYSLOG(INFO) << "Erase key: " << key << " from config-store";
         if (database_.erase(key) > 0) {
-          auto pObject = toPersistentObject(ActionType::DEL, key, "");
-          pObjects_.emplace_back(std::move(pObject));
-          maybeSaveObjectToDisk();
+          enqueueObject(toPersistentObject(ActionType::DEL, key, ""));
           p.setValue(true);
         } else {
           XLOG(WARNING) << "Key: " << key << " doesn't exist";
@@ -117,10 +169,27 @@ PersistentStore::load(std::string key) {
 }
 
 void
-PersistentStore::maybeSaveObjectToDisk() noexcept {
+PersistentStore::enqueueObject(PersistentObject pObject) noexcept {
+  auto enqueue = [this,
+                  pObject = std::move(pObject),
+                  enqueueTs = std::chrono::steady_clock::now()]() mutable {
+    pObjects_.emplace_back(PendingObject{std::move(pObject), enqueueTs});
+    maybeSaveObjectToDisk();
+  };
+
   if (not saveDbTimerBackoff_) {
     // This is primarily used for unit testing to save DB immediately
     // Block the response till file is saved
+    ioEvbThread_->getEventBase()->runInEventBaseThreadAndWait(
+        std::move(enqueue));
+  } else {
+    ioEvbThread_->getEventBase()->runInEventBaseThread(std::move(enqueue));
+  }
+}
+
+void
+PersistentStore::maybeSaveObjectToDisk() noexcept {
+  if (not saveDbTimerBackoff_) {
     savePersistentObjectToDisk();
   } else if (not saveDbTimer_->isScheduled()) {
     saveDbTimer_->scheduleTimeout(
@@ -130,181 +199,360 @@ PersistentStore::maybeSaveObjectToDisk() noexcept {
 
 bool
 PersistentStore::savePersistentObjectToDisk() noexcept {
-  if (not dryrun_) {
-    // Write PersistentObject to ioBuf
-    std::vector<PersistentObject> newObjects;
-    newObjects = std::move(pObjects_);
-
+  if (not dryrun_ and not pObjects_.empty()) {
+    // Group commit: encode all pending PersistentObjects and append them to
+    // the log with a single write
     auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
-
-    for (auto& pObject : newObjects) {
+    size_t payloadBytes{0};
+    for (auto& [pObject, enqueueTs] : pObjects_) {
       auto buf = encodePersistentObject(pObject);
       if (buf.hasError()) {
         XLOG(ERR) << "Failed to encode PersistentObject to ioBuf. Error: "
                   << buf.error();
         return false;
       }
+      payloadBytes += pObject.key.size() +
+          (pObject.data.has_value() ? pObject.data->size() : 0);
       queue.append(std::move(**buf));
     }
 
-    // Append IoBuf to disk
-    auto ioBuf = queue.move();
-    auto success = writeIoBufToDisk(ioBuf, WriteType::APPEND);
+    // Append IoBuf to disk. Pending objects are kept for retry on failure.
+    auto success = appendIoBufToSegment(queue.move());
     if (success.hasError()) {
-      XLOG(ERR) << "Failed to write PersistentObject to file '"
+      XLOG(ERR) << "Failed to write PersistentObject to log segment of '"
                 << storageFilePath_ << "'. Error: " << success.error();
       return false;
     }
-
-    numOfNewWritesToDisk_++;
-
-    // Write the whole database to disk periodically
-    if (numOfNewWritesToDisk_ >= kDbFlushRatio) {
-      numOfNewWritesToDisk_ = 0;
-      const auto startTs = std::chrono::steady_clock::now();
-      if (not saveDatabaseToDisk()) {
-        return false;
-      }
-      XLOG(INFO) << "Updated database on disk. Took "
-                 << std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::steady_clock::now() - startTs)
-                        .count()
-                 << "ms";
+    const auto durableTs = std::chrono::steady_clock::now();
+    for (auto& [pObject, enqueueTs] : pObjects_) {
+      fb303::fbData->addHistogramValue(
+          kEnqueueToDurableHistogram,
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              durableTs - enqueueTs)
+              .count());
     }
-  } else {
+    pObjects_.clear();
+    fb303::fbData->addStatValue(
+        "persistent_store.payload_bytes", payloadBytes, fb303::SUM);
+
+    // Pick up segments sealed while previous compaction was running
+    maybeStartCompaction();
+  } else if (dryrun_) {
     XLOG(DBG1) << "Skipping writing to disk in dryrun mode";
+    pObjects_.clear();
   }
   numOfWritesToDisk_++;
 
   return true;
 }
 
-bool
-PersistentStore::saveDatabaseToDisk() noexcept {
-  std::unique_ptr<folly::IOBuf> ioBuf;
-  // If database is empty, write 'kTlvFormatMarker' to disk and return
-  if (database_.empty()) {
-    ioBuf = folly::IOBuf::copyBuffer(
-        kTlvFormatMarker.data(), kTlvFormatMarker.size());
-  } else {
-    // Append kTlvFormatMarker to queue
-    auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+folly::Expected<folly::Unit, std::string>
+PersistentStore::appendIoBufToSegment(
+    std::unique_ptr<folly::IOBuf> ioBuf) noexcept {
+  try {
+    if (not activeSegment_) {
+      activeSegment_ = folly::File(
+          getSegmentFilePath(storageFilePath_, activeSegmentId_).string(),
+          O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC,
+          0666);
+    }
+  } catch (std::exception const& e) {
+    return folly::makeUnexpected<std::string>(
+        folly::exceptionStr(e).toStdString());
+  }
+
+  // Every log segment starts with the format marker
+  auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+  if (activeSegmentBytes_ == 0) {
     queue.append(kTlvFormatMarker.data(), kTlvFormatMarker.size());
+  }
+  queue.append(std::move(ioBuf));
+  auto buf = queue.move();
+  buf->coalesce();
+
+  const auto written =
+      folly::writeFull(activeSegment_.fd(), buf->data(), buf->length());
+  if (written < 0 or static_cast<size_t>(written) != buf->length()) {
+    const auto error = folly::errnoStr(errno);
+    // Segment may end with a partial object now. Leave it behind for
+    // compaction, which tolerates a torn tail, and retry on a fresh one.
+    sealActiveSegment();
+    return folly::makeUnexpected<std::string>(error);
+  }
+  if (enableFdatasync_ and folly::fdatasyncNoInt(activeSegment_.fd()) != 0) {
+    const auto error = folly::errnoStr(errno);
+    sealActiveSegment();
+    return folly::makeUnexpected<std::string>(error);
+  }
+  fb303::fbData->addStatValue(
+      "persistent_store.bytes_written", buf->length(), fb303::SUM);
 
-    // Encode database_ and append to queue
-    for (auto& keyPair : database_) {
-      PersistentObject pObject;
-      pObject =
-          toPersistentObject(ActionType::ADD, keyPair.first, keyPair.second);
+  activeSegmentBytes_ += buf->length();
+  if (activeSegmentBytes_ >= segmentSizeBytes_) {
+    sealActiveSegment();
+  }
+  return folly::Unit();
+}
 
-      auto buf = encodePersistentObject(pObject);
-      if (buf.hasError()) {
-        XLOG(ERR) << "Failed to encode PersistentObject to ioBuf. Error:  "
-                  << buf.error();
-        return false;
-      }
-      queue.append(std::move(*buf));
+void
+PersistentStore::sealActiveSegment() noexcept {
+  activeSegment_.closeNoThrow();
+  sealedSegmentIds_.emplace_back(activeSegmentId_++);
+  activeSegmentBytes_ = 0;
+}
+
+void
+PersistentStore::maybeStartCompaction() noexcept {
+  if (sealedSegmentIds_.empty() or compactionInProgress_) {
+    return;
+  }
+
+  // Previous compaction is done. Reap its thread before starting next one.
+  if (compactionThread_.joinable()) {
+    compactionThread_.join();
+  }
+  compactionInProgress_ = true;
+  compactionThread_ = std::thread(
+      [this, segmentIds = std::move(sealedSegmentIds_)]() mutable noexcept {
+        compactSegments(std::move(segmentIds));
+        compactionInProgress_ = false;
+      });
+  sealedSegmentIds_.clear();
+}
+
+void
+PersistentStore::compactSegments(std::vector<uint64_t> segmentIds) noexcept {
+  const auto startTs = std::chrono::steady_clock::now();
+
+  // Rebuild database from snapshot and sealed segments on disk
+  std::unordered_map<std::string, std::string> database;
+  if (fs::exists(storageFilePath_)) {
+    auto success = loadDatabaseTlvFormat(storageFilePath_, database, false);
+    if (success.hasError()) {
+      XLOG(ERR) << "Failed to read snapshot '" << storageFilePath_
+                << "' for compaction. Error: " << success.error();
+      return;
+    }
+  }
+  for (auto segmentId : segmentIds) {
+    const auto segmentPath = getSegmentFilePath(storageFilePath_, segmentId);
+    if (not fs::exists(segmentPath)) {
+      continue;
+    }
+    auto success = loadDatabaseTlvFormat(segmentPath, database, true);
+    if (success.hasError()) {
+      XLOG(ERR) << "Failed to read log segment '" << segmentPath
+                << "' for compaction. Error: " << success.error();
+      return;
+    }
+  }
+
+  // Replace snapshot atomically. Segments are removed only afterwards, so a
+  // crash in between just replays them once more on top of new snapshot.
+  auto ioBuf = encodeDatabase(database);
+  if (ioBuf.hasError()) {
+    XLOG(ERR) << "Failed to encode database for compaction. Error: "
+              << ioBuf.error();
+    return;
+  }
+  const auto snapshotBytes = (*ioBuf)->computeChainDataLength();
+  auto success = writeIoBufToDisk(storageFilePath_, *ioBuf, enableFdatasync_);
+  if (success.hasError()) {
+    XLOG(ERR) << "Failed to write snapshot '" << storageFilePath_
+              << "' for compaction. Error: " << success.error();
+    return;
+  }
+  fb303::fbData->addStatValue(
+      "persistent_store.bytes_written", snapshotBytes, fb303::SUM);
+
+  for (auto segmentId : segmentIds) {
+    std::error_code ec;
+    fs::remove(getSegmentFilePath(storageFilePath_, segmentId), ec);
+  }
+  numOfCompactions_++;
+  XLOG(INFO) << "Compacted " << segmentIds.size()
+             << " log segment(s) into snapshot. Took "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - startTs)
+                    .count()
+             << "ms";
+}
+
+std::vector<uint64_t>
+PersistentStore::listSegmentIds() const noexcept {
+  std::vector<uint64_t> segmentIds;
+  const auto prefix = storageFilePath_.filename().string() + ".";
+  auto dirPath = storageFilePath_.parent_path();
+  if (dirPath.empty()) {
+    dirPath = ".";
+  }
+
+  std::error_code ec;
+  for (auto it = fs::directory_iterator(dirPath, ec);
+       not ec and it != fs::directory_iterator();
+       it.increment(ec)) {
+    const auto fileName = it->path().filename().string();
+    folly::StringPiece name(fileName);
+    if (not name.removePrefix(prefix) or
+        not name.removeSuffix(kSegmentSuffix)) {
+      continue;
+    }
+    auto segmentId = folly::tryTo<uint64_t>(name);
+    if (segmentId.hasValue()) {
+      segmentIds.emplace_back(*segmentId);
     }
-    // Write queue to disk
-    ioBuf = queue.move();
   }
+  std::sort(segmentIds.begin(), segmentIds.end());
+  return segmentIds;
+}
 
-  auto success = writeIoBufToDisk(ioBuf, WriteType::WRITE);
+bool
+PersistentStore::saveDatabaseToDisk() noexcept {
+  auto ioBuf = encodeDatabase(database_);
+  if (ioBuf.hasError()) {
+    XLOG(ERR) << "Failed to encode PersistentObject to ioBuf. Error:  "
+              << ioBuf.error();
+    return false;
+  }
+
+  const auto snapshotBytes = (*ioBuf)->computeChainDataLength();
+  auto success = writeIoBufToDisk(storageFilePath_, *ioBuf, enableFdatasync_);
   if (success.hasError()) {
     XLOG(ERR) << "Failed to write database to file '" << storageFilePath_
               << "'. Error: " << success.error();
     return false;
   }
+  fb303::fbData->addStatValue(
+      "persistent_store.bytes_written", snapshotBytes, fb303::SUM);
   return true;
 }
 
+folly::Expected<std::unique_ptr<folly::IOBuf>, std::string>
+PersistentStore::encodeDatabase(
+    const std::unordered_map<std::string, std::string>& database) noexcept {
+  // Append kTlvFormatMarker to queue
+  auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+  queue.append(kTlvFormatMarker.data(), kTlvFormatMarker.size());
+
+  // Encode database and append to queue
+  for (auto& [key, value] : database) {
+    PersistentObject pObject;
+    pObject.type = ActionType::ADD;
+    pObject.key = key;
+    pObject.data = value;
+
+    auto buf = encodePersistentObject(pObject);
+    if (buf.hasError()) {
+      return folly::makeUnexpected(buf.error());
+    }
+    queue.append(std::move(*buf));
+  }
+  return queue.move();
+}
+
 bool
 PersistentStore::loadDatabaseFromDisk() noexcept {
-  // Check if file exists
-  if (not fs::exists(storageFilePath_)) {
-    XLOG(INFO) << "Storage file " << storageFilePath_ << " doesn't exists. "
-               << "Starting with empty database";
-    return true;
-  }
+  std::unordered_map<std::string, std::string> newDatabase;
 
-  // Read data from file
-  std::string fileData{""};
-  if (not folly::readFile(storageFilePath_.c_str(), fileData)) {
-    XLOG(ERR) << "Failed to read file contents from '" << storageFilePath_
-              << "'. Error (" << errno << "): " << folly::errnoStr(errno);
-    return false;
+  // Load snapshot
+  if (fs::exists(storageFilePath_)) {
+    auto tlvSuccess =
+        loadDatabaseTlvFormat(storageFilePath_, newDatabase, false);
+    if (tlvSuccess.hasError()) {
+      XLOG(ERR) << "Failed to read Tlv-format file contents from '"
+                << storageFilePath_ << "'. Error: " << tlvSuccess.error();
+      return false;
+    }
+  } else {
+    XLOG(INFO) << "Storage file " << storageFilePath_ << " doesn't exists. "
+               << "Starting with empty snapshot";
   }
 
-  // Create IoBuf and cursor for loading data from disk (TlvFormat)
-  auto ioBuf = folly::IOBuf::wrapBuffer(fileData.c_str(), fileData.size());
-  auto tlvSuccess = loadDatabaseTlvFormat(ioBuf);
-  if (tlvSuccess.hasError()) {
-    XLOG(ERR) << "Failed to read Tlv-format file contents from '"
-              << storageFilePath_ << "'. Error: " << tlvSuccess.error();
-    return false;
+  // Replay log segments written after the snapshot
+  for (auto segmentId : listSegmentIds()) {
+    const auto segmentPath = getSegmentFilePath(storageFilePath_, segmentId);
+    auto tlvSuccess = loadDatabaseTlvFormat(segmentPath, newDatabase, true);
+    if (tlvSuccess.hasError()) {
+      XLOG(ERR) << "Failed to read Tlv-format file contents from '"
+                << segmentPath << "'. Error: " << tlvSuccess.error();
+      return false;
+    }
   }
+  database_ = std::move(newDatabase);
   return true;
 }
 
 folly::Expected<folly::Unit, std::string>
 PersistentStore::loadDatabaseTlvFormat(
-    const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept {
-  // Parse ioBuf to persistentObject and then to `database_`
-  folly::io::Cursor cursor(ioBuf.get());
-  std::unordered_map<std::string, std::string> newDatabase;
-  // Read 'kTlvFormatMarker'
+    const fs::path& filePath,
+    std::unordered_map<std::string, std::string>& database,
+    bool allowTornTail) noexcept {
   try {
-    cursor.readFixedString(kTlvFormatMarker.size());
-  } catch (std::out_of_range& e) {
-    return folly::makeUnexpected<std::string>(
-        folly::exceptionStr(e).toStdString());
-  }
-  // Iteratively read persistentObject from disk
-  while (true) {
-    // Read and decode into persistentObject
-    auto optionalObject = decodePersistentObject(cursor);
-    if (optionalObject.hasError()) {
-      return folly::makeUnexpected(optionalObject.error());
+    // Crash before the marker got written leaves an empty segment behind
+    if (allowTornTail and fs::file_size(filePath) < kTlvFormatMarker.size()) {
+      return folly::Unit();
     }
 
-    // Read finish
-    if (not optionalObject->has_value()) {
-      break;
-    }
-    auto pObject = std::move(optionalObject->value());
-
-    // Add/Delete persistentObject to/from 'newDatabase'
-    if (pObject.type == ActionType::ADD) {
-      newDatabase.insert_or_assign(
-          pObject.key, pObject.data.has_value() ? pObject.data.value() : "");
-    } else if (pObject.type == ActionType::DEL) {
-      newDatabase.erase(pObject.key);
+    // Map file into memory and decode objects in place instead of reading
+    // it into an intermediate buffer first
+    folly::MemoryMapping mapping(filePath.c_str());
+    auto ioBuf = folly::IOBuf::wrapBuffer(mapping.range());
+    folly::io::Cursor cursor(ioBuf.get());
+
+    // Read 'kTlvFormatMarker'
+    cursor.readFixedString(kTlvFormatMarker.size());
+
+    // Iteratively read persistentObject from disk
+    while (true) {
+      // Read and decode into persistentObject
+      auto optionalObject = decodePersistentObject(cursor);
+      if (optionalObject.hasError()) {
+        if (allowTornTail) {
+          XLOG(WARNING) << "Ignoring truncated object at the end of '"
+                        << filePath << "'";
+          break;
+        }
+        return folly::makeUnexpected(optionalObject.error());
+      }
+
+      // Read finish
+      if (not optionalObject->has_value()) {
+        break;
+      }
+      auto pObject = std::move(optionalObject->value());
+
+      // Add/Delete persistentObject to/from 'database'
+      if (pObject.type == ActionType::ADD) {
+        database.insert_or_assign(
+            pObject.key,
+            pObject.data.has_value() ? std::move(pObject.data.value()) : "");
+      } else if (pObject.type == ActionType::DEL) {
+        database.erase(pObject.key);
+      }
     }
+  } catch (std::exception const& e) {
+    return folly::makeUnexpected<std::string>(
+        folly::exceptionStr(e).toStdString());
   }
-  database_ = std::move(newDatabase);
   return folly::Unit();
 }
 
-// Write over or append IoBuf to disk atomically
+// Write over IoBuf to disk atomically
 folly::Expected<folly::Unit, std::string>
 PersistentStore::writeIoBufToDisk(
-    const std::unique_ptr<folly::IOBuf>& ioBuf, WriteType writeType) noexcept {
+    const fs::path& filePath,
+    const std::unique_ptr<folly::IOBuf>& ioBuf,
+    bool enableFdatasync) noexcept {
   std::string fileData("");
   try {
     ioBuf->coalesce();
     fileData = ioBuf->moveToFbString().toStdString();
-
-    if (writeType == WriteType::WRITE) {
-      // Write over
-      folly::writeFileAtomic(storageFilePath_.c_str(), fileData, 0666);
-    } else {
-      // Append to file
-      folly::writeFile(
-          fileData,
-          storageFilePath_.c_str(),
-          O_WRONLY | O_APPEND | O_CREAT,
-          0666);
-    }
+    folly::writeFileAtomic(
+        filePath.c_str(),
+        fileData,
+        0666,
+        enableFdatasync ? folly::SyncType::WITH_SYNC
+                        : folly::SyncType::WITHOUT_SYNC);
   } catch (std::exception const& e) {
     return folly::makeUnexpected<std::string>(
         folly::exceptionStr(e).toStdString());
@@ -16,8 +16,11 @@ namespace fs = std::filesystem;
 namespace fs = std::experimental::filesystem;
 #endif
 #include <string>
+#include <thread>
 
+#include <folly/File.h>
 #include <folly/futures/Future.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/Constants.h>
@@ -28,7 +31,6 @@ namespace fs = std::experimental::filesystem;
 
 namespace {
 constexpr folly::StringPiece kTlvFormatMarker{"TlvFormatMarker"};
-enum WriteType { APPEND = 1, WRITE = 2 };
 
 } // anonymous namespace
 
@@ -51,6 +53,23 @@ struct PersistentObject {
  *
  * `storageFilePath`: Describe the path of file in file system where data will
  * be stored/retrieved from (in binary format).
+ *
+ * On-disk state is log-structured:
+ *  - `storageFilePath` holds a snapshot of the whole database;
+ *  - updates since the snapshot are appended to log segments
+ *    `<storageFilePath>.<id>.log`. All pending updates are written with a
+ *    single append (group commit), optionally followed by fdatasync;
+ *  - once the active segment exceeds the configured size it is sealed and
+ *    folded into the snapshot by a background compaction thread, off the
+ *    event base serving store/load/erase requests.
+ *
+ * All disk writes, including encoding, run on a dedicated I/O thread. The
+ * event base only updates the in-memory database and enqueues updates, so
+ * store/load/erase never wait on a slow disk.
+ *
+ * On start-up snapshot and segments are memory-mapped and replayed in order.
+ * On shutdown the full database is written to the snapshot and all segments
+ * are removed.
  */
 class PersistentStore : public OpenrEventBase {
  public:
@@ -67,6 +86,20 @@ class PersistentStore : public OpenrEventBase {
     return numOfWritesToDisk_;
   }
 
+  uint64_t
+  getNumOfCompactions() const {
+    return numOfCompactions_;
+  }
+
+  bool
+  isCompactionInProgress() const {
+    return compactionInProgress_;
+  }
+
+  // Path of the log segment with given id for the given snapshot file
+  static fs::path getSegmentFilePath(
+      const fs::path& storageFilePath, uint64_t segmentId);
+
   /**
    * Encode/Decode a PersistentObject, this can be private method, but for unit
    * test, we make it public
@@ -123,19 +156,51 @@ class PersistentStore : public OpenrEventBase {
   bool saveDatabaseToDisk() noexcept;
   bool loadDatabaseFromDisk() noexcept;
 
-  // Load TlvFormat from disk
-  folly::Expected<folly::Unit, std::string> loadDatabaseTlvFormat(
-      const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept;
+  // Replay TlvFormat file (snapshot or log segment) on top of `database`.
+  // A truncated trailing object, e.g. from a crash in the middle of an
+  // append, is ignored if `allowTornTail` is set.
+  static folly::Expected<folly::Unit, std::string> loadDatabaseTlvFormat(
+      const fs::path& filePath,
+      std::unordered_map<std::string, std::string>& database,
+      bool allowTornTail) noexcept;
+
+  // Encode the whole `database` as snapshot in TlvFormat
+  static folly::Expected<std::unique_ptr<folly::IOBuf>, std::string>
+  encodeDatabase(
+      const std::unordered_map<std::string, std::string>& database) noexcept;
+
+  // Hand persistent object over to I/O thread for writing to disk
+  void enqueueObject(PersistentObject pObject) noexcept;
 
-  // Wrapper function to save persistent object to disk immediately or later
+  // Wrapper function to save persistent object to disk immediately or later.
+  // Runs in I/O thread.
   void maybeSaveObjectToDisk() noexcept;
 
-  // Function to save Persistent Object to local disk.
+  // Function to save Persistent Object to local disk. Runs in I/O thread.
   bool savePersistentObjectToDisk() noexcept;
 
-  // Write IoBuf ro local disk
-  folly::Expected<folly::Unit, std::string> writeIoBufToDisk(
-      const std::unique_ptr<folly::IOBuf>& ioBuf, WriteType writeType) noexcept;
+  // Append IoBuf to the active log segment, sealing it once full
+  folly::Expected<folly::Unit, std::string> appendIoBufToSegment(
+      std::unique_ptr<folly::IOBuf> ioBuf) noexcept;
+
+  // Write over file with IoBuf atomically
+  static folly::Expected<folly::Unit, std::string> writeIoBufToDisk(
+      const fs::path& filePath,
+      const std::unique_ptr<folly::IOBuf>& ioBuf,
+      bool enableFdatasync) noexcept;
+
+  // Close active log segment and queue it up for compaction
+  void sealActiveSegment() noexcept;
+
+  // Ids of log segments present on disk, in ascending order
+  std::vector<uint64_t> listSegmentIds() const noexcept;
+
+  // Hand sealed segments over to compaction thread unless one is running
+  void maybeStartCompaction() noexcept;
+
+  // Fold given sealed segments into the snapshot. Runs in compaction thread
+  // and only touches files, never in-memory state of the event base.
+  void compactSegments(std::vector<uint64_t> segmentIds) noexcept;
 
   // Function to create a PersistentObject.
   PersistentObject toPersistentObject(
@@ -144,17 +209,36 @@ class PersistentStore : public OpenrEventBase {
   // Keeps track of number of writes of Database to disk
   std::atomic<std::uint64_t> numOfWritesToDisk_{0};
 
-  // Keeps track of number of writes of PersistentObject to disk
-  std::atomic<std::uint64_t> numOfNewWritesToDisk_{0};
+  // Keeps track of number of finished segment compactions
+  std::atomic<std::uint64_t> numOfCompactions_{0};
 
   // Location on disk where data will be synced up. A file will be created
   // if doesn't exists.
   const fs::path storageFilePath_;
 
+  // Size after which the active log segment is sealed and compacted
+  const uint64_t segmentSizeBytes_{0};
+
+  // Whether to fdatasync log appends and snapshots before acknowledging
+  const bool enableFdatasync_{false};
+
+  // Log segment currently appended to. Opened lazily on first append.
+  folly::File activeSegment_;
+  uint64_t activeSegmentId_{1};
+  uint64_t activeSegmentBytes_{0};
+
+  // Sealed segments not yet handed over to compaction
+  std::vector<uint64_t> sealedSegmentIds_;
+
+  // Background compaction of sealed segments into the snapshot. At most one
+  // compaction runs at a time.
+  std::thread compactionThread_;
+  std::atomic<bool> compactionInProgress_{false};
+
   // Dryrun to avoid disk writes in UTs
   bool dryrun_{false};
 
-  // Timer for saving database to disk
+  // Timer for saving database to disk. Scheduled in I/O thread.
   std::unique_ptr<folly::AsyncTimeout> saveDbTimer_;
   std::unique_ptr<ExponentialBackoff<std::chrono::milliseconds>>
       saveDbTimerBackoff_;
@@ -166,8 +250,19 @@ class PersistentStore : public OpenrEventBase {
   // Serializer for encoding/decoding of thrift objects
   apache::thrift::CompactSerializer serializer_;
 
-  // Define a persistent object
-  std::vector<PersistentObject> pObjects_;
+  // Persistent object waiting to be written, along with time it was enqueued
+  // at for measuring enqueue-to-durable latency
+  struct PendingObject {
+    PersistentObject pObject;
+    std::chrono::steady_clock::time_point enqueueTs;
+  };
+
+  // Persistent objects not yet written to disk. Owned by I/O thread.
+  std::vector<PendingObject> pObjects_;
+
+  // Dedicated thread for disk writes. Declared last so that it is stopped
+  // before any state it operates on is destroyed.
+  std::unique_ptr<folly::ScopedEventBaseThread> ioEvbThread_;
 };
 
 } // namespace openr
@@ -13,7 +13,10 @@ namespace openr {
 
 class PersistentStoreWrapper {
  public:
-  explicit PersistentStoreWrapper(const unsigned long tid);
+  explicit PersistentStoreWrapper(
+      const unsigned long tid,
+      const thrift::PersistentStoreConfig& storeConfig =
+          thrift::PersistentStoreConfig());
 
   // Destructor will try to save DB to disk before destroying the object
   ~PersistentStoreWrapper() {
@@ -5,15 +5,39 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/Benchmark.h>
 #include <folly/Random.h>
 #include <folly/init/Init.h>
 #include <openr/config-store/PersistentStoreWrapper.h>
 
+#define BENCHMARK_COUNTERS_PARAM(name, counters, param) \
+  BENCHMARK_IMPL_COUNTERS(                              \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param)),   \
+      FOLLY_PP_STRINGIZE(name) "(" #param ")",          \
+      counters,                                         \
+      iters,                                            \
+      unsigned,                                         \
+      iters) {                                          \
+    name(counters, iters, param);                       \
+  }
+
+namespace fb303 = facebook::fb303;
+
 namespace {
 // kIterations <= n: change this to 10 singce n starts from 10,
 // n is in BENCHMARK_PARAM(BM_PersistentStoreWrite, n)
 uint32_t kIterations = 10;
+
+// Number of times every key is updated per write amplification iteration
+const uint32_t kUpdateRounds = 10;
+
+int64_t
+getCounterValue(const std::string& name) {
+  const auto counters = fb303::fbData->getCounters();
+  const auto it = counters.find(name);
+  return it == counters.end() ? 0 : it->second;
+}
 } // namespace
 
 namespace openr {
@@ -155,6 +179,48 @@ BM_PersistentStoreCreateDestroy(uint32_t iters, size_t numOfStringKeys) {
   }
 }
 
+/**
+ * Benchmark for write amplification of frequently updated keys
+ * 1. Generate keys
+ * 2. Update every key kUpdateRounds times
+ * 3. Destroy the store, writing the final snapshot
+ * 4. Report bytes written to disk (log appends, compaction and snapshots)
+ *    relative to key-value payload bytes stored, in percent
+ */
+void
+BM_PersistentStoreWriteAmplification(
+    folly::UserCounters& counters, uint32_t iters, size_t numOfStringKeys) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  auto stringKeys = constructRandomVector(numOfStringKeys);
+
+  const auto bytesWrittenBefore =
+      getCounterValue("persistent_store.bytes_written.sum");
+  const auto payloadBytesBefore =
+      getCounterValue("persistent_store.payload_bytes.sum");
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto store = std::make_unique<PersistentStoreWrapper>(tid + 2);
+    store->run();
+
+    suspender.dismiss(); // Start measuring benchmark time
+    for (uint32_t round = 0; round < kUpdateRounds; round++) {
+      writeKeyValueToStore(stringKeys, *store, 1);
+    }
+    store.reset();
+    suspender.rehire(); // Stop measuring time again
+  }
+
+  const auto bytesWritten =
+      getCounterValue("persistent_store.bytes_written.sum") -
+      bytesWrittenBefore;
+  const auto payloadBytes =
+      getCounterValue("persistent_store.payload_bytes.sum") -
+      payloadBytesBefore;
+  counters["write_amplification_pct"] =
+      payloadBytes > 0 ? (100 * bytesWritten / payloadBytes) : 0;
+}
+
 // The parameter is the number of keys already written to store
 // before benchmarking the time.
 BENCHMARK_PARAM(BM_PersistentStoreWrite, 10);
@@ -172,6 +238,11 @@ BENCHMARK_PARAM(BM_PersistentStoreCreateDestroy, 100);
 BENCHMARK_PARAM(BM_PersistentStoreCreateDestroy, 1000);
 BENCHMARK_PARAM(BM_PersistentStoreCreateDestroy, 10000);
 
+BENCHMARK_COUNTERS_PARAM(BM_PersistentStoreWriteAmplification, counters, 100);
+BENCHMARK_COUNTERS_PARAM(BM_PersistentStoreWriteAmplification, counters, 1000);
+BENCHMARK_COUNTERS_PARAM(
+    BM_PersistentStoreWriteAmplification, counters, 10000);
+
 } // namespace openr
 
 int
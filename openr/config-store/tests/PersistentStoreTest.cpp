@@ -17,6 +17,7 @@
 #include <openr/config-store/PersistentStore.h>
 #include <openr/config-store/PersistentStoreWrapper.h>
 #include <openr/if/gen-cpp2/Types_types.h>
+#include <openr/tests/utils/Utils.h>
 
 namespace openr {
 
@@ -60,6 +61,42 @@ loadDatabaseFromDisk(const std::string& filePath) {
   return newDatabase;
 }
 
+// Encode single PersistentObject into its on-disk representation
+std::string
+encodeObject(
+    ActionType type,
+    const std::string& key,
+    std::optional<std::string> data = std::nullopt) {
+  PersistentObject pObject;
+  pObject.type = type;
+  pObject.key = key;
+  pObject.data = std::move(data);
+  auto buf = PersistentStore::encodePersistentObject(pObject);
+  EXPECT_FALSE(buf.hasError());
+  return (*buf)->moveToFbString().toStdString();
+}
+
+// Remove snapshot and log segments possibly left behind by previous runs
+void
+removeStoreFiles(const std::string& filePath) {
+  std::error_code ec;
+  fs::remove(filePath, ec);
+  for (uint64_t segmentId = 1; segmentId <= 1000; ++segmentId) {
+    fs::remove(PersistentStore::getSegmentFilePath(filePath, segmentId), ec);
+  }
+}
+
+// Check whether any log segment exists for given snapshot
+bool
+hasSegmentFiles(const std::string& filePath) {
+  for (uint64_t segmentId = 1; segmentId <= 1000; ++segmentId) {
+    if (fs::exists(PersistentStore::getSegmentFilePath(filePath, segmentId))) {
+      return true;
+    }
+  }
+  return false;
+}
+
 TEST(PersistentStoreTest, LoadStoreEraseTest) {
   const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
 
@@ -215,6 +252,126 @@ TEST(PersistentStoreTest, BulkStoreLoad) {
   }
 }
 
+/*
+ * Snapshot followed by log segments written by a previous run which didn't
+ * shut down cleanly. Verify segments are replayed in order on top of the
+ * snapshot, a torn object at the end of the last segment is ignored and
+ * segments are folded into the snapshot afterwards.
+ */
+TEST(PersistentStoreTest, ReplayLogSegments) {
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  const auto filePath =
+      fmt::format("/tmp/openr_persistent_store_test_{}", tid);
+  removeStoreFiles(filePath);
+
+  const std::string marker = kTlvFormatMarker.str();
+  const auto torn = encodeObject(ActionType::ADD, "key4", "val4");
+  EXPECT_TRUE(folly::writeFile(
+      marker + encodeObject(ActionType::ADD, "key1", "val1") +
+          encodeObject(ActionType::ADD, "key2", "val2"),
+      filePath.c_str()));
+  EXPECT_TRUE(folly::writeFile(
+      marker + encodeObject(ActionType::ADD, "key1", "val1-new") +
+          encodeObject(ActionType::DEL, "key2"),
+      PersistentStore::getSegmentFilePath(filePath, 1).c_str()));
+  EXPECT_TRUE(folly::writeFile(
+      marker + encodeObject(ActionType::ADD, "key3", "val3") +
+          torn.substr(0, torn.size() / 2),
+      PersistentStore::getSegmentFilePath(filePath, 2).c_str()));
+
+  const StoreDatabase expectedDatabase{{"key1", "val1-new"}, {"key3", "val3"}};
+  {
+    PersistentStoreWrapper store(tid);
+    store.run();
+
+    EXPECT_EQ("val1-new", store->load("key1").get());
+    EXPECT_FALSE(store->load("key2").get());
+    EXPECT_EQ("val3", store->load("key3").get());
+    EXPECT_FALSE(store->load("key4").get());
+  }
+
+  // Clean shutdown leaves only the snapshot behind
+  EXPECT_EQ(expectedDatabase, loadDatabaseFromDisk(filePath));
+  EXPECT_FALSE(hasSegmentFiles(filePath));
+  removeStoreFiles(filePath);
+}
+
+/*
+ * Write enough data to roll over many small log segments. Verify sealed
+ * segments get compacted in background and the content survives restart.
+ */
+TEST(PersistentStoreTest, SegmentCompaction) {
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  thrift::PersistentStoreConfig storeConfig;
+  storeConfig.segment_size_bytes() = 256;
+
+  StoreDatabase database;
+  std::string filePath;
+  {
+    PersistentStoreWrapper store(tid, storeConfig);
+    filePath = store.filePath;
+    removeStoreFiles(filePath);
+    store.run();
+
+    for (auto index = 0; index < 100; index++) {
+      const auto key = fmt::format("key-{}", index % 20);
+      const auto val = fmt::format("val-{}", index);
+      database[key] = val;
+      store->store(key, val).get();
+    }
+
+    // Wait for at least one compaction to finish
+    while (store->getNumOfCompactions() == 0 or
+           store->isCompactionInProgress()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  EXPECT_EQ(database, loadDatabaseFromDisk(filePath));
+  EXPECT_FALSE(hasSegmentFiles(filePath));
+
+  {
+    PersistentStoreWrapper store(tid, storeConfig);
+    store.run();
+    for (const auto& [key, val] : database) {
+      EXPECT_EQ(val, store->load(key).get());
+    }
+  }
+  removeStoreFiles(filePath);
+}
+
+/*
+ * Without periodic saving, every update is written by I/O thread before the
+ * API call returns. Verify content is on disk right after `store`.
+ */
+TEST(PersistentStoreTest, SynchronousWriteOnIoThread) {
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  const auto filePath =
+      fmt::format("/tmp/openr_persistent_store_test_{}", tid);
+  removeStoreFiles(filePath);
+
+  auto tConfig = getBasicOpenrConfig();
+  tConfig.persistent_config_store_path() = filePath;
+  auto config = std::make_shared<Config>(tConfig);
+  {
+    PersistentStore store(
+        config, false /* dryrun */, false /* periodicallySaveToDisk */);
+    std::thread storeThread([&store]() { store.run(); });
+    store.waitUntilRunning();
+
+    store.store("key1", "val1").get();
+    const StoreDatabase expectedDatabase{{"key1", "val1"}};
+    EXPECT_EQ(
+        expectedDatabase,
+        loadDatabaseFromDisk(
+            PersistentStore::getSegmentFilePath(filePath, 1).string()));
+
+    store.stop();
+    storeThread.join();
+  }
+  removeStoreFiles(filePath);
+}
+
 } // namespace openr
 
 int
@@ -337,6 +337,13 @@ Config::checkSparkConfig() const {
         *sparkConfig.step_detector_conf()->lower_threshold(),
         *sparkConfig.step_detector_conf()->upper_threshold()));
   }
+
+  if (sparkConfig.max_allowed_pps_per_interface().has_value() and
+      *sparkConfig.max_allowed_pps_per_interface() <= 0) {
+    throw std::out_of_range(fmt::format(
+        "max_allowed_pps_per_interface ({}) should be > 0",
+        *sparkConfig.max_allowed_pps_per_interface()));
+  }
 }
 
 void
@@ -372,6 +379,41 @@ Config::checkLinkMonitorConfig() const {
         *lmConf.linkflap_initial_backoff_ms(),
         *lmConf.linkflap_max_backoff_ms()));
   }
+
+  // flap damping validation
+  auto checkFlapDampingConfig = [](const thrift::FlapDampingConfig& conf,
+                                   const std::string& name) {
+    if (*conf.penalty_per_flap() <= 0) {
+      throw std::out_of_range(fmt::format(
+          "{}.penalty_per_flap ({}) should be > 0",
+          name,
+          *conf.penalty_per_flap()));
+    }
+    if (*conf.half_life_ms() <= 0) {
+      throw std::out_of_range(fmt::format(
+          "{}.half_life_ms ({}) should be > 0", name, *conf.half_life_ms()));
+    }
+    if (*conf.max_suppress_ms() <= 0) {
+      throw std::out_of_range(fmt::format(
+          "{}.max_suppress_ms ({}) should be > 0",
+          name,
+          *conf.max_suppress_ms()));
+    }
+    if (*conf.reuse_threshold() <= 0 or
+        *conf.reuse_threshold() >= *conf.suppress_threshold()) {
+      throw std::out_of_range(fmt::format(
+          "{}.reuse_threshold ({}) should be > 0 and < suppress_threshold ({})",
+          name,
+          *conf.reuse_threshold(),
+          *conf.suppress_threshold()));
+    }
+  };
+  if (auto conf = lmConf.interface_flap_damping_config()) {
+    checkFlapDampingConfig(*conf, "interface_flap_damping_config");
+  }
+  if (auto conf = lmConf.adjacency_flap_damping_config()) {
+    checkFlapDampingConfig(*conf, "adjacency_flap_damping_config");
+  }
 }
 
 void
@@ -565,6 +607,37 @@ Config::populateInternalDb() {
     throw std::invalid_argument("Route delete duration must be >= 0ms");
   }
 
+  // Check bulk prefix database sharding
+  const auto prefixDbShardCount = *config_.prefix_db_shard_count();
+  if (prefixDbShardCount < 0 or
+      static_cast<uint32_t>(prefixDbShardCount) >
+          Constants::kMaxPrefixDbShardCount) {
+    throw std::out_of_range(fmt::format(
+        "prefix_db_shard_count {} must be within [0, {}]",
+        prefixDbShardCount,
+        Constants::kMaxPrefixDbShardCount));
+  }
+
+  // Check persistent store log segment size
+  const auto segmentSize =
+      *config_.persistent_store_config()->segment_size_bytes();
+  if (segmentSize <= 0) {
+    throw std::out_of_range(fmt::format(
+        "persistent_store_config.segment_size_bytes {} should be > 0",
+        segmentSize));
+  }
+
+  // Check transport compression threshold of KvStore peer clients
+  if (auto thriftClientConfig = getThriftClientConfig()) {
+    if (auto compression = thriftClientConfig->kvstore_peer_compression();
+        compression and *compression->min_compress_size_bytes() < 0) {
+      throw std::out_of_range(fmt::format(
+          "thrift_client.kvstore_peer_compression.min_compress_size_bytes {} "
+          "should be >= 0",
+          *compression->min_compress_size_bytes()));
+    }
+  }
+
   // validate KvStore config (e.g. ttl/flood-rate/etc.)
   checkKvStoreConfig();
 
@@ -648,6 +721,9 @@ Config::toThriftKvStoreConfig() const {
   if (auto thriftClientConfig = getThriftClientConfig()) {
     config.enable_secure_thrift_client() =
         *thriftClientConfig->enable_secure_thrift_client();
+    if (auto compression = thriftClientConfig->kvstore_peer_compression()) {
+      config.peer_compression_config() = *compression;
+    }
   }
   auto thriftServer = getThriftServerConfig();
   if (auto x509_cert_path = thriftServer.x509_cert_path()) {
@@ -304,6 +304,19 @@ class Config {
     return config_.enable_kvstore_dispatcher().value();
   }
 
+  //
+  // prefix-manager
+  //
+  uint32_t
+  getPrefixDbShardCount() const {
+    return *config_.prefix_db_shard_count();
+  }
+
+  bool
+  isPrefixDbShardingEnabled() const {
+    return getPrefixDbShardCount() > 0;
+  }
+
   PrefixAllocationParams
   getPrefixAllocationParams() const {
     CHECK(isPrefixAllocationEnabled());
@@ -553,6 +566,14 @@ class Config {
     return *config_.softdrained_node_increment();
   }
 
+  //
+  // Persistent store
+  //
+  const thrift::PersistentStoreConfig&
+  getPersistentStoreConfig() const {
+    return *config_.persistent_store_config();
+  }
+
   //
   // Memory profiling
   //
@@ -545,6 +545,25 @@ TEST(ConfigTest, PopulateInternalDb) {
     confInvalidLm.link_monitor_config()->linkflap_max_backoff_ms() = 300000;
     EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
   }
+  // interface_flap_damping_config.reuse_threshold >= suppress_threshold
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    thrift::FlapDampingConfig dampingConf;
+    dampingConf.reuse_threshold() = 3000;
+    dampingConf.suppress_threshold() = 2000;
+    confInvalidLm.link_monitor_config()->interface_flap_damping_config() =
+        dampingConf;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
+  // adjacency_flap_damping_config.half_life_ms <= 0
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    thrift::FlapDampingConfig dampingConf;
+    dampingConf.half_life_ms() = 0;
+    confInvalidLm.link_monitor_config()->adjacency_flap_damping_config() =
+        dampingConf;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
 
   // prefix allocation
 
@@ -681,6 +700,46 @@ TEST(ConfigTest, PopulateInternalDb) {
     conf.route_delete_delay_ms() = 1000;
     EXPECT_NO_THROW((Config(conf)));
   }
+
+  // bulk prefix database sharding
+  {
+    auto conf = getBasicOpenrConfig();
+    EXPECT_FALSE(Config(conf).isPrefixDbShardingEnabled());
+
+    conf.prefix_db_shard_count() = -1;
+    EXPECT_THROW((Config(conf)), std::out_of_range);
+
+    conf.prefix_db_shard_count() = Constants::kMaxPrefixDbShardCount + 1;
+    EXPECT_THROW((Config(conf)), std::out_of_range);
+
+    conf.prefix_db_shard_count() = 64;
+    EXPECT_NO_THROW((Config(conf)));
+    EXPECT_TRUE(Config(conf).isPrefixDbShardingEnabled());
+    EXPECT_EQ(64, Config(conf).getPrefixDbShardCount());
+  }
+  // persistent store: segment_size_bytes <= 0
+  {
+    auto conf = getBasicOpenrConfig();
+    conf.persistent_store_config()->segment_size_bytes() = 0;
+    EXPECT_THROW((Config(conf)), std::out_of_range);
+  }
+  // thrift client: negative compression threshold
+  {
+    auto conf = getBasicOpenrConfig();
+    thrift::TransportCompressionConfig compression;
+    compression.min_compress_size_bytes() = -1;
+    conf.thrift_client().ensure().kvstore_peer_compression() = compression;
+    EXPECT_THROW((Config(conf)), std::out_of_range);
+
+    compression.min_compress_size_bytes() = 4096;
+    conf.thrift_client()->kvstore_peer_compression() = compression;
+    EXPECT_EQ(
+        4096,
+        *Config(conf)
+             .toThriftKvStoreConfig()
+             .peer_compression_config()
+             ->min_compress_size_bytes());
+  }
 }
 
 TEST(ConfigTest, SoftdrainConfigTest) {
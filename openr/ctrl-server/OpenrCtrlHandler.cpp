@@ -16,10 +16,12 @@ namespace fs = std::experimental::filesystem;
 #endif
 
 #include <folly/ExceptionString.h>
+#include <folly/executors/InlineExecutor.h>
 #include <folly/logging/xlog.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/LsdbUtil.h>
+#include <openr/common/Tracing.h>
 #include <openr/common/Util.h>
 #include <openr/monitor/LogSample.h>
 
@@ -332,6 +334,63 @@ OpenrCtrlHandler::getEventLogs(std::vector<::std::string>& _return) {
   }
 }
 
+void
+OpenrCtrlHandler::getTraceEvents(std::string& _return, int64_t traceId) {
+  _return = TraceRecorder::toChromeTrace(TraceRecorder::get().collect(traceId));
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::MemoryBreakdown>>
+OpenrCtrlHandler::semifuture_getMemoryBreakdown() {
+  auto areaSummariesSf = kvStore_
+      ? kvStore_->semifuture_getKvStoreAreaSummaryInternal({} /* all areas */)
+      : folly::makeSemiFuture(
+            std::make_unique<std::vector<thrift::KvStoreAreaSummary>>());
+
+  return std::move(areaSummariesSf)
+      .deferValue([this](auto&& areaSummaries) {
+        auto breakdown = std::make_unique<thrift::MemoryBreakdown>();
+        breakdown->moduleAllocatedBytes() =
+            memory::getModuleArenaAllocatedBytes();
+        for (auto const& summary : *areaSummaries) {
+          breakdown->kvStoreKeyCount()[*summary.area()] =
+              *summary.keyValsCount();
+          breakdown->kvStoreKeyValBytes()[*summary.area()] =
+              *summary.keyValsBytes();
+        }
+
+        std::map<std::string, int64_t> counters;
+        getCounters(counters);
+        auto getCounterValue = [&counters](std::string const& key) -> int64_t {
+          auto it = counters.find(key);
+          return it != counters.end() ? it->second : 0;
+        };
+        breakdown->adjacencyCount() =
+            getCounterValue("decision.num_complete_adjacencies") +
+            getCounterValue("decision.num_partial_adjacencies");
+        breakdown->prefixCount() = getCounterValue("decision.num_prefixes");
+        breakdown->unicastRouteCount() =
+            getCounterValue("fib.num_unicast_routes");
+        breakdown->mplsRouteCount() = getCounterValue("fib.num_mpls_routes");
+        breakdown->processRssBytes() = getCounterValue("process.memory.rss");
+        return breakdown;
+      })
+      .deferError([](folly::exception_wrapper&& ew)
+                      -> std::unique_ptr<thrift::MemoryBreakdown> {
+        throw thrift::OpenrError(ew.what().toStdString());
+      });
+}
+
+void
+OpenrCtrlHandler::dumpHeapProfile(std::string& _return) {
+  _return = fmt::format(
+      "{}.{}.heap", Constants::kHeapProfileFilePrefix, getUnixTimeStampMs());
+  auto ret = memory::dumpHeapProfile(_return);
+  if (ret.hasError()) {
+    throw thrift::OpenrError(
+        fmt::format("Failed to dump heap profile: {}", ret.error()));
+  }
+}
+
 void
 OpenrCtrlHandler::getCounters(std::map<std::string, int64_t>& _return) {
   BaseService::getCounters(_return);
@@ -386,6 +445,96 @@ OpenrCtrlHandler::getMyNodeName(std::string& _return) {
   _return = std::string(nodeName_);
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::NodeSnapshot>>
+OpenrCtrlHandler::semifuture_getNodeSnapshot(
+    std::unique_ptr<thrift::NodeSnapshotParams> params) {
+  // Serve cached module sections unless they are older than refresh interval.
+  // Modules are only queried on demand, no background refresh.
+  std::optional<thrift::NodeSnapshot> cached;
+  if (*params->allowCached()) {
+    cachedNodeSnapshot_.withRLock([&](auto const& cachedSnapshot) {
+      if (cachedSnapshot.has_value() and
+          std::chrono::steady_clock::now() - cachedSnapshot->collectTime <
+              Constants::kNodeSnapshotRefreshInterval) {
+        cached = cachedSnapshot->snapshot;
+      }
+    });
+  }
+  folly::SemiFuture<thrift::NodeSnapshot> sf = cached.has_value()
+      ? folly::makeSemiFuture(std::move(*cached))
+      : collectNodeSnapshot().deferValue(
+            [this](thrift::NodeSnapshot&& snapshot) {
+              *cachedNodeSnapshot_.wlock() = CachedNodeSnapshot{
+                  std::chrono::steady_clock::now(), snapshot};
+              return std::move(snapshot);
+            });
+
+  return std::move(sf).deferValue([this, params = std::move(params)](
+                                      thrift::NodeSnapshot&& snapshot) {
+    snapshot.nodeName() = nodeName_;
+
+    std::map<std::string, int64_t> counters;
+    getCounters(counters);
+    auto getCounterValue = [&counters](std::string const& key) -> int64_t {
+      auto it = counters.find(key);
+      return it != counters.end() ? it->second : 0;
+    };
+    snapshot.unicastRouteCount() = getCounterValue("fib.num_unicast_routes");
+    snapshot.mplsRouteCount() = getCounterValue("fib.num_mpls_routes");
+
+    if (params->counterKeys().has_value()) {
+      for (auto const& key : *params->counterKeys()) {
+        auto it = counters.find(key);
+        if (it != counters.end()) {
+          snapshot.counters()->emplace(*it);
+        }
+      }
+    } else {
+      snapshot.counters() = std::move(counters);
+    }
+    return std::make_unique<thrift::NodeSnapshot>(std::move(snapshot));
+  });
+}
+
+folly::SemiFuture<thrift::NodeSnapshot>
+OpenrCtrlHandler::collectNodeSnapshot() {
+  // Fan out to all modules at once. Missing module yields an empty section.
+  folly::SemiFuture<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>>
+      areaSummariesSf = kvStore_
+      ? kvStore_->semifuture_getKvStoreAreaSummaryQuiet()
+      : folly::makeSemiFuture(
+            std::make_unique<std::vector<thrift::KvStoreAreaSummary>>());
+  folly::SemiFuture<std::unique_ptr<std::vector<thrift::SparkNeighbor>>>
+      neighborsSf = spark_
+      ? spark_->getNeighbors()
+      : folly::makeSemiFuture(
+            std::make_unique<std::vector<thrift::SparkNeighbor>>());
+  folly::SemiFuture<std::unique_ptr<thrift::DumpLinksReply>> interfacesSf =
+      linkMonitor_
+      ? linkMonitor_->semifuture_getInterfaces()
+      : folly::makeSemiFuture(std::make_unique<thrift::DumpLinksReply>());
+
+  return folly::collectAll(
+             std::move(areaSummariesSf),
+             std::move(neighborsSf),
+             std::move(interfacesSf))
+      .deferValue([](auto&& results) {
+        auto& [areaSummaries, neighbors, interfaces] = results;
+        thrift::NodeSnapshot snapshot;
+        snapshot.snapshotTimestampMs() = getUnixTimeStampMs();
+        if (areaSummaries.hasValue()) {
+          snapshot.kvStoreAreaSummaries() = std::move(*areaSummaries.value());
+        }
+        if (neighbors.hasValue()) {
+          snapshot.neighbors() = std::move(*neighbors.value());
+        }
+        if (interfaces.hasValue()) {
+          snapshot.interfaces() = std::move(*interfaces.value());
+        }
+        return snapshot;
+      });
+}
+
 void
 OpenrCtrlHandler::getOpenrVersion(thrift::OpenrVersions& _openrVersion) {
   _openrVersion.version() = Constants::kOpenrVersion;
@@ -518,6 +667,20 @@ OpenrCtrlHandler::semifuture_syncPrefixesByType(
       .defer([](folly::Try<bool>&&) { return folly::Unit(); });
 }
 
+folly::SemiFuture<folly::Unit>
+OpenrCtrlHandler::semifuture_syncPrefixesByTypeChunk(
+    thrift::PrefixType prefixType,
+    std::unique_ptr<std::vector<thrift::PrefixEntry>> prefixes,
+    bool isFirstChunk,
+    bool isLastChunk) {
+  CHECK(prefixManager_);
+  return prefixManager_
+      ->syncPrefixesByTypeChunk(
+          prefixType, std::move(*prefixes), isFirstChunk, isLastChunk)
+      // ATTN: propagate error of out-of-order chunks to the client
+      .deferValue([](bool) { return folly::Unit(); });
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::PrefixEntry>>>
 OpenrCtrlHandler::semifuture_getPrefixes() {
   CHECK(prefixManager_);
@@ -543,6 +706,15 @@ OpenrCtrlHandler::semifuture_getAdvertisedRoutesFiltered(
   return prefixManager_->getAdvertisedRoutesFiltered(std::move(*filter));
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::AdvertisedRoutesPage>>
+OpenrCtrlHandler::semifuture_getAdvertisedRoutesFilteredPage(
+    std::unique_ptr<thrift::AdvertisedRouteFilter> filter,
+    std::unique_ptr<thrift::PageParams> pageParams) {
+  CHECK(prefixManager_);
+  return prefixManager_->getAdvertisedRoutesFilteredPage(
+      std::move(*filter), std::move(*pageParams));
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::OriginatedPrefixEntry>>>
 OpenrCtrlHandler::semifuture_getOriginatedPrefixes() {
   CHECK(prefixManager_);
@@ -593,6 +765,20 @@ OpenrCtrlHandler::semifuture_getRouteDetailDb() {
   return fib_->getRouteDetailDb();
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+OpenrCtrlHandler::semifuture_getRouteDbPage(
+    std::unique_ptr<thrift::PageParams> pageParams) {
+  CHECK(fib_);
+  return fib_->getRouteDbPage(std::move(*pageParams));
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetailPage>>
+OpenrCtrlHandler::semifuture_getRouteDetailDbPage(
+    std::unique_ptr<thrift::PageParams> pageParams) {
+  CHECK(fib_);
+  return fib_->getRouteDetailDbPage(std::move(*pageParams));
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
 OpenrCtrlHandler::semifuture_getUnicastRoutesFiltered(
     std::unique_ptr<std::vector<std::string>> prefixes) {
@@ -661,6 +847,15 @@ OpenrCtrlHandler::semifuture_getReceivedRoutesFiltered(
   return decision_->getReceivedRoutesFiltered(std::move(*filter));
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+OpenrCtrlHandler::semifuture_getReceivedRoutesFilteredPage(
+    std::unique_ptr<thrift::ReceivedRouteFilter> filter,
+    std::unique_ptr<thrift::PageParams> pageParams) {
+  CHECK(decision_);
+  return decision_->getReceivedRoutesFilteredPage(
+      std::move(*filter), std::move(*pageParams));
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>>
 OpenrCtrlHandler::semifuture_getRouteDbComputed(
     std::unique_ptr<std::string> nodeName) {
@@ -668,6 +863,35 @@ OpenrCtrlHandler::semifuture_getRouteDbComputed(
   return decision_->getDecisionRouteDb(*nodeName);
 }
 
+apache::thrift::ServerStream<thrift::RouteDatabase>
+OpenrCtrlHandler::getRouteDbComputedStream(
+    std::unique_ptr<std::vector<std::string>> nodeNames) {
+  CHECK(decision_);
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<thrift::RouteDatabase>::createPublisher();
+  auto publisher = std::make_shared<
+      apache::thrift::ServerStreamPublisher<thrift::RouteDatabase>>(
+      std::move(streamAndPublisher.second));
+
+  decision_
+      ->getDecisionRouteDbs(
+          std::move(*nodeNames),
+          [publisher](thrift::RouteDatabase&& routeDb) {
+            publisher->next(std::move(routeDb));
+          })
+      .via(folly::getKeepAliveToken(folly::InlineExecutor::instance()))
+      .thenTry([publisher](folly::Try<folly::Unit>&& result) {
+        if (result.hasException()) {
+          std::move(*publisher)
+              .complete(folly::make_exception_wrapper<thrift::OpenrError>(
+                  result.exception().what().toStdString()));
+          return;
+        }
+        std::move(*publisher).complete();
+      });
+  return std::move(streamAndPublisher.first);
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::AdjDbs>>
 OpenrCtrlHandler::semifuture_getDecisionAdjacencyDbs() {
   auto filter = std::make_unique<thrift::AdjacenciesFilter>();
@@ -762,6 +986,19 @@ OpenrCtrlHandler::semifuture_getKvStoreKeyValsFilteredArea(
           });
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::PublicationPage>>
+OpenrCtrlHandler::semifuture_getKvStoreKeyValsFilteredAreaPage(
+    std::unique_ptr<thrift::KeyDumpParams> filter,
+    std::unique_ptr<std::string> area,
+    std::unique_ptr<thrift::PageParams> pageParams) {
+  XLOG(DBG5) << __FUNCTION__ << " for keys: " << toString(*filter.get())
+             << "; area: " << *area;
+
+  CHECK(kvStore_) << "kvstore not initialized";
+  return kvStore_->semifuture_dumpKvStoreKeysPage(
+      std::move(*area), std::move(*filter), std::move(*pageParams));
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::Publication>>
 OpenrCtrlHandler::semifuture_getKvStoreHashFiltered(
     std::unique_ptr<thrift::KeyDumpParams> filter) {
@@ -862,6 +1099,16 @@ OpenrCtrlHandler::semifuture_longPollKvStoreAdjArea(
   return sf;
 }
 
+folly::SemiFuture<int64_t>
+OpenrCtrlHandler::semifuture_longPollKvStoreAdjVersion(
+    std::unique_ptr<std::string> area, int64_t version) {
+  CHECK(kvStore_);
+  return kvStore_->semifuture_longPollAdjVersion(std::move(*area), version)
+      .deferError([](folly::exception_wrapper&& ew) -> int64_t {
+        throw thrift::OpenrError(ew.what().toStdString());
+      });
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::PeersMap>>
 OpenrCtrlHandler::semifuture_getKvStorePeers() {
   return semifuture_getKvStorePeersArea(
@@ -83,6 +83,11 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   // Openr Node Name
   void getMyNodeName(std::string& _return) override;
 
+  // Composite node state for monitoring tools, see thrift::NodeSnapshot
+  folly::SemiFuture<std::unique_ptr<thrift::NodeSnapshot>>
+  semifuture_getNodeSnapshot(
+      std::unique_ptr<thrift::NodeSnapshotParams> params) override;
+
   //
   // config APIs
   //
@@ -111,6 +116,13 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
 
   void getEventLogs(std::vector<::std::string>& _return) override;
 
+  void getTraceEvents(std::string& _return, int64_t traceId) override;
+
+  folly::SemiFuture<std::unique_ptr<thrift::MemoryBreakdown>>
+  semifuture_getMemoryBreakdown() override;
+
+  void dumpHeapProfile(std::string& _return) override;
+
   //
   // PrefixManager APIs
   //
@@ -128,6 +140,12 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       thrift::PrefixType prefixType,
       std::unique_ptr<std::vector<thrift::PrefixEntry>> prefixes) override;
 
+  folly::SemiFuture<folly::Unit> semifuture_syncPrefixesByTypeChunk(
+      thrift::PrefixType prefixType,
+      std::unique_ptr<std::vector<thrift::PrefixEntry>> prefixes,
+      bool isFirstChunk,
+      bool isLastChunk) override;
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::PrefixEntry>>>
   semifuture_getPrefixes() override;
 
@@ -141,6 +159,11 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   semifuture_getAdvertisedRoutesFiltered(
       std::unique_ptr<thrift::AdvertisedRouteFilter> filter) override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::AdvertisedRoutesPage>>
+  semifuture_getAdvertisedRoutesFilteredPage(
+      std::unique_ptr<thrift::AdvertisedRouteFilter> filter,
+      std::unique_ptr<thrift::PageParams> pageParams) override;
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdvertisedRoute>>>
   semifuture_getAreaAdvertisedRoutes(
       std::unique_ptr<std::string> areaName,
@@ -170,6 +193,14 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetail>>
   semifuture_getRouteDetailDb() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+  semifuture_getRouteDbPage(
+      std::unique_ptr<thrift::PageParams> pageParams) override;
+
+  folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetailPage>>
+  semifuture_getRouteDetailDbPage(
+      std::unique_ptr<thrift::PageParams> pageParams) override;
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
   semifuture_getUnicastRoutesFiltered(
       std::unique_ptr<std::vector<::std::string>> prefixes) override;
@@ -211,6 +242,11 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   semifuture_getReceivedRoutesFiltered(
       std::unique_ptr<thrift::ReceivedRouteFilter> filter) override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+  semifuture_getReceivedRoutesFilteredPage(
+      std::unique_ptr<thrift::ReceivedRouteFilter> filter,
+      std::unique_ptr<thrift::PageParams> pageParams) override;
+
   folly::SemiFuture<std::unique_ptr<thrift::AdjDbs>>
   semifuture_getDecisionAdjacencyDbs() override;
 
@@ -276,6 +312,16 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       std::unique_ptr<thrift::KeyDumpParams> filter,
       std::unique_ptr<std::string> area) override;
 
+  /*
+   * Paginated variant of getKvStoreKeyValsFilteredArea(). Pass back
+   * `nextCursor` of the returned page until it is unset.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::PublicationPage>>
+  semifuture_getKvStoreKeyValsFilteredAreaPage(
+      std::unique_ptr<thrift::KeyDumpParams> filter,
+      std::unique_ptr<std::string> area,
+      std::unique_ptr<thrift::PageParams> pageParams) override;
+
   /*
    * [Backward Compatibility] Same as above, but use local KvStoreDb's area
    */
@@ -352,6 +398,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   apache::thrift::ServerStream<thrift::RouteDatabaseDeltaDetail>
   subscribeFibDetail();
 
+  apache::thrift::ServerStream<thrift::RouteDatabase> getRouteDbComputedStream(
+      std::unique_ptr<std::vector<std::string>> nodeNames) override;
+
   folly::SemiFuture<apache::thrift::ResponseAndServerStream<
       thrift::Publication,
       thrift::Publication>>
@@ -388,6 +437,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       std::unique_ptr<std::string> area,
       std::unique_ptr<thrift::KeyVals> snapshot) override;
 
+  folly::SemiFuture<int64_t> semifuture_longPollKvStoreAdjVersion(
+      std::unique_ptr<std::string> area, int64_t version) override;
+
   //
   // LinkMonitor APIs
   //
@@ -486,6 +538,11 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
     return longPollReqs_->size();
   }
 
+  inline bool
+  hasCachedNodeSnapshot() {
+    return cachedNodeSnapshot_.rlock()->has_value();
+  }
+
   inline size_t
   getNumFibPublishers() {
     return fibPublishers_.wlock()->size();
@@ -514,6 +571,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   void closeKvStorePublishers();
   void closeFibPublishers();
 
+  // Query modules concurrently for the module sections of NodeSnapshot
+  folly::SemiFuture<thrift::NodeSnapshot> collectNodeSnapshot();
+
   const std::string nodeName_;
   const std::unordered_set<std::string> acceptablePeerCommonNames_;
 
@@ -556,6 +616,13 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       std::unordered_map<int64_t, std::pair<folly::Promise<bool>, int64_t>>>>
       longPollReqs_;
 
+  // Module sections of NodeSnapshot as of last collection
+  struct CachedNodeSnapshot {
+    std::chrono::steady_clock::time_point collectTime;
+    thrift::NodeSnapshot snapshot;
+  };
+  folly::Synchronized<std::optional<CachedNodeSnapshot>> cachedNodeSnapshot_;
+
   // fiber task future hold for kvStore update, fib update reader's
   std::vector<folly::Future<folly::Unit>> workers_;
 }; // class OpenrCtrlHandler
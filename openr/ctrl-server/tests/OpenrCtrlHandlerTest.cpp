@@ -6,10 +6,13 @@
  */
 
 #include <folly/init/Init.h>
+#include <folly/memory/Malloc.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <openr/common/Constants.h>
+#include <openr/common/Flags.h>
+#include <openr/common/OpenrEventBase.h>
 #include <openr/common/Types.h>
 #include <openr/common/Util.h>
 #include <openr/config-store/PersistentStore.h>
@@ -201,7 +204,7 @@ class OpenrCtrlFixture : public ::testing::Test {
 
  protected:
   messaging::ReplicateQueue<DecisionRouteUpdate> routeUpdatesQueue_;
-  messaging::ReplicateQueue<InterfaceDatabase> interfaceUpdatesQueue_;
+  messaging::ReplicateQueue<InterfaceDatabaseDelta> interfaceUpdatesQueue_;
   messaging::ReplicateQueue<PeerEvent> peerUpdatesQueue_;
   messaging::ReplicateQueue<NeighborInitEvent> neighborUpdatesQueue_;
   messaging::ReplicateQueue<PrefixEvent> prefixUpdatesQueue_;
@@ -245,6 +248,106 @@ TEST_F(OpenrCtrlFixture, getMyNodeName) {
   EXPECT_EQ(nodeName_, res);
 }
 
+TEST_F(OpenrCtrlFixture, NodeSnapshotApis) {
+  // Modules are not queried until snapshot is requested
+  EXPECT_FALSE(handler_->hasCachedNodeSnapshot());
+
+  // Live snapshot fans out to the modules
+  int64_t liveTimestampMs{0};
+  {
+    auto params = std::make_unique<thrift::NodeSnapshotParams>();
+    params->allowCached() = false;
+    params->counterKeys() = {"fib.num_unicast_routes", "non.existent"};
+    auto snapshot =
+        handler_->semifuture_getNodeSnapshot(std::move(params)).get();
+    EXPECT_EQ(nodeName_, *snapshot->nodeName());
+    EXPECT_EQ(3, snapshot->kvStoreAreaSummaries()->size());
+    EXPECT_EQ(nodeName_, *snapshot->interfaces()->thisNodeName());
+    // Spark is not running in this fixture
+    EXPECT_TRUE(snapshot->neighbors()->empty());
+    EXPECT_GT(*snapshot->snapshotTimestampMs(), 0);
+    EXPECT_EQ(1, snapshot->counters()->size());
+    EXPECT_EQ(1, snapshot->counters()->count("fib.num_unicast_routes"));
+    liveTimestampMs = *snapshot->snapshotTimestampMs();
+  }
+
+  // Cached snapshot is populated by the last collection and served while it
+  // is younger than refresh interval
+  {
+    EXPECT_TRUE(handler_->hasCachedNodeSnapshot());
+    auto snapshot1 = handler_
+                         ->semifuture_getNodeSnapshot(
+                             std::make_unique<thrift::NodeSnapshotParams>())
+                         .get();
+    auto snapshot2 = handler_
+                         ->semifuture_getNodeSnapshot(
+                             std::make_unique<thrift::NodeSnapshotParams>())
+                         .get();
+    EXPECT_EQ(nodeName_, *snapshot1->nodeName());
+    EXPECT_EQ(3, snapshot1->kvStoreAreaSummaries()->size());
+    EXPECT_FALSE(snapshot1->counters()->empty());
+    // Both served from the snapshot collected by live request
+    EXPECT_EQ(liveTimestampMs, *snapshot1->snapshotTimestampMs());
+    EXPECT_EQ(liveTimestampMs, *snapshot2->snapshotTimestampMs());
+  }
+}
+
+TEST_F(OpenrCtrlFixture, MemoryBreakdownApis) {
+  auto breakdown = handler_->semifuture_getMemoryBreakdown().get();
+  // One entry per configured area, even if empty
+  EXPECT_EQ(3, breakdown->kvStoreKeyCount()->size());
+  EXPECT_EQ(3, breakdown->kvStoreKeyValBytes()->size());
+  EXPECT_GE(*breakdown->unicastRouteCount(), 0);
+  EXPECT_GE(*breakdown->mplsRouteCount(), 0);
+  for (auto const& [module, bytes] : *breakdown->moduleAllocatedBytes()) {
+    EXPECT_FALSE(module.empty());
+    EXPECT_GE(bytes, 0);
+  }
+
+  // Module arenas are only available with jemalloc
+  if (not folly::usingJEMalloc()) {
+    return;
+  }
+
+  // Start a named event-base, which binds its thread to a dedicated arena
+  const std::string module{"arena_test"};
+  FLAGS_enable_module_arenas = true;
+  OpenrEventBase evb;
+  evb.setEvbName(module);
+  std::thread evbThread([&]() { evb.run(); });
+  evb.waitUntilRunning();
+
+  auto getModuleBytes = [&]() {
+    auto moduleBytes = *handler_->semifuture_getMemoryBreakdown()
+                            .get()
+                            ->moduleAllocatedBytes();
+    EXPECT_EQ(1, moduleBytes.count(module));
+    return moduleBytes[module];
+  };
+  const auto bytesBefore = getModuleBytes();
+
+  // Allocate from the module thread. Chunks are larger than the thread cache
+  // limit, hence served by the arena right away.
+  const size_t chunkSize{64 * 1024};
+  const size_t numChunks{64};
+  std::vector<std::unique_ptr<char[]>> chunks;
+  evb.getEvb()->runInEventBaseThreadAndWait([&]() {
+    for (size_t i = 0; i < numChunks; ++i) {
+      chunks.emplace_back(std::make_unique<char[]>(chunkSize));
+    }
+  });
+  EXPECT_GE(getModuleBytes(), bytesBefore + chunkSize * numChunks);
+
+  // Memory freed by another thread is returned to the module arena
+  chunks.clear();
+  EXPECT_LT(getModuleBytes(), bytesBefore + chunkSize * numChunks);
+
+  evb.stop();
+  evb.waitUntilStopped();
+  evbThread.join();
+  FLAGS_enable_module_arenas = false;
+}
+
 TEST_F(OpenrCtrlFixture, InitializationApis) {
   // Add KVSTORE_SYNCED event into fb303. Initialization not converged yet.
   logInitializationEvent(
@@ -285,6 +285,67 @@ TEST_F(LongPollFixture, LongPollAdjExpired) {
   ASSERT_TRUE(isAdjChanged);
 }
 
+/*
+ * This UT verifies version based long poll API. Unknown version is answered
+ * immediately; a poll with current version is woken up by "adj:" key change
+ * ONLY, but not by other keys.
+ */
+TEST_F(LongPollFixture, LongPollAdjVersion) {
+  std::chrono::steady_clock::time_point startTime;
+  std::chrono::steady_clock::time_point endTime;
+
+  // first call with version 0 returns immediately with current version
+  startTime = std::chrono::steady_clock::now();
+  const auto v0 = handler_
+                      ->semifuture_longPollKvStoreAdjVersion(
+                          std::make_unique<std::string>(kTestingAreaName), 0)
+                      .get();
+  endTime = std::chrono::steady_clock::now();
+  ASSERT_NE(0, v0);
+  ASSERT_LE(endTime - startTime, std::chrono::milliseconds(50));
+
+  // non-adj key change MUST NOT wake up request, "adj:" key change does
+  testEvb_.scheduleTimeout(std::chrono::milliseconds(500), [&]() noexcept {
+    kvStoreWrapper_->setKey(
+        kTestingAreaName,
+        prefixKey_,
+        createThriftValue(1, nodeName_, std::string("value1")));
+  });
+  testEvb_.scheduleTimeout(std::chrono::milliseconds(1000), [&]() noexcept {
+    startTime = std::chrono::steady_clock::now();
+    kvStoreWrapper_->setKey(
+        kTestingAreaName,
+        adjKey_,
+        createThriftValue(1, nodeName_, std::string("value1")));
+    testEvb_.stop();
+  });
+
+  // start eventloop
+  std::thread evbThread([&]() { testEvb_.run(); });
+  testEvb_.waitUntilRunning();
+
+  const auto v1 = handler_
+                      ->semifuture_longPollKvStoreAdjVersion(
+                          std::make_unique<std::string>(kTestingAreaName), v0)
+                      .get();
+  endTime = std::chrono::steady_clock::now();
+  ASSERT_NE(v0, v1);
+  ASSERT_GE(endTime, startTime);
+  ASSERT_LE(endTime - startTime, std::chrono::milliseconds(250));
+
+  // unknown area is reported as error
+  EXPECT_THROW(
+      handler_
+          ->semifuture_longPollKvStoreAdjVersion(
+              std::make_unique<std::string>("unknown-area"), v1)
+          .get(),
+      thrift::OpenrError);
+
+  // wait for evl before cleanup
+  testEvb_.waitUntilStopped();
+  evbThread.join();
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -8,6 +8,7 @@
 #include <fstream>
 
 #include <fb303/ServiceData.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
 #include <utility>
@@ -20,6 +21,7 @@
 #include <openr/common/Flags.h>
 #include <openr/common/LsdbUtil.h>
 #include <openr/common/NetworkUtil.h>
+#include <openr/common/Tracing.h>
 #include <openr/decision/Decision.h>
 #include <openr/decision/PrefixState.h>
 #include <openr/decision/RibEntry.h>
@@ -95,6 +97,64 @@ DecisionPendingUpdates::addUpdate(
 }
 } // namespace detail
 
+namespace {
+
+// Consistent LSDB snapshot for batch routeDb computation. Adjacency
+// databases are copied instead of LinkState, as the latter shares mutable
+// Link objects with the live one.
+struct RibComputeSnapshot {
+  std::unordered_map<std::string, std::vector<thrift::AdjacencyDatabase>>
+      areaAdjDbs;
+  PrefixState prefixState;
+  StaticUnicastRoutes staticUnicastRoutes;
+};
+
+// Compute routeDb of `nodeNames` from snapshot. Runs on worker thread with
+// its own SpfSolver and LinkStates, as both memoize intermediate results.
+void
+computeRouteDbs(
+    std::shared_ptr<const Config> config,
+    std::shared_ptr<const RibComputeSnapshot> snapshot,
+    std::vector<std::string> const& nodeNames,
+    folly::Synchronized<folly::Function<void(thrift::RouteDatabase&&)>>&
+        onRouteDb) {
+  SpfSolver spfSolver(
+      config->getNodeName(),
+      config->isV4Enabled(),
+      config->isSegmentRoutingEnabled(),
+      config->isAdjacencyLabelsEnabled(),
+      config->isBestRouteSelectionEnabled(),
+      config->isV4OverV6NexthopEnabled());
+  spfSolver.updateStaticUnicastRoutes(snapshot->staticUnicastRoutes, {});
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  for (auto const& [area, adjDbs] : snapshot->areaAdjDbs) {
+    auto& linkState = areaLinkStates.emplace(area, area).first->second;
+    for (auto const& adjDb : adjDbs) {
+      linkState.updateAdjacencyDatabase(adjDb, area);
+    }
+  }
+
+  for (auto const& nodeName : nodeNames) {
+    thrift::RouteDatabase routeDb;
+    auto maybeRouteDb =
+        spfSolver.buildRouteDb(nodeName, areaLinkStates, snapshot->prefixState);
+    if (maybeRouteDb.has_value()) {
+      routeDb = maybeRouteDb->toThrift();
+    }
+    *routeDb.thisNodeName() = nodeName;
+    onRouteDb.withWLock([&routeDb](auto& fn) { fn(std::move(routeDb)); });
+
+    // SPF results are rooted at `nodeName` and rarely reused by other nodes.
+    // Keeping them for thousands of nodes grows memory quadratically.
+    for (auto const& [_, linkState] : areaLinkStates) {
+      linkState.clearSpfMemoization();
+    }
+  }
+}
+
+} // namespace
+
 //
 // Decision class implementation
 //
@@ -134,6 +194,10 @@ Decision::Decision(
       config->isBestRouteSelectionEnabled(),
       config->isV4OverV6NexthopEnabled());
 
+  ribComputeExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+      std::max<uint32_t>(1, FLAGS_decision_rib_compute_threads),
+      std::make_shared<folly::NamedThreadFactory>("DecisionRib"));
+
   if (config->isVipServiceEnabled()) {
     // Static unicast routes will be generated by PrefixManager for received
     // VIPs.
@@ -270,6 +334,9 @@ Decision::stop() {
   // Post initialPeersReceivedBaton_ to unblock internal fiber from stopping.
   initialPeersReceivedBaton_.post();
 
+  // Wait for in-flight batch routeDb computation
+  ribComputeExecutor_->join();
+
   // Invoke stop method of super class
   OpenrEventBase::stop();
   XLOG(DBG1) << "Stopped Decision event base";
@@ -297,6 +364,78 @@ Decision::getDecisionRouteDb(std::string nodeName) {
   return sf;
 }
 
+folly::SemiFuture<folly::Unit>
+Decision::getDecisionRouteDbs(
+    std::vector<std::string> nodeNames,
+    folly::Function<void(thrift::RouteDatabase&&)> onRouteDb) {
+  folly::Promise<folly::Unit> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([p = std::move(p),
+                        nodeNames = std::move(nodeNames),
+                        onRouteDb = std::move(onRouteDb),
+                        this]() mutable {
+    // Take LSDB snapshot, the only step on Decision thread
+    auto snapshot = std::make_shared<RibComputeSnapshot>();
+    std::set<std::string> allNodeNames;
+    for (auto const& [area, linkState] : areaLinkStates_) {
+      auto& adjDbs = snapshot->areaAdjDbs[area];
+      for (auto const& [nodeName, adjDb] : linkState.getAdjacencyDatabases()) {
+        adjDbs.emplace_back(adjDb);
+        allNodeNames.emplace(nodeName);
+      }
+    }
+    snapshot->prefixState = prefixState_;
+    snapshot->staticUnicastRoutes = spfSolver_->getStaticUnicastRoutes();
+    if (nodeNames.empty()) {
+      nodeNames.assign(allNodeNames.begin(), allNodeNames.end());
+    }
+
+    // Spread nodes across workers. Each worker rebuilds LinkStates once and
+    // computes routeDbs of its nodes sequentially.
+    const auto numWorkers = std::min<size_t>(
+        ribComputeExecutor_->numThreads(), nodeNames.size());
+    if (numWorkers == 0) {
+      p.setValue();
+      return;
+    }
+    std::vector<std::vector<std::string>> workerNodeNames(numWorkers);
+    for (size_t i = 0; i < nodeNames.size(); ++i) {
+      workerNodeNames.at(i % numWorkers).emplace_back(std::move(nodeNames[i]));
+    }
+
+    XLOG(INFO) << fmt::format(
+        "Computing routeDbs of {} nodes with {} workers",
+        nodeNames.size(),
+        numWorkers);
+    auto syncOnRouteDb = std::make_shared<
+        folly::Synchronized<folly::Function<void(thrift::RouteDatabase&&)>>>(
+        std::move(onRouteDb));
+    std::vector<folly::SemiFuture<folly::Unit>> futures;
+    for (auto& names : workerNodeNames) {
+      futures.emplace_back(folly::via(
+          ribComputeExecutor_.get(),
+          [config = config_,
+           snapshot,
+           syncOnRouteDb,
+           names = std::move(names)]() {
+            computeRouteDbs(config, snapshot, names, *syncOnRouteDb);
+          }));
+    }
+    folly::collectAll(std::move(futures))
+        .via(ribComputeExecutor_.get())
+        .thenValue([p = std::move(p)](auto&& results) mutable {
+          for (auto& result : results) {
+            if (result.hasException()) {
+              p.setException(std::move(result.exception()));
+              return;
+            }
+          }
+          p.setValue();
+        });
+  });
+  return sf;
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdjacencyDatabase>>>
 Decision::getDecisionAdjacenciesFiltered(thrift::AdjacenciesFilter filter) {
   folly::Promise<std::unique_ptr<std::vector<thrift::AdjacencyDatabase>>> p;
@@ -352,24 +491,7 @@ Decision::getReceivedRoutesFiltered(thrift::ReceivedRouteFilter filter) {
           auto routes = prefixState_.getReceivedRoutesFiltered(filter);
 
           // Add best path result to this
-          auto const& bestRoutesCache = spfSolver_->getBestRoutesCache();
-          for (auto& route : routes) {
-            auto const& bestRoutesIt =
-                bestRoutesCache.find(toIPNetwork(*route.prefix()));
-            if (bestRoutesIt != bestRoutesCache.end()) {
-              auto const& bestRoutes = bestRoutesIt->second;
-              // Set all selected node-area
-              for (auto const& [node, area] : bestRoutes.allNodeAreas) {
-                route.bestKeys()->emplace_back();
-                auto& key = route.bestKeys()->back();
-                key.node() = node;
-                key.area() = area;
-              }
-              // Set best node-area
-              route.bestKey()->node() = bestRoutes.bestNodeArea.first;
-              route.bestKey()->area() = bestRoutes.bestNodeArea.second;
-            }
-          }
+          addBestRouteKeys(routes);
 
           // Set the promise
           p.setValue(std::make_unique<std::vector<thrift::ReceivedRouteDetail>>(
@@ -381,6 +503,56 @@ Decision::getReceivedRoutesFiltered(thrift::ReceivedRouteFilter filter) {
   return std::move(sf);
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+Decision::getReceivedRoutesFilteredPage(
+    thrift::ReceivedRouteFilter filter, thrift::PageParams pageParams) {
+  auto [p, sf] =
+      folly::makePromiseContract<std::unique_ptr<thrift::ReceivedRoutesPage>>();
+  runInEventBaseThread([this,
+                        p = std::move(p),
+                        filter = std::move(filter),
+                        pageParams = std::move(pageParams)]() mutable noexcept {
+    try {
+      auto page = std::make_unique<thrift::ReceivedRoutesPage>();
+      auto nextCursor = prefixState_.getReceivedRoutesFilteredPage(
+          filter, pageParams, *page->routes());
+      if (nextCursor.has_value()) {
+        page->nextCursor() = std::move(*nextCursor);
+      }
+      addBestRouteKeys(*page->routes());
+      p.setValue(std::move(page));
+    } catch (std::invalid_argument const& e) {
+      thrift::OpenrError error;
+      error.message() = e.what();
+      p.setException(error);
+    }
+  });
+  return std::move(sf);
+}
+
+void
+Decision::addBestRouteKeys(
+    std::vector<thrift::ReceivedRouteDetail>& routes) const {
+  auto const& bestRoutesCache = spfSolver_->getBestRoutesCache();
+  for (auto& route : routes) {
+    auto const& bestRoutesIt =
+        bestRoutesCache.find(toIPNetwork(*route.prefix()));
+    if (bestRoutesIt != bestRoutesCache.end()) {
+      auto const& bestRoutes = bestRoutesIt->second;
+      // Set all selected node-area
+      for (auto const& [node, area] : bestRoutes.allNodeAreas) {
+        route.bestKeys()->emplace_back();
+        auto& key = route.bestKeys()->back();
+        key.node() = node;
+        key.area() = area;
+      }
+      // Set best node-area
+      route.bestKey()->node() = bestRoutes.bestNodeArea.first;
+      route.bestKey()->area() = bestRoutes.bestNodeArea.second;
+    }
+  }
+}
+
 folly::SemiFuture<folly::Unit>
 Decision::clearRibPolicy() {
   auto [p, sf] = folly::makePromiseContract<folly::Unit>();
@@ -730,6 +902,17 @@ Decision::updateKeyInLsdb(
       auto prefixDb = readThriftObjStr<thrift::PrefixDatabase>(
           rawVal.value().value(), serializer_);
 
+      // Bulk prefix database shard carrying many prefixes
+      if (auto maybeShardKey = PrefixShardKey::fromStr(key);
+          maybeShardKey.hasValue()) {
+        if (*prefixDb.deletePrefix()) {
+          deletePrefixDbShard(area, *maybeShardKey, prefixDb.perfEvents());
+        } else {
+          updatePrefixDbShard(area, *maybeShardKey, prefixDb);
+        }
+        return;
+      }
+
       // We expect per prefix key, ignore if publication is still in old
       // format.
       if (1 != prefixDb.prefixEntries()->size()) {
@@ -757,11 +940,28 @@ Decision::updateKeyInLsdb(
       PrefixKey prefixKey(
           *prefixDb.thisNodeName(), toIPNetwork(*entry.prefix()), area);
 
+      if (*prefixDb.deletePrefix()) {
+        // Prefix may still be carried by prefix database shard. Ignore
+        // withdrawal of the per-prefix key during migration.
+        if (not removePrefixSource(
+                area,
+                prefixKey.getNodeName(),
+                prefixKey.getCIDRNetwork(),
+                std::nullopt)) {
+          return;
+        }
+        pendingUpdates_.applyPrefixStateChange(
+            prefixState_.deletePrefix(prefixKey), prefixDb.perfEvents());
+        return;
+      }
+
+      addPrefixSource(
+          area,
+          prefixKey.getNodeName(),
+          prefixKey.getCIDRNetwork(),
+          std::nullopt);
       pendingUpdates_.applyPrefixStateChange(
-          *prefixDb.deletePrefix()
-              ? prefixState_.deletePrefix(prefixKey)
-              : prefixState_.updatePrefix(prefixKey, entry),
-          prefixDb.perfEvents());
+          prefixState_.updatePrefix(prefixKey, entry), prefixDb.perfEvents());
     }
   } catch (const std::exception& e) {
     XLOG(ERR) << "Failed to deserialize info for key " << key
@@ -788,6 +988,15 @@ Decision::deleteKeyFromLsdb(
 
   if (key.find(Constants::kPrefixDbMarker.toString()) == 0) {
     // prefixDb: delete keys starting with "prefix:"
+    if (auto maybeShardKey = PrefixShardKey::fromStr(key);
+        maybeShardKey.hasValue()) {
+      deletePrefixDbShard(
+          area,
+          *maybeShardKey,
+          thrift::PrefixDatabase().perfEvents()); // Empty perf events
+      return;
+    }
+
     auto maybePrefixKey = PrefixKey::fromStr(key, area);
     if (maybePrefixKey.hasError()) {
       // this is bad format of key.
@@ -797,12 +1006,195 @@ Decision::deleteKeyFromLsdb(
           maybePrefixKey.error());
       return;
     }
+    if (not removePrefixSource(
+            area,
+            maybePrefixKey->getNodeName(),
+            maybePrefixKey->getCIDRNetwork(),
+            std::nullopt)) {
+      return;
+    }
     pendingUpdates_.applyPrefixStateChange(
         prefixState_.deletePrefix(maybePrefixKey.value()),
         thrift::PrefixDatabase().perfEvents()); // Empty perf events
   }
 }
 
+void
+Decision::updatePrefixDbShard(
+    const std::string& area,
+    const PrefixShardKey& shardKey,
+    const thrift::PrefixDatabase& prefixDb) {
+  const auto& nodeName = shardKey.getNodeName();
+  const auto shardId = shardKey.getShardId();
+  std::unordered_set<folly::CIDRNetwork> changed;
+  std::unordered_set<folly::CIDRNetwork> shardPrefixes;
+
+  for (const auto& entry : *prefixDb.prefixEntries()) {
+    auto const& areaStack = *entry.area_stack();
+
+    // Ignore self redistributed route reflection
+    if (nodeName == myNodeName_ && areaStack.size() > 0 &&
+        areaLinkStates_.count(areaStack.back())) {
+      continue;
+    }
+
+    const auto network = toIPNetwork(*entry.prefix());
+    shardPrefixes.emplace(network);
+    addPrefixSource(area, nodeName, network, shardId);
+    changed.merge(
+        prefixState_.updatePrefix(PrefixKey(nodeName, network, area), entry));
+  }
+
+  // Withdraw prefixes which are no longer inside the shard
+  auto& nodeShards = prefixDbShards_[area][nodeName];
+  auto shardIt = nodeShards.find(shardId);
+  if (shardIt != nodeShards.end()) {
+    for (const auto& network : shardIt->second) {
+      if (shardPrefixes.count(network) or
+          not removePrefixSource(area, nodeName, network, shardId)) {
+        continue;
+      }
+      changed.merge(
+          prefixState_.deletePrefix(PrefixKey(nodeName, network, area)));
+    }
+  }
+
+  if (shardPrefixes.empty()) {
+    nodeShards.erase(shardId);
+    if (nodeShards.empty()) {
+      prefixDbShards_[area].erase(nodeName);
+      clearPrefixSources(area, nodeName);
+    }
+  } else {
+    nodeShards.insert_or_assign(shardId, std::move(shardPrefixes));
+  }
+
+  pendingUpdates_.applyPrefixStateChange(
+      std::move(changed), prefixDb.perfEvents());
+}
+
+void
+Decision::deletePrefixDbShard(
+    const std::string& area,
+    const PrefixShardKey& shardKey,
+    apache::thrift::optional_field_ref<thrift::PerfEvents const&> perfEvents) {
+  auto areaIt = prefixDbShards_.find(area);
+  if (areaIt == prefixDbShards_.end()) {
+    return;
+  }
+  auto nodeIt = areaIt->second.find(shardKey.getNodeName());
+  if (nodeIt == areaIt->second.end()) {
+    return;
+  }
+  auto shardIt = nodeIt->second.find(shardKey.getShardId());
+  if (shardIt == nodeIt->second.end()) {
+    return;
+  }
+
+  auto shardPrefixes = std::move(shardIt->second);
+  nodeIt->second.erase(shardIt);
+
+  std::unordered_set<folly::CIDRNetwork> changed;
+  for (const auto& network : shardPrefixes) {
+    if (not removePrefixSource(
+            area, shardKey.getNodeName(), network, shardKey.getShardId())) {
+      continue;
+    }
+    changed.merge(prefixState_.deletePrefix(
+        PrefixKey(shardKey.getNodeName(), network, area)));
+  }
+
+  // clean up data structures
+  if (nodeIt->second.empty()) {
+    areaIt->second.erase(nodeIt);
+    clearPrefixSources(area, shardKey.getNodeName());
+  }
+  pendingUpdates_.applyPrefixStateChange(std::move(changed), perfEvents);
+}
+
+void
+Decision::addPrefixSource(
+    const std::string& area,
+    const std::string& nodeName,
+    const folly::CIDRNetwork& prefix,
+    std::optional<uint32_t> shardId) {
+  if (not shardId.has_value()) {
+    // Per-prefix key is the only source of nodes without prefix database
+    // shards, no need to track it
+    auto areaIt = prefixDbShards_.find(area);
+    if (areaIt == prefixDbShards_.end() or
+        areaIt->second.count(nodeName) == 0) {
+      return;
+    }
+    prefixSources_[area][nodeName][prefix].perPrefixKey = true;
+    return;
+  }
+
+  auto [it, inserted] = prefixSources_[area][nodeName].try_emplace(prefix);
+  if (inserted) {
+    // Prefix known from this node but not tracked yet was advertised with
+    // per-prefix key before the node started advertising shards
+    const auto& prefixes = prefixState_.prefixes();
+    auto prefixIt = prefixes.find(prefix);
+    it->second.perPrefixKey = prefixIt != prefixes.end() and
+        prefixIt->second.count({nodeName, area}) != 0;
+  }
+  it->second.shardIds.emplace(*shardId);
+}
+
+void
+Decision::clearPrefixSources(
+    const std::string& area, const std::string& nodeName) {
+  auto areaIt = prefixSources_.find(area);
+  if (areaIt == prefixSources_.end()) {
+    return;
+  }
+  areaIt->second.erase(nodeName);
+  if (areaIt->second.empty()) {
+    prefixSources_.erase(areaIt);
+  }
+}
+
+bool
+Decision::removePrefixSource(
+    const std::string& area,
+    const std::string& nodeName,
+    const folly::CIDRNetwork& prefix,
+    std::optional<uint32_t> shardId) {
+  auto areaIt = prefixSources_.find(area);
+  if (areaIt == prefixSources_.end()) {
+    return true;
+  }
+  auto nodeIt = areaIt->second.find(nodeName);
+  if (nodeIt == areaIt->second.end()) {
+    return true;
+  }
+  auto prefixIt = nodeIt->second.find(prefix);
+  if (prefixIt == nodeIt->second.end()) {
+    return true;
+  }
+
+  auto& sources = prefixIt->second;
+  if (shardId.has_value()) {
+    sources.shardIds.erase(*shardId);
+  } else {
+    sources.perPrefixKey = false;
+  }
+  if (sources.perPrefixKey or not sources.shardIds.empty()) {
+    return false;
+  }
+
+  // last source is gone, clean up data structures
+  nodeIt->second.erase(prefixIt);
+  if (nodeIt->second.empty()) {
+    areaIt->second.erase(nodeIt);
+    if (areaIt->second.empty()) {
+      prefixSources_.erase(areaIt);
+    }
+  }
+  return true;
+}
+
 void
 Decision::processPublication(thrift::Publication&& thriftPub) {
   CHECK(not thriftPub.area()->empty());
@@ -878,6 +1270,11 @@ Decision::rebuildRoutes(std::string const& event) {
   }
 
   pendingUpdates_.addEvent(event);
+  ScopedTraceSpan span(
+      pendingUpdates_.perfEvents()
+          ? pendingUpdates_.perfEvents()->traceId().value_or(0)
+          : 0,
+      "decision.rebuild_routes");
   XLOG(INFO) << "Decision: processing " << pendingUpdates_.getCount()
              << " accumulated updates. " << event;
   if (pendingUpdates_.perfEvents()) {
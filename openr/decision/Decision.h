@@ -8,6 +8,7 @@
 #pragma once
 
 #include <folly/IPAddress.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
@@ -154,6 +155,17 @@ class Decision : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>> getDecisionRouteDb(
       std::string nodeName);
 
+  /*
+   * Batch version of getDecisionRouteDb() for controllers. Compute routeDb of
+   * each node in `nodeNames` (all known nodes if empty) from one consistent
+   * LSDB snapshot taken on Decision thread. Computation runs in parallel on
+   * worker pool and `onRouteDb` is called, never concurrently, as soon as
+   * each routeDb is ready. Returned future completes after the last one.
+   */
+  folly::SemiFuture<folly::Unit> getDecisionRouteDbs(
+      std::vector<std::string> nodeNames,
+      folly::Function<void(thrift::RouteDatabase&&)> onRouteDb);
+
   /*
    * Retrieve AdjacencyDatabase for all nodes in all areas.
    * DEPRECATED. Perfer getDecisionAreaAdjacenciesFiltered to return the areas
@@ -175,6 +187,13 @@ class Decision : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::ReceivedRouteDetail>>>
   getReceivedRoutesFiltered(thrift::ReceivedRouteFilter filter);
 
+  /*
+   * Paginated version of getReceivedRoutesFiltered().
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+  getReceivedRoutesFilteredPage(
+      thrift::ReceivedRouteFilter filter, thrift::PageParams pageParams);
+
   /*
    * Set new or replace existing RibPolicy. This will trigger the new policy
    * run against computed routes and delta will be published.
@@ -209,6 +228,9 @@ class Decision : public OpenrEventBase {
   // Process peer updates
   void processPeerUpdates(PeerEvent&& event);
 
+  // Annotate received routes with result of best route selection
+  void addBestRouteKeys(std::vector<thrift::ReceivedRouteDetail>& routes) const;
+
   /*
    * [Link-State Database(LSDB) Management]
    *
@@ -233,6 +255,45 @@ class Decision : public OpenrEventBase {
       LinkState& areaLinkState,
       const std::string& key);
 
+  /*
+   * [Sharded Prefix Database]
+   *
+   * Process update/deletion of bulk prefix database shard, i.e. key
+   * `prefix:<node>:<shard>` carrying many prefix entries. Prefixes no longer
+   * inside the shard are withdrawn unless still advertised by another shard
+   * or by a per-prefix key.
+   */
+  void updatePrefixDbShard(
+      const std::string& area,
+      const PrefixShardKey& shardKey,
+      const thrift::PrefixDatabase& prefixDb);
+
+  void deletePrefixDbShard(
+      const std::string& area,
+      const PrefixShardKey& shardKey,
+      apache::thrift::optional_field_ref<thrift::PerfEvents const&> perfEvents);
+
+  // Record prefix of given node and area as advertised by the given prefix
+  // database shard, or by its per-prefix key if shardId is std::nullopt.
+  // Per-prefix key is only recorded if the node advertises shards in area.
+  void addPrefixSource(
+      const std::string& area,
+      const std::string& nodeName,
+      const folly::CIDRNetwork& prefix,
+      std::optional<uint32_t> shardId);
+
+  // Remove the given advertising source of the prefix. Return true if no
+  // other source is left, i.e. the prefix must be withdrawn.
+  bool removePrefixSource(
+      const std::string& area,
+      const std::string& nodeName,
+      const folly::CIDRNetwork& prefix,
+      std::optional<uint32_t> shardId);
+
+  // Stop tracking sources of the node once it has no shard left in area.
+  // Only per-prefix key sources can be left over.
+  void clearPrefixSources(const std::string& area, const std::string& nodeName);
+
   // Process publication from PrefixManager
   void processStaticRoutesUpdate(DecisionRouteUpdate&& routeUpdate);
 
@@ -294,12 +355,44 @@ class Decision : public OpenrEventBase {
   // The pointer to the SPF path calculator
   std::unique_ptr<SpfSolver> spfSolver_;
 
+  // Worker pool for batch routeDb computation, see getDecisionRouteDbs()
+  std::unique_ptr<folly::CPUThreadPoolExecutor> ribComputeExecutor_;
+
   // Per area link states
   std::unordered_map<std::string, LinkState> areaLinkStates_;
 
   // Global prefix state
   PrefixState prefixState_;
 
+  // Prefixes carried by bulk prefix database shards
+  // area -> node -> shardId -> prefixes
+  std::unordered_map<
+      std::string,
+      std::unordered_map<
+          std::string,
+          std::unordered_map<uint32_t, std::unordered_set<folly::CIDRNetwork>>>>
+      prefixDbShards_;
+
+  // Sources advertising the same prefix of one node. Per-prefix key and
+  // shards co-exist during migration and all write the same PrefixKey.
+  // Only tracked for nodes advertising shards in the area, prefix of other
+  // nodes is withdrawn along with its per-prefix key.
+  struct PrefixSources {
+    // ids of prefix database shards carrying the prefix
+    std::unordered_set<uint32_t> shardIds;
+
+    // true if prefix is advertised with per-prefix key
+    bool perPrefixKey{false};
+  };
+
+  // area -> node -> prefix -> advertising sources
+  std::unordered_map<
+      std::string,
+      std::unordered_map<
+          std::string,
+          std::unordered_map<folly::CIDRNetwork, PrefixSources>>>
+      prefixSources_;
+
   apache::thrift::CompactSerializer serializer_;
 
   // Base interval to submit to monitor with (jitter will be added)
@@ -832,6 +832,12 @@ LinkState::getSpfResult(
   return entryIter->second;
 }
 
+void
+LinkState::clearSpfMemoization() const {
+  spfResults_.clear();
+  kthPathResults_.clear();
+}
+
 /**
  * Compute shortest-path routes from perspective of nodeName;
  */
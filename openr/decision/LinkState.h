@@ -343,6 +343,11 @@ class LinkState {
   SpfResult const& getSpfResult(
       const std::string& nodeName, bool useLinkMetric = true) const;
 
+  // Drop memoized shortest paths results to bound memory, e.g. after
+  // computing routes from perspective of many different nodes. Topology is
+  // not affected.
+  void clearSpfMemoization() const;
+
   // API to resolve UCMP weights for all node's on the shortest path
   // between a root node and a list of weighted leaf nodes.
   UcmpResult resolveUcmpWeights(
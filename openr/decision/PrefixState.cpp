@@ -8,6 +8,7 @@
 #include <folly/logging/xlog.h>
 
 #include <openr/common/LsdbUtil.h>
+#include <openr/common/Util.h>
 #include <openr/decision/PrefixState.h>
 
 namespace openr {
@@ -79,6 +80,37 @@ PrefixState::getReceivedRoutesFiltered(
   return routes;
 }
 
+std::optional<thrift::PageCursor>
+PrefixState::getReceivedRoutesFilteredPage(
+    thrift::ReceivedRouteFilter const& filter,
+    thrift::PageParams const& pageParams,
+    std::vector<thrift::ReceivedRouteDetail>& routes) const {
+  if (*pageParams.limit() <= 0) {
+    throw std::invalid_argument("Page limit must be positive");
+  }
+  if (filter.prefixes()) {
+    routes = getReceivedRoutesFiltered(filter);
+    return std::nullopt;
+  }
+
+  size_t budget = *pageParams.limit();
+  return visitPage(
+      prefixes_,
+      pageParams.cursor().value_or(thrift::PageCursor()),
+      budget,
+      [&](folly::CIDRNetwork const& prefix,
+          PrefixEntries const& prefixEntries) {
+        const auto numRoutes = routes.size();
+        filterAndAddReceivedRoute(
+            routes,
+            filter.nodeName(),
+            filter.areaName(),
+            prefix,
+            prefixEntries);
+        return routes.size() > numRoutes;
+      });
+}
+
 void
 PrefixState::filterAndAddReceivedRoute(
     std::vector<thrift::ReceivedRouteDetail>& routes,
@@ -34,6 +34,14 @@ class PrefixState {
   std::vector<thrift::ReceivedRouteDetail> getReceivedRoutesFiltered(
       thrift::ReceivedRouteFilter const& filter) const;
 
+  // Paginated version of getReceivedRoutesFiltered(). Append routes of one
+  // page to `routes` and return the cursor to continue from, if any.
+  // Explicitly requested prefixes are always returned in a single page.
+  std::optional<thrift::PageCursor> getReceivedRoutesFilteredPage(
+      thrift::ReceivedRouteFilter const& filter,
+      thrift::PageParams const& pageParams,
+      std::vector<thrift::ReceivedRouteDetail>& routes) const;
+
   /**
    * Filter routes only the <type> attribute
    */
@@ -144,6 +144,11 @@ class SpfSolver {
       PrefixState const& prefixState,
       folly::CIDRNetwork const& prefix);
 
+  StaticUnicastRoutes const&
+  getStaticUnicastRoutes() const {
+    return staticUnicastRoutes_;
+  }
+
   std::unordered_map<folly::CIDRNetwork, RouteSelectionResult> const&
   getBestRoutesCache() const {
     return bestRoutesCache_;
@@ -4310,6 +4310,75 @@ TEST_F(DecisionTestFixture, BasicOperations) {
   EXPECT_TRUE(checkEqualRoutesDelta(routeDbDelta, routeDelta));
 }
 
+/**
+ * Verify getDecisionRouteDbs() computes route databases of all or selected
+ * nodes in batch, identical to the ones computed one node at a time. Unknown
+ * nodes get an empty route database.
+ */
+TEST_F(DecisionTestFixture, BatchRouteDbComputation) {
+  // 1 - 2 - 3, and 4 without adjacencies
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21, adj23}, false, 2)},
+       {"adj:3", createAdjValue(serializer, "3", 1, {adj32}, false, 3)},
+       {"adj:4", createAdjValue(serializer, "4", 1, {}, false, 4)},
+       createPrefixKeyValue("1", 1, addr1),
+       createPrefixKeyValue("2", 1, addr2),
+       createPrefixKeyValue("3", 1, addr3)},
+      {},
+      {},
+      {});
+  sendKvPublication(publication);
+  recvRouteUpdates();
+
+  auto sortRouteDb = [](thrift::RouteDatabase& routeDb) {
+    for (auto& route : *routeDb.unicastRoutes()) {
+      std::sort(route.nextHops()->begin(), route.nextHops()->end());
+    }
+    for (auto& route : *routeDb.mplsRoutes()) {
+      std::sort(route.nextHops()->begin(), route.nextHops()->end());
+    }
+    std::sort(routeDb.unicastRoutes()->begin(), routeDb.unicastRoutes()->end());
+    std::sort(routeDb.mplsRoutes()->begin(), routeDb.mplsRoutes()->end());
+  };
+  auto getRouteDbs = [&](std::vector<std::string> nodeNames) {
+    std::unordered_map<std::string, thrift::RouteDatabase> routeDbs;
+    decision
+        ->getDecisionRouteDbs(
+            std::move(nodeNames),
+            [&](thrift::RouteDatabase&& routeDb) {
+              sortRouteDb(routeDb);
+              auto nodeName = *routeDb.thisNodeName();
+              EXPECT_TRUE(
+                  routeDbs.emplace(nodeName, std::move(routeDb)).second);
+            })
+        .get();
+    return routeDbs;
+  };
+
+  // All nodes: identical to routeDb computed one node at a time
+  {
+    auto routeDbs = getRouteDbs({});
+    auto expectedRouteDbs = dumpRouteDb({"1", "2", "3", "4"});
+    ASSERT_EQ(4, routeDbs.size());
+    for (auto& [node, expectedRouteDb] : expectedRouteDbs) {
+      sortRouteDb(expectedRouteDb);
+      EXPECT_EQ(expectedRouteDb, routeDbs.at(node));
+    }
+    EXPECT_EQ(2, routeDbs.at("1").unicastRoutes()->size());
+    EXPECT_EQ(2, routeDbs.at("2").unicastRoutes()->size());
+  }
+
+  // Selected nodes, unknown node gets empty routeDb
+  {
+    auto routeDbs = getRouteDbs({"3", "5"});
+    ASSERT_EQ(2, routeDbs.size());
+    EXPECT_EQ(2, routeDbs.at("3").unicastRoutes()->size());
+    EXPECT_TRUE(routeDbs.at("5").unicastRoutes()->empty());
+    EXPECT_TRUE(routeDbs.at("5").mplsRoutes()->empty());
+  }
+}
+
 /**
  * Publish all types of update to Decision and expect that Decision emits
  * a full route database that includes all the routes as its first update.
@@ -5690,6 +5759,152 @@ TEST_F(DecisionTestFixture, NoSpfOnDuplicatePublication) {
  *     |
  *  node3(p2)
  */
+/*
+ * Verify Decision processes bulk prefix database shard, i.e. key of format
+ * `prefix:<node>:<shard>` carrying many prefix entries, together with
+ * per-prefix keys during migration.
+ */
+TEST_F(DecisionTestFixture, PrefixDbShard) {
+  const auto shardKey = PrefixShardKey("2", 0).getPrefixShardKey();
+  auto createShardValue = [&](int64_t version,
+                              const std::vector<thrift::IpPrefix>& prefixes) {
+    std::vector<thrift::PrefixEntry> prefixEntries;
+    for (const auto& prefix : prefixes) {
+      prefixEntries.emplace_back(createPrefixEntry(prefix));
+    }
+    return createThriftValue(
+        version,
+        "2",
+        writeThriftObjStr(createPrefixDb("2", prefixEntries), serializer));
+  };
+
+  // Step1: node-2 advertises addr2 with per-prefix key
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+       createPrefixKeyValue("2", 1, addr2)},
+      {},
+      {},
+      {});
+  sendKvPublication(publication);
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  // Step2: node-2 migrates to sharded prefix database. Withdrawal of the
+  // per-prefix key is ignored since addr2 is carried by the shard.
+  publication = createThriftPublication(
+      {{shardKey, createShardValue(1, {addr2, addr3})},
+       createPrefixKeyValue("2", 2, addr2, kTestingAreaName, true)},
+      {},
+      {},
+      {});
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(
+      1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  // Step3: addr2 is removed from the shard
+  publication = createThriftPublication(
+      {{shardKey, createShardValue(2, {addr3})}}, {}, {}, {});
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr2), routeDbDelta.unicastRoutesToDelete.front());
+
+  // Step4: shard key expires, withdraw all its prefixes
+  publication = createThriftPublication({}, {shardKey}, {}, {});
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr3), routeDbDelta.unicastRoutesToDelete.front());
+}
+
+/*
+ * Verify prefix advertised by both per-prefix key and prefix database shard
+ * is only withdrawn once both of them are gone, regardless of the order.
+ */
+TEST_F(DecisionTestFixture, PrefixDbShardWithPerPrefixKey) {
+  const auto shardKey = PrefixShardKey("2", 0).getPrefixShardKey();
+  auto createShardValue = [&](int64_t version,
+                              const std::vector<thrift::IpPrefix>& prefixes) {
+    std::vector<thrift::PrefixEntry> prefixEntries;
+    for (const auto& prefix : prefixes) {
+      prefixEntries.emplace_back(createPrefixEntry(prefix));
+    }
+    return createThriftValue(
+        version,
+        "2",
+        writeThriftObjStr(createPrefixDb("2", prefixEntries), serializer));
+  };
+
+  // Step1: node-2 advertises addr2 with both per-prefix key and shard
+  auto publication = createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+       createPrefixKeyValue("2", 1, addr2),
+       {shardKey, createShardValue(1, {addr2, addr3})}},
+      {},
+      {},
+      {});
+  sendKvPublication(publication);
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  // Step2: shard key expires. addr2 is still advertised by per-prefix key,
+  // only addr3 is withdrawn.
+  publication = createThriftPublication({}, {shardKey}, {}, {});
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr3), routeDbDelta.unicastRoutesToDelete.front());
+  EXPECT_EQ(1, dumpRouteDb({"1"})["1"].unicastRoutes()->size());
+
+  // Step3: node-2 re-advertises the shard and withdraws it with tombstone.
+  // addr2 is still advertised by per-prefix key.
+  publication = createThriftPublication(
+      {{shardKey, createShardValue(2, {addr2, addr3})}}, {}, {}, {});
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(
+      1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  auto tombstone =
+      createPrefixDb("2", {createPrefixEntry(addr2), createPrefixEntry(addr3)});
+  tombstone.deletePrefix() = true;
+  publication = createThriftPublication(
+      {{shardKey,
+        createThriftValue(3, "2", writeThriftObjStr(tombstone, serializer))}},
+      {},
+      {},
+      {});
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr3), routeDbDelta.unicastRoutesToDelete.front());
+
+  // Step4: per-prefix key is withdrawn as well, addr2 is gone
+  publication = createThriftPublication(
+      {createPrefixKeyValue("2", 2, addr2, kTestingAreaName, true)},
+      {},
+      {},
+      {});
+  sendKvPublication(publication);
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(addr2), routeDbDelta.unicastRoutesToDelete.front());
+}
+
 TEST_F(DecisionTestFixture, DuplicatePrefixes) {
   // Note: local copy overwriting global ones, to be changed in this test
   auto adj14 =
@@ -5872,6 +6087,57 @@ TEST_F(DecisionTestFixture, DuplicatePrefixes) {
       NextHops({createNextHopFromAdj(adj41, false, 15)}));
 }
 
+/**
+ * Verify `getReceivedRoutesFilteredPage` returns every received route of the
+ * filtered node exactly once across pages, annotated with best route keys.
+ */
+TEST_F(DecisionTestFixture, GetReceivedRoutesPaginated) {
+  const size_t kNumPrefixes{30};
+  const size_t kPageLimit{7};
+  // Routes sharing a hash bucket are never split across pages
+  const size_t kMaxPageOverflow{7};
+
+  thrift::KeyVals keyVals{
+      {"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+      {"adj:2", createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+      createPrefixKeyValue("1", 1, addr1)};
+  for (size_t i = 0; i < kNumPrefixes; ++i) {
+    keyVals.emplace(createPrefixKeyValue(
+        "2", 1, toIpPrefix(fmt::format("fd00:2::{}/128", i + 1))));
+  }
+  sendKvPublication(createThriftPublication(keyVals, {}, {}, {}));
+  recvRouteUpdates();
+
+  thrift::ReceivedRouteFilter filter;
+  filter.nodeName() = "2";
+  thrift::PageParams pageParams;
+  pageParams.limit() = kPageLimit;
+  std::unordered_set<thrift::IpPrefix> prefixes;
+  while (true) {
+    auto page =
+        decision->getReceivedRoutesFilteredPage(filter, pageParams).get();
+    EXPECT_LE(page->routes()->size(), kPageLimit + kMaxPageOverflow);
+    for (auto const& routeDetail : *page->routes()) {
+      EXPECT_TRUE(prefixes.insert(*routeDetail.prefix()).second);
+      EXPECT_EQ("2", *routeDetail.bestKey()->node());
+      ASSERT_EQ(1, routeDetail.routes()->size());
+    }
+    if (not page->nextCursor().has_value()) {
+      break;
+    }
+    pageParams.cursor() = *page->nextCursor();
+  }
+  EXPECT_EQ(kNumPrefixes, prefixes.size());
+  EXPECT_EQ(0, prefixes.count(addr1));
+
+  // Non-positive page limit is rejected
+  pageParams = thrift::PageParams();
+  pageParams.limit() = 0;
+  EXPECT_THROW(
+      decision->getReceivedRoutesFilteredPage(filter, pageParams).get(),
+      thrift::OpenrError);
+}
+
 /**
  * Tests reliability of Decision SUB socket. We overload SUB socket with lot
  * of messages and make sure none of them are lost. We make decision compute
@@ -13,6 +13,8 @@
 #include <openr/common/Constants.h>
 #include <openr/common/LsdbUtil.h>
 #include <openr/common/NetworkUtil.h>
+#include <openr/common/Tracing.h>
+#include <openr/common/Util.h>
 #include <openr/fib/Fib.h>
 
 namespace fb303 = facebook::fb303;
@@ -44,6 +46,52 @@ logFibUpdateError(thrift::PlatformFibUpdateError const& error) {
   }
 }
 
+// Sections of paginated route database dump, in order
+constexpr int32_t kUnicastRoutesSection{0};
+constexpr int32_t kMplsRoutesSection{1};
+
+/*
+ * Visit one page of unicast routes followed by MPLS routes, see visitPage().
+ * Return the cursor to continue from, if any.
+ */
+template <typename UnicastFn, typename MplsFn>
+std::optional<thrift::PageCursor>
+visitRouteDbPage(
+    const std::unordered_map<folly::CIDRNetwork, RibUnicastEntry>&
+        unicastRoutes,
+    const std::unordered_map<int32_t, RibMplsEntry>& mplsRoutes,
+    const thrift::PageParams& pageParams,
+    UnicastFn&& unicastFn,
+    MplsFn&& mplsFn) {
+  if (*pageParams.limit() <= 0) {
+    throw std::invalid_argument("Page limit must be positive");
+  }
+  size_t budget = *pageParams.limit();
+  auto cursor = pageParams.cursor().value_or(thrift::PageCursor());
+
+  if (*cursor.section() == kUnicastRoutesSection) {
+    auto nextCursor = visitPage(
+        unicastRoutes, cursor, budget, [&](const auto&, const auto& entry) {
+          unicastFn(entry);
+          return true;
+        });
+    if (nextCursor.has_value()) {
+      return nextCursor;
+    }
+    cursor = thrift::PageCursor();
+    cursor.section() = kMplsRoutesSection;
+  }
+
+  if (*cursor.section() != kMplsRoutesSection) {
+    throw std::invalid_argument("Unknown section of page cursor");
+  }
+  return visitPage(
+      mplsRoutes, cursor, budget, [&](const auto&, const auto& entry) {
+        mplsFn(entry);
+        return true;
+      });
+}
+
 } // namespace
 
 Fib::Fib(
@@ -184,6 +232,74 @@ Fib::getRouteDetailDb() {
   return sf;
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+Fib::getRouteDbPage(thrift::PageParams pageParams) {
+  folly::Promise<std::unique_ptr<thrift::RouteDatabasePage>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread(
+      [p = std::move(p), pageParams = std::move(pageParams), this]() mutable {
+        try {
+          auto page = std::make_unique<thrift::RouteDatabasePage>();
+          auto& routeDb = *page->routeDb();
+          routeDb.thisNodeName() = myNodeName_;
+          auto nextCursor = visitRouteDbPage(
+              routeState_.unicastRoutes,
+              routeState_.mplsRoutes,
+              pageParams,
+              [&routeDb](const RibUnicastEntry& entry) {
+                routeDb.unicastRoutes()->emplace_back(entry.toThrift());
+              },
+              [&routeDb](const RibMplsEntry& entry) {
+                routeDb.mplsRoutes()->emplace_back(entry.toThrift());
+              });
+          if (nextCursor.has_value()) {
+            page->nextCursor() = std::move(*nextCursor);
+          }
+          p.setValue(std::move(page));
+        } catch (std::invalid_argument const& e) {
+          thrift::OpenrError error;
+          error.message() = e.what();
+          p.setException(error);
+        }
+      });
+  return sf;
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetailPage>>
+Fib::getRouteDetailDbPage(thrift::PageParams pageParams) {
+  folly::Promise<std::unique_ptr<thrift::RouteDatabaseDetailPage>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread(
+      [p = std::move(p), pageParams = std::move(pageParams), this]() mutable {
+        try {
+          auto page = std::make_unique<thrift::RouteDatabaseDetailPage>();
+          auto& routeDetailDb = *page->routeDb();
+          routeDetailDb.thisNodeName() = myNodeName_;
+          auto nextCursor = visitRouteDbPage(
+              routeState_.unicastRoutes,
+              routeState_.mplsRoutes,
+              pageParams,
+              [&routeDetailDb](const RibUnicastEntry& entry) {
+                routeDetailDb.unicastRoutes()->emplace_back(
+                    entry.toThriftDetail());
+              },
+              [&routeDetailDb](const RibMplsEntry& entry) {
+                routeDetailDb.mplsRoutes()->emplace_back(
+                    entry.toThriftDetail());
+              });
+          if (nextCursor.has_value()) {
+            page->nextCursor() = std::move(*nextCursor);
+          }
+          p.setValue(std::move(page));
+        } catch (std::invalid_argument const& e) {
+          thrift::OpenrError error;
+          error.message() = e.what();
+          p.setException(error);
+        }
+      });
+  return sf;
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
 Fib::getUnicastRoutes(std::vector<std::string> prefixes) {
   folly::Promise<std::unique_ptr<std::vector<thrift::UnicastRoute>>> p;
@@ -763,6 +879,11 @@ Fib::updateRoutes(
   }
 
   XLOG(INFO) << "Updating routes in FIB";
+  ScopedTraceSpan span(
+      routeUpdate.perfEvents.has_value()
+          ? routeUpdate.perfEvents->traceId().value_or(0)
+          : 0,
+      "fib.program_routes");
   auto const currentTime = std::chrono::steady_clock::now();
   auto const retryAt =
       currentTime + retryRoutesExpBackoff_.getTimeRemainingUntilRetry();
@@ -1122,7 +1243,7 @@ Fib::logPerfEvents(std::optional<thrift::PerfEvents>& perfEvents) {
   sample.addString("event", "ROUTE_CONVERGENCE");
   sample.addStringVector("perf_events", eventStrs);
   sample.addInt("duration_ms", totalDuration.count());
-  logSampleQueue_.push(sample);
+  logSampleQueue_.push(std::move(sample));
 }
 
 std::string
@@ -90,6 +90,16 @@ class Fib final : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetail>>
   getRouteDetailDb();
 
+  /**
+   * Paginated variants of getRouteDb() and getRouteDetailDb(). Unicast routes
+   * are returned first, followed by MPLS routes.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::RouteDatabasePage>>
+  getRouteDbPage(thrift::PageParams pageParams);
+
+  folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetailPage>>
+  getRouteDetailDbPage(thrift::PageParams pageParams);
+
   /**
    * Retrieve unicast routes for specified prefixes or IP. Returns all if
    * no prefix is specified in filter list.
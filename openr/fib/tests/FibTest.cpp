@@ -1113,6 +1113,75 @@ TEST_F(FibTestFixture, WaitOnDecision) {
   EXPECT_EQ(mockFibHandler_->getDelMplsRoutesCount(), 0);
 }
 
+/**
+ * Verify paginated route database dump returns every unicast route, followed
+ * by every MPLS route, exactly once.
+ */
+TEST_F(FibTestFixture, getRouteDbPaginated) {
+  const size_t kNumUnicastRoutes{20};
+  const size_t kNumMplsRoutes{10};
+  const size_t kPageLimit{7};
+  // Routes sharing a hash bucket are never split across pages
+  const size_t kMaxPageOverflow{7};
+
+  DecisionRouteUpdate routeUpdate;
+  for (size_t i = 0; i < kNumUnicastRoutes; ++i) {
+    routeUpdate.addRouteToUpdate(RibUnicastEntry(
+        toIPNetwork(toIpPrefix(fmt::format("10.{}.0.0/16", i))), {path1_2_1}));
+  }
+  for (size_t i = 0; i < kNumMplsRoutes; ++i) {
+    routeUpdate.addMplsRouteToUpdate(
+        RibMplsEntry(100 + static_cast<int32_t>(i), {mpls_path1_2_1}));
+  }
+  routeUpdatesQueue.push(routeUpdate);
+
+  // initial syncFib debounce
+  mockFibHandler_->waitForSyncFib();
+  mockFibHandler_->waitForSyncMplsFib();
+  EXPECT_TRUE(fibRouteUpdatesQueueReader.get().hasValue());
+
+  thrift::PageParams pageParams;
+  pageParams.limit() = kPageLimit;
+  std::unordered_set<thrift::IpPrefix> prefixes;
+  std::unordered_set<int32_t> labels;
+  while (true) {
+    auto page = handler_
+                    ->semifuture_getRouteDbPage(
+                        std::make_unique<thrift::PageParams>(pageParams))
+                    .get();
+    auto const& routeDb = *page->routeDb();
+    EXPECT_EQ("node-1", *routeDb.thisNodeName());
+    EXPECT_LE(
+        routeDb.unicastRoutes()->size() + routeDb.mplsRoutes()->size(),
+        kPageLimit + kMaxPageOverflow);
+    for (auto const& route : *routeDb.unicastRoutes()) {
+      // Unicast routes are all returned before any MPLS route
+      EXPECT_TRUE(labels.empty());
+      EXPECT_TRUE(prefixes.insert(*route.dest()).second);
+    }
+    for (auto const& route : *routeDb.mplsRoutes()) {
+      EXPECT_TRUE(labels.insert(*route.topLabel()).second);
+    }
+    if (not page->nextCursor().has_value()) {
+      break;
+    }
+    pageParams.cursor() = *page->nextCursor();
+  }
+  EXPECT_EQ(kNumUnicastRoutes, prefixes.size());
+  EXPECT_EQ(kNumMplsRoutes, labels.size());
+
+  // Detailed route database fits into one large page
+  pageParams = thrift::PageParams();
+  pageParams.limit() = kNumUnicastRoutes + kNumMplsRoutes + kMaxPageOverflow;
+  auto detailPage = handler_
+                        ->semifuture_getRouteDetailDbPage(
+                            std::make_unique<thrift::PageParams>(pageParams))
+                        .get();
+  EXPECT_FALSE(detailPage->nextCursor().has_value());
+  EXPECT_EQ(kNumUnicastRoutes, detailPage->routeDb()->unicastRoutes()->size());
+  EXPECT_EQ(kNumMplsRoutes, detailPage->routeDb()->mplsRoutes()->size());
+}
+
 TEST_F(FibTestFixture, getMslpRoutesFilteredTest) {
   // Make sure fib starts with clean route database
   std::vector<thrift::UnicastRoute> routes;
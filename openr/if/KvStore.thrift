@@ -383,6 +383,61 @@ struct Publication {
   8: optional i64 timestamp_ms;
 } (cpp.minimize_padding)
 
+/**
+ * Position to resume a paginated dump from. Clients must treat it as opaque
+ * and pass `nextCursor` of the previous page as is.
+ *
+ * Entries are returned in hash-bucket order of the table they are dumped
+ * from. If the table is resized between two pages, the cursor is rejected
+ * and the dump must be restarted from the beginning.
+ */
+struct PageCursor {
+  /**
+   * Table of a multi-table dump (e.g. unicast, then MPLS routes)
+   */
+  1: i32 section = 0;
+
+  /**
+   * Number of buckets of the table when the cursor was created
+   */
+  2: i64 bucketCount = 0;
+
+  /**
+   * First bucket of the table to visit for the next page
+   */
+  3: i64 bucketIndex = 0;
+}
+
+/**
+ * Request object for retrieving one page of a paginated dump
+ */
+struct PageParams {
+  /**
+   * Cursor returned with the previous page. Start from the beginning if unset.
+   */
+  1: optional PageCursor cursor;
+
+  /**
+   * Number of entries to return in one page. Entries sharing a hash bucket are
+   * never split across pages, so a page may exceed this by a few entries. A
+   * page may also hold fewer entries, or none, while the dump is not yet
+   * complete, because the number of entries scanned per page is bounded too.
+   */
+  2: i32 limit = 1000;
+}
+
+/**
+ * One page of KvStore key-values
+ */
+struct PublicationPage {
+  1: Publication publication;
+
+  /**
+   * Cursor to fetch the next page with. Unset on the last page.
+   */
+  2: optional PageCursor nextCursor;
+}
+
 /**
  * Struct summarizing KvStoreDB for a given area. This is currently used for
  * sending responses to 'breeze kvstore summary'
@@ -415,6 +470,27 @@ struct KvStoreFloodRate {
   2: i32 flood_msg_burst_size;
 }
 
+/**
+ * Codec for thrift transport compression. Compression is requested by the
+ * client per connection, the server compresses responses with the same codec.
+ */
+enum TransportCompressionCodec {
+  NONE = 0,
+  ZSTD = 1,
+  ZLIB = 2,
+}
+
+struct TransportCompressionConfig {
+  1: TransportCompressionCodec codec = TransportCompressionCodec.ZSTD;
+
+  /**
+   * Payloads up to this size are sent uncompressed. Keeps small and latency
+   * sensitive messages (e.g. flooding, keep-alive) off the codec while large
+   * full-sync and dump responses get compressed.
+   */
+  2: i64 min_compress_size_bytes = 0;
+}
+
 /**
  * KvStoreConfig is the centralized place to configure
  */
@@ -468,6 +544,8 @@ struct KvStoreConfig {
   13: optional string x509_ca_path;
   /** Knob to enable/disable TLS thrift client. */
   14: bool enable_secure_thrift_client = false;
+  /** Transport compression of KvStore peer connections. ZSTD if not set. */
+  15: optional TransportCompressionConfig peer_compression_config;
 } (cpp.minimize_padding)
 
 /**
@@ -506,6 +584,16 @@ service KvStoreService extends fb303_core.BaseService {
     2: string area,
   ) throws (1: KvStoreError error);
 
+  /**
+   * Paginated variant of `getKvStoreKeyValsFilteredArea`. KvStore produces
+   * each page in bounded time and memory, regardless of its size.
+   */
+  PublicationPage getKvStoreKeyValsFilteredAreaPage(
+    1: KeyDumpParams filter,
+    2: string area,
+    3: PageParams pageParams,
+  ) throws (1: KvStoreError error);
+
   /**
    * Get kvstore metadata (no values) with filter
    */
@@ -13,6 +13,7 @@ namespace py3 openr.thrift
 namespace wiki Open_Routing.Thrift_APIs.OpenrConfig
 
 include "openr/if/BgpConfig.thrift"
+include "openr/if/KvStore.thrift"
 include "configerator/structs/neteng/config/routing_policy.thrift"
 include "configerator/structs/neteng/config/vip_service_config.thrift"
 
@@ -154,6 +155,22 @@ struct DecisionConfig {
   101: bool enable_bgp_route_programming = true;
 }
 
+/**
+ * Figure-of-merit flap damping. Every flap adds `penalty_per_flap` to the
+ * penalty of an object, and the penalty decays exponentially with
+ * `half_life_ms`. The object is suppressed once its penalty reaches
+ * `suppress_threshold` and reused once it decays below `reuse_threshold`.
+ * Penalty is capped so that an object is never suppressed longer than
+ * `max_suppress_ms` after its last flap.
+ */
+struct FlapDampingConfig {
+  1: i32 penalty_per_flap = 1000;
+  2: i32 half_life_ms = 60000;
+  3: i32 suppress_threshold = 2000;
+  4: i32 reuse_threshold = 750;
+  5: i32 max_suppress_ms = 600000;
+}
+
 struct LinkMonitorConfig {
   /**
    * When link goes down after being stable/up for long time, then the backoff
@@ -186,6 +203,31 @@ struct LinkMonitorConfig {
   * Enable convergence performance measurement for adjacency updates.
   */
   7: bool enable_perf_measurement = true;
+
+  /**
+   * Penalty based flap damping applied on interfaces. An interface suppressed
+   * by damping is treated as inactive until its penalty decays below reuse
+   * threshold. Disabled if not set.
+   */
+  8: optional FlapDampingConfig interface_flap_damping_config;
+
+  /**
+   * Penalty based flap damping applied on adjacencies. A suppressed adjacency
+   * is withheld from the advertised adjacency database until its penalty
+   * decays below reuse threshold. Disabled if not set.
+   */
+  9: optional FlapDampingConfig adjacency_flap_damping_config;
+}
+
+/**
+ * Mean estimator used by the step detector over fast and slow windows. Both
+ * are O(1) per sample.
+ */
+enum StepDetectorType {
+  /** Running sum over a ring buffer of the last `window_size` samples. */
+  SLIDING_WINDOW = 0,
+  /** Exponentially weighted moving average. Keeps no samples. */
+  EWMA = 1,
 }
 
 struct StepDetectorConfig {
@@ -194,6 +236,7 @@ struct StepDetectorConfig {
   3: i32 lower_threshold = 2;
   4: i32 upper_threshold = 5;
   5: i64 ads_threshold = 500;
+  6: StepDetectorType detector_type = StepDetectorType.SLIDING_WINDOW;
 }
 
 struct SparkConfig {
@@ -235,6 +278,21 @@ struct SparkConfig {
    * published to LinkMonitor during Open/R Initialization process.
    */
   9: i32 max_neighbor_discovery_interval_s = 15;
+
+  /**
+   * Max number of Spark packets per second processed from a single interface,
+   * regardless of the sender. Packets above this rate are dropped right after
+   * being read from the socket and before any thrift deserialization. If not
+   * set, only the per-neighbor rate limit applies.
+   */
+  10: optional i32 max_allowed_pps_per_interface;
+
+  /**
+   * If set, attach a kernel socket filter (classic BPF) to the Spark multicast
+   * socket. Packets not sourced from an IPv6 link-local address, or carrying a
+   * hop-limit below 255, are dropped in the kernel and never cost a syscall.
+   */
+  11: bool enable_socket_filter = false;
 }
 
 struct WatchdogConfig {
@@ -265,6 +323,23 @@ struct MemoryProfilingConfig {
   2: i32 heap_dump_interval_s = 300;
 }
 
+struct PersistentStoreConfig {
+  /**
+   * Updates are appended to log segment files next to the snapshot file at
+   * `persistent_config_store_path`. Once a segment grows beyond this size, a
+   * new one is started and full segments are compacted into the snapshot by a
+   * background thread.
+   */
+  1: i32 segment_size_bytes = 1048576;
+
+  /**
+   * If set, fdatasync() log segment after every group commit, i.e. every batch
+   * of updates written together. Trades write latency for durability of the
+   * latest updates against power loss.
+   */
+  2: bool enable_fdatasync = false;
+}
+
 enum VerifyClientType {
   // Request a cert and verify it. Fail if verification fails or no
   // cert is presented
@@ -321,6 +396,8 @@ struct ThriftClientConfig {
   1: bool enable_secure_thrift_client = false;
   /** Verify type for server when enabling secure client. */
   2: VerifyServerType verify_server_type;
+  /** Transport compression of KvStore peer connections. ZSTD if not set. */
+  3: optional KvStore.TransportCompressionConfig kvstore_peer_compression;
 }
 
 enum PrefixAllocationMode {
@@ -783,6 +860,11 @@ struct OpenrConfig {
   */
   37: string persistent_config_store_path = "/tmp/openr_persistent_config_store.bin";
 
+  /**
+  * Config for log-structured storage of the persistent store.
+  */
+  41: PersistentStoreConfig persistent_store_config;
+
   /**
   * Config for periodically dumping the heap memory profile of Open/R process.
   */
@@ -874,8 +956,9 @@ struct OpenrConfig {
   104: optional BgpRouteTranslationConfig bgp_translation_config;
 
   /**
-   * Enable FSDB subscription to detect a neighbor down event, in case
-   * such event is undetectable through interface change
+   * Enable NeighborMonitor to detect a neighbor down event from kernel
+   * neighbor table (NUD_FAILED), in case such event is undetectable through
+   * interface change and before Spark hold timer expires.
    * Current use case: detecting LAG down
    */
   105: bool enable_neighbor_monitor = false;
@@ -895,4 +978,15 @@ struct OpenrConfig {
    * Flag to enable Dispatcher module in the architecture.
    */
   202: bool enable_kvstore_dispatcher = false;
+
+  /**
+   * Number of bulk prefix database keys a node packs its advertised prefixes
+   * into, per area. Each prefix is assigned to one `prefix:<node>:<shard>` key
+   * by consistent hashing. This greatly reduces the number of keys in KvStore
+   * for nodes advertising a lot of prefixes.
+   *
+   * Value of 0 (default) keeps one `prefix:<node>:[<prefix>]` key per prefix.
+   * Decision understands both formats, so nodes can be migrated one by one.
+   */
+  203: i32 prefix_db_shard_count = 0;
 } (cpp.minimize_padding)
@@ -239,6 +239,96 @@ struct RouteDatabaseDeltaDetail {
   4: list<i32> mplsRoutesToDelete;
 }
 
+/**
+ * Pages of large route dumps. `nextCursor` is unset on the last page.
+ */
+struct AdvertisedRoutesPage {
+  1: list<AdvertisedRouteDetail> routes;
+  2: optional KvStore.PageCursor nextCursor;
+}
+
+struct ReceivedRoutesPage {
+  1: list<ReceivedRouteDetail> routes;
+  2: optional KvStore.PageCursor nextCursor;
+}
+
+struct RouteDatabasePage {
+  1: Types.RouteDatabase routeDb;
+  2: optional KvStore.PageCursor nextCursor;
+}
+
+struct RouteDatabaseDetailPage {
+  1: RouteDatabaseDetail routeDb;
+  2: optional KvStore.PageCursor nextCursor;
+}
+
+struct NodeSnapshotParams {
+  /**
+   * Serve module sections from the last collected snapshot if it is younger
+   * than 5s, otherwise they are collected from the modules. Set to false to
+   * always fan out to the modules for up-to-date state.
+   */
+  1: bool allowCached = true;
+
+  /**
+   * Counters to include. All counters are returned if not set.
+   */
+  2: optional list<string> counterKeys;
+}
+
+/**
+ * Composite view of the node for monitoring tools, see getNodeSnapshot().
+ */
+struct NodeSnapshot {
+  1: string nodeName;
+
+  /**
+   * Module sections. May be served from the cached snapshot taken at
+   * `snapshotTimestampMs` (ms since epoch). A section stays empty if the
+   * module is not running or failed to respond.
+   */
+  2: list<KvStore.KvStoreAreaSummary> kvStoreAreaSummaries;
+  3: list<Types.SparkNeighbor> neighbors;
+  4: Types.DumpLinksReply interfaces;
+  5: i64 snapshotTimestampMs;
+
+  /**
+   * Always current, read from in-process counters
+   */
+  6: i64 unicastRouteCount;
+  7: i64 mplsRouteCount;
+  8: map<string, i64> counters;
+}
+
+/**
+ * Memory usage of key data structures and modules, see getMemoryBreakdown().
+ */
+struct MemoryBreakdown {
+  /**
+   * Bytes currently allocated by each module, measured from dedicated
+   * jemalloc arena of the module thread. Memory handed over to other modules
+   * is accounted to the allocating module until freed. Empty if not running
+   * with jemalloc or per-module arenas are disabled.
+   */
+  1: map<string, i64> moduleAllocatedBytes;
+
+  /**
+   * KvStore key count and approximate key-value bytes per area
+   */
+  2: map<string, i64> kvStoreKeyCount;
+  3: map<string, i64> kvStoreKeyValBytes;
+
+  /**
+   * Sizes of Decision and Fib state
+   */
+  4: i64 adjacencyCount;
+  5: i64 prefixCount;
+  6: i64 unicastRouteCount;
+  7: i64 mplsRouteCount;
+
+  8: i64 processRssBytes;
+}
+
 /**
  * Thrift service - exposes RPC APIs for interaction with all of Open/R's
  * modules.
@@ -325,6 +415,21 @@ service OpenrCtrl extends KvStore.KvStoreService {
     2: list<Types.PrefixEntry> prefixes,
   ) throws (1: OpenrError error);
 
+  /**
+   * Chunked version of syncPrefixesByType() for very large prefix sets, to
+   * avoid one giant request. A sync starts with `isFirstChunk` set and
+   * completes with `isLastChunk` set (both may be set for a single chunk).
+   * Prefixes of each chunk are advertised right away, while prefixes of
+   * given type not present in any chunk are withdrawn upon the last chunk.
+   * Starting a new sync abandons the unfinished one of the same type.
+   */
+  void syncPrefixesByTypeChunk(
+    1: Network.PrefixType prefixType,
+    2: list<Types.PrefixEntry> prefixes,
+    3: bool isFirstChunk,
+    4: bool isLastChunk,
+  ) throws (1: OpenrError error);
+
   /**
    * Get all prefixes being advertised
    * @deprecated - use getAdvertisedRoutes() instead
@@ -351,6 +456,15 @@ service OpenrCtrl extends KvStore.KvStoreService {
     1: AdvertisedRouteFilter filter,
   ) throws (1: OpenrError error);
 
+  /**
+   * Paginated variant of `getAdvertisedRoutesFiltered`. Explicitly requested
+   * prefixes are always returned in a single page.
+   */
+  AdvertisedRoutesPage getAdvertisedRoutesFilteredPage(
+    1: AdvertisedRouteFilter filter,
+    2: KvStore.PageParams pageParams,
+  ) throws (1: OpenrError error);
+
   /**
    * For given area, show pre/post policy advertised routes.
    */
@@ -381,6 +495,15 @@ service OpenrCtrl extends KvStore.KvStoreService {
     1: ReceivedRouteFilter filter,
   ) throws (1: OpenrError error);
 
+  /**
+   * Paginated variant of `getReceivedRoutesFiltered`. Explicitly requested
+   * prefixes are always returned in a single page.
+   */
+  ReceivedRoutesPage getReceivedRoutesFilteredPage(
+    1: ReceivedRouteFilter filter,
+    2: KvStore.PageParams pageParams,
+  ) throws (1: OpenrError error);
+
   /**
    * Get route database of the current node. It is retrieved from FIB module.
    */
@@ -391,6 +514,17 @@ service OpenrCtrl extends KvStore.KvStoreService {
    */
   RouteDatabaseDetail getRouteDetailDb() throws (1: OpenrError error);
 
+  /**
+   * Paginated variants of `getRouteDb` and `getRouteDetailDb`. Unicast routes
+   * are returned first, followed by MPLS routes.
+   */
+  RouteDatabasePage getRouteDbPage(1: KvStore.PageParams pageParams) throws (
+    1: OpenrError error,
+  );
+  RouteDatabaseDetailPage getRouteDetailDbPage(
+    1: KvStore.PageParams pageParams,
+  ) throws (1: OpenrError error);
+
   /**
    * Get route database from decision module. Since Decision has global
    * topology information, any node can be retrieved.
@@ -494,6 +628,17 @@ service OpenrCtrl extends KvStore.KvStoreService {
     2: KvStore.KeyVals snapshot,
   ) throws (1: OpenrError error);
 
+  /**
+   * Long poll API to watch adjacency changes of an area without snapshot.
+   * Returns current adjacency version of the area right away if it differs
+   * from `version`, otherwise once any adjacency key changes or the hold
+   * time elapses. Pass 0 on first call and the returned version afterwards.
+   * Adjacencies only need to be re-read when the returned version moved.
+   */
+  i64 longPollKvStoreAdjVersion(1: string area, 2: i64 version) throws (
+    1: OpenrError error,
+  );
+
   // Deprecated, prefer API sepcfying area
   // TODO, remove once EBB has transition away from this
   bool longPollKvStoreAdj(1: KvStore.KeyVals snapshot) throws (
@@ -689,9 +834,39 @@ service OpenrCtrl extends KvStore.KvStoreService {
   // Get log events
   list<string> getEventLogs() throws (1: OpenrError error);
 
+  /**
+   * Get spans recorded for convergence events in Chrome trace event (JSON)
+   * format, loadable into Perfetto UI or chrome://tracing. Only spans of
+   * given trace are returned if `traceId` is non-zero. Trace id of an event
+   * can be found in `PerfEvents.traceId`.
+   */
+  string getTraceEvents(1: i64 traceId) throws (1: OpenrError error);
+
+  /**
+   * Get memory usage per module and of key data structures
+   */
+  MemoryBreakdown getMemoryBreakdown() throws (1: OpenrError error);
+
+  /**
+   * Dump jemalloc heap profile of the process and return path of the file.
+   * Requires heap profiling to be enabled, e.g. MALLOC_CONF=prof:true.
+   * Profile is process wide, use `moduleAllocatedBytes` of
+   * getMemoryBreakdown() to attribute memory to modules.
+   */
+  string dumpHeapProfile() throws (1: OpenrError error);
+
   // Get Openr Node Name
   string getMyNodeName();
 
+  /**
+   * Composite of getKvStoreAreaSummary(), getNeighbors(), getInterfaces(),
+   * route counts and getSelectedCounters() in one call. Modules are queried
+   * concurrently, or the cached snapshot is served if allowed.
+   */
+  NodeSnapshot getNodeSnapshot(1: NodeSnapshotParams params) throws (
+    1: OpenrError error,
+  );
+
   //
   // RibPolicy
   //
@@ -53,4 +53,14 @@ service OpenrCtrlCpp extends OpenrCtrl.OpenrCtrl {
   OpenrCtrl.RouteDatabaseDetail, stream<
     OpenrCtrl.RouteDatabaseDeltaDetail
   > subscribeAndGetFibDetail();
+
+  /**
+   * Batch version of getRouteDbComputed for controllers. Compute route
+   * databases of given nodes (all nodes if empty) from one consistent LSDB
+   * snapshot, in parallel. Each route database is streamed as soon as it is
+   * computed and stream completes after the last one.
+   */
+  stream<Types.RouteDatabase> getRouteDbComputedStream(
+    1: list<string> nodeNames,
+  );
 }
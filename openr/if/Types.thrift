@@ -66,6 +66,13 @@ struct PerfEvents {
    * Ordered list of event. Most recent event is appended at the back
    */
   1: list<PerfEvent> events;
+
+  /**
+   * Identifier of the convergence event these perf events belong to. Used to
+   * correlate spans recorded by modules on every node the data object
+   * traverses, see `TraceRecorder`.
+   */
+  2: optional i64 traceId;
 }
 
 /**
@@ -537,6 +544,17 @@ struct InterfaceDetails {
    * the other end of the interface.
    */
   5: i32 linkMetricIncrementVal;
+
+  /**
+   * Flap damping penalty of this interface. Set only if interface flap damping
+   * is configured. See `interface_flap_damping_config` in LinkMonitorConfig.
+   */
+  6: optional i64 linkFlapDampingPenalty;
+
+  /**
+   * Whether this interface is suppressed by flap damping
+   */
+  7: bool isLinkFlapDampingSuppressed;
 } (cpp.minimize_padding)
 
 /**
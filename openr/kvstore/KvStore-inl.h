@@ -6,12 +6,14 @@
  */
 
 #include <fb303/ServiceData.h>
+#include <folly/compression/Compression.h>
 #include <folly/io/async/SSLContext.h>
 #include <folly/logging/xlog.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/EventLogger.h>
 #include <openr/common/Types.h>
+#include <openr/common/Util.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
 
 namespace fb303 = facebook::fb303;
@@ -159,7 +161,9 @@ KvStore<ClientType>::processKeyValueRequest(KeyValueRequest&& kvRequest) {
     if (auto pPersistKvRequest =
             std::get_if<PersistKeyValueRequest>(&kvRequest)) {
       kvStoreDb.persistSelfOriginatedKey(
-          pPersistKvRequest->getKey(), pPersistKvRequest->getValue());
+          pPersistKvRequest->getKey(),
+          pPersistKvRequest->getValue(),
+          pPersistKvRequest->getTraceId());
     } else if (
         auto pSetKvRequest = std::get_if<SetKeyValueRequest>(&kvRequest)) {
       kvStoreDb.setSelfOriginatedKey(
@@ -174,6 +178,11 @@ KvStore<ClientType>::processKeyValueRequest(KeyValueRequest&& kvRequest) {
       } else {
         kvStoreDb.eraseSelfOriginatedKey(pClearKvRequest->getKey());
       }
+    } else if (
+        auto pBatchKvRequest = std::get_if<BatchKeyValueRequest>(&kvRequest)) {
+      kvStoreDb.updateSelfOriginatedKeys(
+          pBatchKvRequest->getKeysToPersist(),
+          pBatchKvRequest->getKeysToUnset());
     } else {
       XLOG(ERR)
           << "Error processing key value request. Request type not recognized.";
@@ -369,6 +378,79 @@ KvStore<ClientType>::semifuture_dumpKvStoreKeys(
   return sf;
 }
 
+template <class ClientType>
+folly::SemiFuture<std::unique_ptr<thrift::PublicationPage>>
+KvStore<ClientType>::semifuture_dumpKvStoreKeysPage(
+    std::string area,
+    thrift::KeyDumpParams keyDumpParams,
+    thrift::PageParams pageParams) {
+  folly::Promise<std::unique_ptr<thrift::PublicationPage>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([this,
+                        p = std::move(p),
+                        area = std::move(area),
+                        keyDumpParams = std::move(keyDumpParams),
+                        pageParams = std::move(pageParams)]() mutable {
+    XLOG(DBG3) << "Dump page of keys requested for AREA: " << area;
+    try {
+      auto& kvStoreDb = getAreaDbOrThrow(area, "dumpKvStoreKeysPage");
+      fb303::fbData->addStatValue(
+          "kvstore.cmd_key_dump_page", 1, fb303::COUNT);
+
+      if (*pageParams.limit() <= 0) {
+        thrift::KvStoreError error;
+        error.message() = "Page limit must be positive";
+        throw error;
+      }
+
+      std::vector<std::string> keyPrefixList;
+      if (keyDumpParams.keys().has_value()) {
+        keyPrefixList = *keyDumpParams.keys();
+      } else {
+        folly::split(",", *keyDumpParams.prefix(), keyPrefixList, true);
+      }
+      const auto keyPrefixMatch = KvStoreFilters(
+          keyPrefixList,
+          *keyDumpParams.originatorIds(),
+          keyDumpParams.oper().value_or(thrift::FilterOperator::OR));
+      const auto doNotPublishValue = *keyDumpParams.doNotPublishValue();
+
+      auto page = std::make_unique<thrift::PublicationPage>();
+      auto& thriftPub = *page->publication();
+      thriftPub.area() = area;
+      size_t budget = *pageParams.limit();
+      auto nextCursor = visitPage(
+          kvStoreDb.getKeyValueMap(),
+          pageParams.cursor().value_or(thrift::PageCursor()),
+          budget,
+          [&](const std::string& key, const thrift::Value& val) {
+            if (not keyPrefixMatch.keyMatch(key, val)) {
+              return false;
+            }
+            thriftPub.keyVals()->emplace(
+                key,
+                doNotPublishValue ? createThriftValueWithoutBinaryValue(val)
+                                  : val);
+            return true;
+          });
+      if (nextCursor.has_value()) {
+        page->nextCursor() = std::move(*nextCursor);
+      }
+      updatePublicationTtl(
+          kvStoreDb.getTtlCountdownQueue(), kvParams_.ttlDecr, thriftPub);
+      p.setValue(std::move(page));
+    } catch (thrift::KvStoreError const& e) {
+      p.setException(e);
+    } catch (std::exception const& e) {
+      // Invalid cursor or key filter regex
+      thrift::KvStoreError error;
+      error.message() = folly::exceptionStr(e).toStdString();
+      p.setException(error);
+    }
+  });
+  return sf;
+}
+
 template <class ClientType>
 folly::SemiFuture<std::unique_ptr<thrift::Publication>>
 KvStore<ClientType>::semifuture_dumpKvStoreHashes(
@@ -475,6 +557,25 @@ KvStore<ClientType>::semifuture_getKvStorePeers(std::string area) {
   return sf;
 }
 
+template <class ClientType>
+folly::SemiFuture<int64_t>
+KvStore<ClientType>::semifuture_longPollAdjVersion(
+    std::string area, int64_t version) {
+  folly::Promise<int64_t> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([this, p = std::move(p), area, version]() mutable {
+    try {
+      getAreaDbOrThrow(area, "semifuture_longPollAdjVersion")
+          .longPollAdjVersion(version, std::move(p));
+      fb303::fbData->addStatValue(
+          "kvstore.cmd_long_poll_adj_version", 1, fb303::COUNT);
+    } catch (thrift::KvStoreError const& e) {
+      p.setException(e);
+    }
+  });
+  return sf;
+}
+
 template <class ClientType>
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>>
 KvStore<ClientType>::semifuture_getKvStoreAreaSummaryInternal(
@@ -490,23 +591,40 @@ KvStore<ClientType>::semifuture_getKvStoreAreaSummaryInternal(
                 ? "all areas."
                 : fmt::format("areas: {}.", folly::join(", ", selectAreas)));
 
-    auto result = std::make_unique<std::vector<thrift::KvStoreAreaSummary>>();
-    for (auto& [area, kvStoreDb] : kvStoreDb_) {
-      thrift::KvStoreAreaSummary areaSummary;
-
-      areaSummary.area() = area;
-      auto kvDbCounters = kvStoreDb.getCounters();
-      areaSummary.keyValsCount() = kvDbCounters["kvstore.num_keys"];
-      areaSummary.peersMap() = kvStoreDb.dumpPeers();
-      areaSummary.keyValsBytes() = kvStoreDb.getKeyValsSize();
+    p.setValue(getAreaSummaries());
+  });
+  return sf;
+}
 
-      result->emplace_back(std::move(areaSummary));
-    }
-    p.setValue(std::move(result));
+template <class ClientType>
+folly::SemiFuture<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>>
+KvStore<ClientType>::semifuture_getKvStoreAreaSummaryQuiet() {
+  folly::Promise<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([this, p = std::move(p)]() mutable {
+    p.setValue(getAreaSummaries());
   });
   return sf;
 }
 
+template <class ClientType>
+std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>
+KvStore<ClientType>::getAreaSummaries() {
+  auto result = std::make_unique<std::vector<thrift::KvStoreAreaSummary>>();
+  for (auto& [area, kvStoreDb] : kvStoreDb_) {
+    thrift::KvStoreAreaSummary areaSummary;
+
+    areaSummary.area() = area;
+    auto kvDbCounters = kvStoreDb.getCounters();
+    areaSummary.keyValsCount() = kvDbCounters["kvstore.num_keys"];
+    areaSummary.peersMap() = kvStoreDb.dumpPeers();
+    areaSummary.keyValsBytes() = kvStoreDb.getKeyValsSize();
+
+    result->emplace_back(std::move(areaSummary));
+  }
+  return result;
+}
+
 template <class ClientType>
 folly::SemiFuture<folly::Unit>
 KvStore<ClientType>::semifuture_addUpdateKvStorePeers(
@@ -868,7 +986,8 @@ KvStoreDb<ClientType>::KvStorePeer::getOrCreateThriftClient(
             Constants::kServiceConnTimeout, /* client connection timeout */
             Constants::kServiceProcTimeout, /* request processing timeout */
             folly::AsyncSocket::anyAddress(), /* bindAddress */
-            maybeIpTos /* IP_TOS value for control plane */);
+            maybeIpTos, /* IP_TOS value for control plane */
+            kvParams_.peerCompressionConfig);
         fb303::fbData->addStatValue(
             "kvstore.thrift.secure_client", 1, fb303::COUNT);
       } catch (const std::exception& ex) {
@@ -879,7 +998,8 @@ KvStoreDb<ClientType>::KvStorePeer::getOrCreateThriftClient(
             Constants::kServiceConnTimeout, /* client connection timeout */
             Constants::kServiceProcTimeout, /* request processing timeout */
             folly::AsyncSocket::anyAddress(), /* bindAddress */
-            maybeIpTos /* IP_TOS value for control plane */);
+            maybeIpTos, /* IP_TOS value for control plane */
+            kvParams_.peerCompressionConfig);
 
         fb303::fbData->addStatValue(
             "kvstore.thrift.plaintext_client.fallback", 1, fb303::COUNT);
@@ -892,7 +1012,8 @@ KvStoreDb<ClientType>::KvStorePeer::getOrCreateThriftClient(
           Constants::kServiceConnTimeout, /* client connection timeout */
           Constants::kServiceProcTimeout, /* request processing timeout */
           folly::AsyncSocket::anyAddress(), /* bindAddress */
-          maybeIpTos /* IP_TOS value for control plane */);
+          maybeIpTos, /* IP_TOS value for control plane */
+          kvParams_.peerCompressionConfig);
 
       fb303::fbData->addStatValue(
           "kvstore.thrift.plaintext_client", 1, fb303::COUNT);
@@ -966,6 +1087,7 @@ KvStoreDb<ClientType>::KvStoreDb(
       area_(area),
       areaTag_(fmt::format("[Area {}] ", area)),
       initialKvStoreSyncedCallback_(initialKvStoreSyncedCallback),
+      adjVersion_(getUnixTimeStampMs()),
       evb_(evb) {
   if (kvParams_.floodRate) {
     floodLimiter_ = std::make_unique<folly::BasicTokenBucket<>>(
@@ -1005,6 +1127,22 @@ KvStoreDb<ClientType>::KvStoreDb(
   selfOriginatedKeyTtlTimer_ = folly::AsyncTimeout::make(
       *evb_->getEvb(), [this]() noexcept { advertiseTtlUpdates(); });
 
+  // Create timer to release expired adjacency long-poll requests
+  adjVersionWaitersTimer_ =
+      folly::AsyncTimeout::make(*evb_->getEvb(), [this]() noexcept {
+        const auto now = std::chrono::steady_clock::now();
+        while (not adjVersionWaiters_.empty() and
+               adjVersionWaiters_.front().first <= now) {
+          adjVersionWaiters_.front().second.setValue(adjVersion_);
+          adjVersionWaiters_.pop_front();
+        }
+        if (not adjVersionWaiters_.empty()) {
+          adjVersionWaitersTimer_->scheduleTimeout(
+              std::chrono::ceil<std::chrono::milliseconds>(
+                  adjVersionWaiters_.front().first - now));
+        }
+      });
+
   // Create timer to advertise pending key-vals
   advertiseKeyValsTimer_ =
       folly::AsyncTimeout::make(*evb_->getEvb(), [this]() noexcept {
@@ -1072,12 +1210,35 @@ KvStoreDb<ClientType>::stop() {
     unsetSelfOriginatedKeysThrottled_.reset();
     advertiseSelfOriginatedKeysThrottled_.reset();
     ttlCountdownTimer_.reset();
+    // Release pending long-poll requests with current version
+    adjVersionWaitersTimer_.reset();
+    for (auto& [_, promise] : adjVersionWaiters_) {
+      promise.setValue(adjVersion_);
+    }
+    adjVersionWaiters_.clear();
     XLOG(INFO) << AreaTag() << "Successfully destroyed thriftPeers and timers";
   });
 
   XLOG(INFO) << AreaTag() << "Successfully stopped KvStoreDb.";
 }
 
+template <class ClientType>
+void
+KvStoreDb<ClientType>::longPollAdjVersion(
+    int64_t version, folly::Promise<int64_t> promise) {
+  if (version != adjVersion_) {
+    promise.setValue(adjVersion_);
+    return;
+  }
+
+  adjVersionWaiters_.emplace_back(
+      std::chrono::steady_clock::now() + Constants::kLongPollReqHoldTime,
+      std::move(promise));
+  if (not adjVersionWaitersTimer_->isScheduled()) {
+    adjVersionWaitersTimer_->scheduleTimeout(Constants::kLongPollReqHoldTime);
+  }
+}
+
 template <class ClientType>
 void
 KvStoreDb<ClientType>::floodTopoDumpTask() noexcept {
@@ -1215,6 +1376,24 @@ KvStoreDb<ClientType>::setSelfOriginatedKey(
 template <class ClientType>
 void
 KvStoreDb<ClientType>::persistSelfOriginatedKey(
+    std::string const& key, std::string const& value, int64_t traceId) {
+  ScopedTraceSpan span(traceId, "kvstore.persist_key");
+  if (not persistSelfOriginatedKeyImpl(key, value)) {
+    return;
+  }
+
+  // ATTN: keep the oldest trace when advertisements are batched
+  if (pendingAdvertiseTraceId_ == 0) {
+    pendingAdvertiseTraceId_ = traceId;
+  }
+
+  // Throttled advertisement of pending keys
+  advertiseSelfOriginatedKeysThrottled_->operator()();
+}
+
+template <class ClientType>
+bool
+KvStoreDb<ClientType>::persistSelfOriginatedKeyImpl(
     std::string const& key, std::string const& value) {
   XLOG(DBG3) << AreaTag()
              << fmt::format("{} called for key: {}", __FUNCTION__, key);
@@ -1265,7 +1444,7 @@ KvStoreDb<ClientType>::persistSelfOriginatedKey(
     thriftValue = selfOriginatedKeyIt->second.value;
     if (*thriftValue.value() == value) {
       // this is a no op, return early and change no state
-      return;
+      return false;
     }
   }
 
@@ -1306,11 +1485,9 @@ KvStoreDb<ClientType>::persistSelfOriginatedKey(
     keysToAdvertise_.insert(key);
   }
 
-  // Throttled advertisement of pending keys
-  advertiseSelfOriginatedKeysThrottled_->operator()();
-
   // Add ttl backoff and trigger selfOriginatedKeyTtlTimer_
   scheduleTtlUpdates(key, hasTtlChanged /* advertiseImmediately */);
+  return true;
 }
 
 template <class ClientType>
@@ -1324,8 +1501,28 @@ KvStoreDb<ClientType>::advertiseSelfOriginatedKeys() {
     return;
   }
 
+  ScopedTraceSpan span(
+      std::exchange(pendingAdvertiseTraceId_, 0),
+      "kvstore.advertise_self_originated_keys");
+
   // Build set of keys to advertise
   thrift::KeyVals keyVals{};
+  const auto timeout = collectSelfOriginatedKeysToAdvertise(keyVals);
+
+  // Advertise key-vals to KvStore
+  thrift::KeySetParams params;
+  params.keyVals() = std::move(keyVals);
+  setKeyVals(std::move(params), true /* self-originated update */);
+
+  // Schedule next-timeout for processing/clearing backoffs
+  XLOG(DBG2) << "Scheduling timer after " << timeout.count() << "ms.";
+  advertiseKeyValsTimer_->scheduleTimeout(timeout);
+}
+
+template <class ClientType>
+std::chrono::milliseconds
+KvStoreDb<ClientType>::collectSelfOriginatedKeysToAdvertise(
+    thrift::KeyVals& keyVals) {
   // Build keys to be cleaned from local storage
   std::vector<std::string> keysToClear;
 
@@ -1358,25 +1555,29 @@ KvStoreDb<ClientType>::advertiseSelfOriginatedKeys() {
     keysToClear.emplace_back(key);
   }
 
-  // Advertise key-vals to KvStore
-  thrift::KeySetParams params;
-  params.keyVals() = std::move(keyVals);
-  setKeyVals(std::move(params), true /* self-originated update */);
-
   // clear out variable used for batching advertisements
   for (auto const& key : keysToClear) {
     keysToAdvertise_.erase(key);
   }
-
-  // Schedule next-timeout for processing/clearing backoffs
-  XLOG(DBG2) << "Scheduling timer after " << timeout.count() << "ms.";
-  advertiseKeyValsTimer_->scheduleTimeout(timeout);
+  return timeout;
 }
 
 template <class ClientType>
 void
 KvStoreDb<ClientType>::unsetSelfOriginatedKey(
     std::string const& key, std::string const& value) {
+  if (not unsetSelfOriginatedKeyImpl(key, value)) {
+    return;
+  }
+
+  // Send updates to KvStore via batch processing.
+  unsetSelfOriginatedKeysThrottled_->operator()();
+}
+
+template <class ClientType>
+bool
+KvStoreDb<ClientType>::unsetSelfOriginatedKeyImpl(
+    std::string const& key, std::string const& value) {
   XLOG(DBG3) << AreaTag()
              << fmt::format("{} called for key: {}", __FUNCTION__, key);
 
@@ -1387,7 +1588,7 @@ KvStoreDb<ClientType>::unsetSelfOriginatedKey(
   // it as "empty". This condition should not exist.
   auto keyIt = kvStore_.find(key);
   if (keyIt == kvStore_.end()) {
-    return;
+    return false;
   }
 
   // Overwrite all values and increment version.
@@ -1398,8 +1599,7 @@ KvStoreDb<ClientType>::unsetSelfOriginatedKey(
   thriftValue.value() = value;
 
   keysToUnset_.emplace(key, std::move(thriftValue));
-  // Send updates to KvStore via batch processing.
-  unsetSelfOriginatedKeysThrottled_->operator()();
+  return true;
 }
 
 template <class ClientType>
@@ -1411,6 +1611,56 @@ KvStoreDb<ClientType>::eraseSelfOriginatedKey(std::string const& key) {
   keysToAdvertise_.erase(key);
 }
 
+template <class ClientType>
+void
+KvStoreDb<ClientType>::updateSelfOriginatedKeys(
+    std::unordered_map<std::string, std::string> const& keysToPersist,
+    std::unordered_map<std::string, std::string> const& keysToUnset) {
+  XLOG(DBG3) << AreaTag()
+             << fmt::format(
+                    "{} called for {} keys to persist, {} keys to unset",
+                    __FUNCTION__,
+                    keysToPersist.size(),
+                    keysToUnset.size());
+
+  for (auto const& [key, value] : keysToUnset) {
+    unsetSelfOriginatedKeyImpl(key, value);
+  }
+  for (auto const& [key, value] : keysToPersist) {
+    persistSelfOriginatedKeyImpl(key, value);
+  }
+
+  // Flush all pending advertisements and unsets, including the ones from
+  // previous non-batched requests still waiting for throttling, with one
+  // setKeyVals() call. This results in a single flooding publication.
+  //
+  // ATTN: persisted and unset keys are disjoint since unset skips any key
+  // inside `selfOriginatedKeyVals_`.
+  thrift::KeyVals keyVals;
+  collectPendingKeysToUnset(keyVals);
+  std::optional<std::chrono::milliseconds> timeout;
+  if (not keysToAdvertise_.empty()) {
+    timeout = collectSelfOriginatedKeysToAdvertise(keyVals);
+  }
+
+  fb303::fbData->addStatValue(
+      "kvstore.batch_key_value_request.keys",
+      keysToPersist.size() + keysToUnset.size(),
+      fb303::SUM);
+
+  if (not keyVals.empty()) {
+    thrift::KeySetParams params;
+    params.keyVals() = std::move(keyVals);
+    setKeyVals(std::move(params), true /* self-originated update */);
+  }
+
+  // Schedule next-timeout for processing/clearing backoffs
+  if (timeout.has_value()) {
+    XLOG(DBG2) << "Scheduling timer after " << timeout->count() << "ms.";
+    advertiseKeyValsTimer_->scheduleTimeout(*timeout);
+  }
+}
+
 template <class ClientType>
 void
 KvStoreDb<ClientType>::unsetPendingSelfOriginatedKeys() {
@@ -1420,6 +1670,17 @@ KvStoreDb<ClientType>::unsetPendingSelfOriginatedKeys() {
 
   // Build set of keys to update KvStore
   thrift::KeyVals keyVals;
+  collectPendingKeysToUnset(keyVals);
+
+  // Send updates to KvStore
+  thrift::KeySetParams params;
+  params.keyVals() = std::move(keyVals);
+  setKeyVals(std::move(params), true /* self-originated update */);
+}
+
+template <class ClientType>
+void
+KvStoreDb<ClientType>::collectPendingKeysToUnset(thrift::KeyVals& keyVals) {
   // Build keys to be cleaned from local storage. Do not remove from
   // keysToUnset_ directly while iterating.
   std::vector<std::string> localKeysToUnset;
@@ -1447,11 +1708,6 @@ KvStoreDb<ClientType>::unsetPendingSelfOriginatedKeys() {
     }
   }
 
-  // Send updates to KvStore
-  thrift::KeySetParams params;
-  params.keyVals() = std::move(keyVals);
-  setKeyVals(std::move(params), true /* self-originated update */);
-
   // Empty out keysToUnset_
   for (auto const& key : localKeysToUnset) {
     keysToUnset_.erase(key);
@@ -1791,6 +2047,8 @@ KvStoreDb<ClientType>::processThriftSuccess(
     return;
   }
 
+  sampleTransportCompression(pub);
+
   auto numMissingKeys =
       pub.tobeUpdatedKeys().has_value() ? pub.tobeUpdatedKeys()->size() : 0;
   auto numReceivedKeys = pub.keyVals()->size();
@@ -1889,6 +2147,70 @@ KvStoreDb<ClientType>::processInitializationEvent() {
   initialKvStoreSyncedCallback_();
 }
 
+// Sample transport compression of full-sync responses. As this runs on
+// KvStore evb, only a bounded portion of the response is re-serialized and
+// compressed. Its compression ratio stands for the whole response.
+template <class ClientType>
+void
+KvStoreDb<ClientType>::sampleTransportCompression(
+    thrift::Publication const& pub) {
+  const auto& config = kvParams_.peerCompressionConfig;
+  if (*config.codec() == thrift::TransportCompressionCodec::NONE) {
+    return;
+  }
+  if (numFullSyncResponses_++ % Constants::kTransportCompressionSampleRate) {
+    return;
+  }
+
+  // Key and value bytes dominate the serialized size of the response, thrift
+  // overhead is ignored to avoid serializing it as a whole.
+  auto keyValBytes = [](std::string const& key, thrift::Value const& val) {
+    return static_cast<int64_t>(
+        key.size() + (val.value().has_value() ? val.value()->size() : 0));
+  };
+  int64_t payloadBytes{0};
+  for (auto const& [key, val] : *pub.keyVals()) {
+    payloadBytes += keyValBytes(key, val);
+  }
+  if (payloadBytes <= *config.min_compress_size_bytes()) {
+    return; // Sent uncompressed
+  }
+
+  thrift::Publication sample;
+  int64_t sampleBytes{0};
+  for (auto const& [key, val] : *pub.keyVals()) {
+    if (sampleBytes >= Constants::kTransportCompressionSampleMaxBytes) {
+      break;
+    }
+    sampleBytes += keyValBytes(key, val);
+    sample.keyVals()->emplace(key, val);
+  }
+
+  const auto serialized =
+      apache::thrift::CompactSerializer::serialize<std::string>(sample);
+  const int64_t rawBytes = serialized.size();
+  auto buf = folly::IOBuf::wrapBuffer(serialized.data(), serialized.size());
+
+  auto codec = folly::io::getCodec(
+      *config.codec() == thrift::TransportCompressionCodec::ZLIB
+          ? folly::io::CodecType::ZLIB
+          : folly::io::CodecType::ZSTD);
+  const auto startTime = std::chrono::steady_clock::now();
+  const int64_t compressedBytes =
+      codec->compress(buf.get())->computeChainDataLength();
+  const auto cpuTime = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - startTime);
+
+  fb303::fbData->addStatValue(
+      "kvstore.thrift.compression.sampled_bytes", rawBytes, fb303::SUM);
+  fb303::fbData->addStatValue(
+      "kvstore.thrift.compression.bytes_saved",
+      rawBytes - compressedBytes,
+      fb303::SUM);
+  fb303::fbData->addStatValue(
+      "kvstore.thrift.compression.cpu_us", cpuTime.count(), fb303::SUM);
+}
+
 // This function will process the exception hit during full-dump:
 //  1) Change peer state from current state to IDLE due to exception;
 //  2) Schedule syncTimer to pick IDLE peer up if NOT scheduled;
@@ -2360,6 +2682,30 @@ KvStoreDb<ClientType>::floodPublication(
   }
   publication.nodeIds()->emplace_back(kvParams_.nodeId);
 
+  // Bump adjacency version and wake up long-poll requests if any adjacency
+  // key is updated or expired
+  bool adjChanged = std::any_of(
+      publication.keyVals()->cbegin(),
+      publication.keyVals()->cend(),
+      [](const auto& kv) {
+        return kv.second.value().has_value() and
+            folly::StringPiece(kv.first).startsWith(Constants::kAdjDbMarker);
+      });
+  adjChanged |= std::any_of(
+      publication.expiredKeys()->cbegin(),
+      publication.expiredKeys()->cend(),
+      [](const auto& key) {
+        return folly::StringPiece(key).startsWith(Constants::kAdjDbMarker);
+      });
+  if (adjChanged) {
+    ++adjVersion_;
+    for (auto& [_, promise] : adjVersionWaiters_) {
+      promise.setValue(adjVersion_);
+    }
+    adjVersionWaiters_.clear();
+    adjVersionWaitersTimer_->cancelTimeout();
+  }
+
   // Flood publication to internal subscribers
   kvParams_.kvStoreUpdatesQueue.push(publication);
   fb303::fbData->addStatValue("kvstore.num_updates", 1, fb303::COUNT);
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <list>
+
 #include <folly/TokenBucket.h>
 #include <folly/gen/Base.h>
 #include <folly/io/async/AsyncTimeout.h>
@@ -17,6 +19,7 @@
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrClient.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/Tracing.h>
 #include <openr/common/Types.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
 #include <openr/kvstore/KvStoreUtil.h>
@@ -93,6 +96,8 @@ struct KvStoreParams {
   std::optional<std::string> x509_cert_path{std::nullopt};
   std::optional<std::string> x509_key_path{std::nullopt};
   std::optional<std::string> x509_ca_path{std::nullopt};
+  // Transport compression of peer connections
+  thrift::TransportCompressionConfig peerCompressionConfig{};
 
   KvStoreParams(
       const thrift::KvStoreConfig& kvStoreConfig,
@@ -111,7 +116,10 @@ struct KvStoreParams {
             *kvStoreConfig.enable_secure_thrift_client()),
         x509_cert_path(kvStoreConfig.x509_cert_path().to_optional()),
         x509_key_path(kvStoreConfig.x509_key_path().to_optional()),
-        x509_ca_path(kvStoreConfig.x509_ca_path().to_optional()) {}
+        x509_ca_path(kvStoreConfig.x509_ca_path().to_optional()),
+        peerCompressionConfig(
+            kvStoreConfig.peer_compression_config().value_or(
+                thrift::TransportCompressionConfig{})) {}
 };
 
 /*
@@ -171,6 +179,23 @@ class KvStoreDb {
     return ttlCountdownQueue_;
   }
 
+  /*
+   * [Adjacency Version]
+   *
+   * Monotonic counter bumped whenever an adjacency key is updated or expired
+   * in this area. Seeded with wall-clock time on start so that versions
+   * handed out before a restart never match the new ones.
+   */
+  inline int64_t
+  getAdjVersion() const {
+    return adjVersion_;
+  }
+
+  // Fulfill `promise` with current adjacency version as soon as it differs
+  // from `version`, or with the unchanged version after
+  // `Constants::kLongPollReqHoldTime`.
+  void longPollAdjVersion(int64_t version, folly::Promise<int64_t> promise);
+
   /*
    * [Util]
    *
@@ -273,13 +298,19 @@ class KvStoreDb {
    *    4) eraseSelfOriginatedKey
    *      Erase key from local cache(DO NOT SET NEW VALUE), thus stopping
    *      ttl-refreshing.
+   *    5) updateSelfOriginatedKeys
+   *      Persist and unset many keys at once. Unlike 1) and 3), changes are
+   *      NOT throttled but merged and flooded right away in one publication.
    */
   void persistSelfOriginatedKey(
-      std::string const& key, std::string const& value);
+      std::string const& key, std::string const& value, int64_t traceId = 0);
   void setSelfOriginatedKey(
       std::string const& key, std::string const& value, uint32_t version);
   void unsetSelfOriginatedKey(std::string const& key, std::string const& value);
   void eraseSelfOriginatedKey(std::string const& key);
+  void updateSelfOriginatedKeys(
+      std::unordered_map<std::string, std::string> const& keysToPersist,
+      std::unordered_map<std::string, std::string> const& keysToUnset);
 
  private:
   // disable copying
@@ -329,6 +360,13 @@ class KvStoreDb {
       thrift::Publication&& pub,
       std::chrono::milliseconds timeDelta);
 
+  /*
+   * Estimate bytes saved and CPU spent by transport compression on a sample
+   * of full-sync responses, by compressing a bounded portion of the
+   * serialized response again.
+   */
+  void sampleTransportCompression(thrift::Publication const& pub);
+
   void processThriftFailure(
       std::string const& peerName,
       folly::fbstring const& exceptionStr,
@@ -420,6 +458,21 @@ class KvStoreDb {
   void advertiseSelfOriginatedKeys();
   void unsetPendingSelfOriginatedKeys();
 
+  /*
+   * Helpers shared by throttled and batched self-originated key management.
+   *
+   * `persistSelfOriginatedKeyImpl()`/`unsetSelfOriginatedKeyImpl()` update
+   * local cache and pending key sets, returning false if nothing changed.
+   * `collect*()` move pending key-vals into `keyVals` to be advertised.
+   */
+  bool persistSelfOriginatedKeyImpl(
+      std::string const& key, std::string const& value);
+  bool unsetSelfOriginatedKeyImpl(
+      std::string const& key, std::string const& value);
+  std::chrono::milliseconds collectSelfOriginatedKeysToAdvertise(
+      thrift::KeyVals& keyVals);
+  void collectPendingKeysToUnset(thrift::KeyVals& keyVals);
+
   /*
    * [Self Originated Key Management with publication]
    *
@@ -566,6 +619,9 @@ class KvStoreDb {
   // Set of local keys to be re-advertised.
   std::unordered_set<std::string /* key */> keysToAdvertise_{};
 
+  // Trace id of the oldest traced persist request in `keysToAdvertise_`
+  int64_t pendingAdvertiseTraceId_{0};
+
   // Throttle advertisement of self-originated persisted keys.
   // Calls `advertiseSelfOriginatedKeys()`.
   std::unique_ptr<AsyncThrottle> advertiseSelfOriginatedKeysThrottled_{nullptr};
@@ -593,6 +649,21 @@ class KvStoreDb {
   // response received
   size_t parallelSyncLimitOverThrift_{2};
 
+  // number of full-sync responses received, used for sampling
+  uint64_t numFullSyncResponses_{0};
+
+  // adjacency version of this area, see `getAdjVersion()`
+  int64_t adjVersion_{0};
+
+  // long-poll requests waiting for adjacency version change, ordered by
+  // expiry time as all of them are held for the same duration
+  std::list<std::pair<std::chrono::steady_clock::time_point,
+                      folly::Promise<int64_t>>>
+      adjVersionWaiters_;
+
+  // timer to release expired long-poll requests in `adjVersionWaiters_`
+  std::unique_ptr<folly::AsyncTimeout> adjVersionWaitersTimer_{nullptr};
+
   // Stop signal for fiber to periodically dump flood topology
   folly::fibers::Baton floodTopoStopSignal_;
 
@@ -658,6 +729,14 @@ class KvStore final : public OpenrEventBase {
       thrift::KeyDumpParams keyDumpParams,
       std::set<std::string> selectAreas = {});
 
+  // Dump one page of key-vals matching `keyDumpParams` in given area. Work
+  // done on KvStore thread per call is bounded by `pageParams.limit`.
+  folly::SemiFuture<std::unique_ptr<thrift::PublicationPage>>
+  semifuture_dumpKvStoreKeysPage(
+      std::string area,
+      thrift::KeyDumpParams keyDumpParams,
+      thrift::PageParams pageParams);
+
   folly::SemiFuture<std::unique_ptr<SelfOriginatedKeyVals>>
   semifuture_dumpKvStoreSelfOriginatedKeys(std::string area);
 
@@ -679,6 +758,17 @@ class KvStore final : public OpenrEventBase {
   folly::SemiFuture<folly::Unit> semifuture_deleteKvStorePeers(
       std::string area, std::vector<std::string> peersToDel);
 
+  /*
+   * [Public APIs]
+   *
+   * Long-poll adjacency changes of an area. Resolves with the current
+   * adjacency version immediately if it differs from `version`, otherwise
+   * once adjacency keys change or the hold time elapses. No key-vals are
+   * dumped, caller re-reads adjacencies only when the version moved.
+   */
+  folly::SemiFuture<int64_t> semifuture_longPollAdjVersion(
+      std::string area, int64_t version);
+
   /*
    * [Public APIs]
    *
@@ -689,6 +779,11 @@ class KvStore final : public OpenrEventBase {
   semifuture_getKvStoreAreaSummaryInternal(
       std::set<std::string> selectAreas = {});
 
+  // Same as above without logging the request, for monitoring APIs which may
+  // be polled frequently by tools
+  folly::SemiFuture<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>>
+  semifuture_getKvStoreAreaSummaryQuiet();
+
   folly::SemiFuture<std::map<std::string, int64_t>> semifuture_getCounters();
 
   // API to get reader for kvStoreUpdatesQueue
@@ -726,6 +821,9 @@ class KvStore final : public OpenrEventBase {
   std::map<std::string, int64_t> getGlobalCounters() const;
   void initGlobalCounters();
 
+  // util method to build area summaries, called in evb thread
+  std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>> getAreaSummaries();
+
   /*
    * This is a helper function which returns a reference to the relevant
    * KvStoreDb or throws an instance of KvStoreError for backward compaytibilty.
@@ -50,6 +50,16 @@ KvStoreServiceHandler<ClientType>::semifuture_getKvStoreKeyValsFilteredArea(
           });
 }
 
+template <class ClientType>
+folly::SemiFuture<std::unique_ptr<thrift::PublicationPage>>
+KvStoreServiceHandler<ClientType>::semifuture_getKvStoreKeyValsFilteredAreaPage(
+    std::unique_ptr<thrift::KeyDumpParams> filter,
+    std::unique_ptr<std::string> area,
+    std::unique_ptr<thrift::PageParams> pageParams) {
+  return kvStore_->semifuture_dumpKvStoreKeysPage(
+      std::move(*area), std::move(*filter), std::move(*pageParams));
+}
+
 template <class ClientType>
 folly::SemiFuture<std::unique_ptr<thrift::Publication>>
 KvStoreServiceHandler<ClientType>::semifuture_getKvStoreHashFilteredArea(
@@ -63,6 +63,15 @@ class KvStoreServiceHandler final : public thrift::KvStoreServiceSvIf,
       std::unique_ptr<thrift::KeyDumpParams> filter,
       std::unique_ptr<std::string> area) override;
 
+  /*
+   * Paginated version of `semifuture_getKvStoreKeyValsFilteredArea`.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::PublicationPage>>
+  semifuture_getKvStoreKeyValsFilteredAreaPage(
+      std::unique_ptr<thrift::KeyDumpParams> filter,
+      std::unique_ptr<std::string> area,
+      std::unique_ptr<thrift::PageParams> pageParams) override;
+
   /*
    * API to return key-val HASHes(NO binary value included) only by given:
    *  - thrift::KeyDumpParams;
@@ -286,6 +286,66 @@ TEST_F(
   evb.waitUntilStopped();
 }
 
+/**
+ * Validate BatchKeyValueRequest persists and unsets many keys at once and
+ * floods all of the changes with a single publication.
+ */
+TEST_F(
+    KvStoreSelfOriginatedKeyValueRequestFixture,
+    ProcessBatchKeyValueRequest) {
+  const std::string nodeId = "node-batch";
+  initKvStore(nodeId);
+
+  const std::vector<std::string> keys{"batch-key-1", "batch-key-2"};
+  const std::string value = "batch-value";
+  const std::string unsetValue = "batch-unset-value";
+  const std::string newKey = "batch-key-3";
+
+  // Step1: persist two keys with one request. Expect one publication.
+  {
+    BatchKeyValueRequest batchRequest(kTestingAreaName);
+    for (const auto& key : keys) {
+      batchRequest.addPersistKey(key, value);
+    }
+    EXPECT_EQ(2, batchRequest.size());
+    kvRequestQueue_.push(std::move(batchRequest));
+
+    auto pub = kvStore_->recvPublication();
+    EXPECT_EQ(2, pub.keyVals()->size());
+    for (const auto& key : keys) {
+      EXPECT_EQ(1, *(pub.keyVals()->at(key).version()));
+      EXPECT_EQ(value, *(pub.keyVals()->at(key).value()));
+    }
+    EXPECT_EQ(2, kvStore_->dumpAllSelfOriginated(kTestingAreaName).size());
+  }
+
+  // Step2: unset one key, persist a new one and update the other. The last
+  //        operation on the same key wins. Expect one publication.
+  {
+    BatchKeyValueRequest batchRequest(kTestingAreaName);
+    batchRequest.addUnsetKey(keys.at(0), unsetValue);
+    batchRequest.addUnsetKey(keys.at(1), unsetValue);
+    batchRequest.addPersistKey(keys.at(1), value + "-new");
+    batchRequest.addPersistKey(newKey, value);
+    EXPECT_EQ(1, batchRequest.getKeysToUnset().size());
+    EXPECT_EQ(2, batchRequest.getKeysToPersist().size());
+    kvRequestQueue_.push(std::move(batchRequest));
+
+    auto pub = kvStore_->recvPublication();
+    EXPECT_EQ(3, pub.keyVals()->size());
+    EXPECT_EQ(2, *(pub.keyVals()->at(keys.at(0)).version()));
+    EXPECT_EQ(unsetValue, *(pub.keyVals()->at(keys.at(0)).value()));
+    EXPECT_EQ(2, *(pub.keyVals()->at(keys.at(1)).version()));
+    EXPECT_EQ(value + "-new", *(pub.keyVals()->at(keys.at(1)).value()));
+    EXPECT_EQ(1, *(pub.keyVals()->at(newKey).version()));
+
+    // unset key is no longer refreshed by KvStore
+    auto kvStoreCache = kvStore_->dumpAllSelfOriginated(kTestingAreaName);
+    EXPECT_EQ(2, kvStoreCache.size());
+    EXPECT_EQ(0, kvStoreCache.count(keys.at(0)));
+  }
+}
+
 /*
  * Verify KvStoreDb will override self-originated key version when received
  * KvStore publication. Make sure key-override happens and re-advertise higher
@@ -307,6 +307,74 @@ TEST_F(KvStoreTestFixture, DumpKeysWithPrefix) {
   kvStore_->stop();
 }
 
+/**
+ * Validate paginated dump returns every key exactly once and bounds the
+ * number of keys per page. Keys sharing a hash bucket are never split across
+ * pages, so a page may exceed the limit by the rest of its last bucket.
+ */
+TEST_F(KvStoreTestFixture, DumpKeysPaginated) {
+  const std::string nodeId = "node-for-page-dump";
+  auto kvStore_ = createKvStore(getTestKvConf(nodeId));
+  kvStore_->run();
+
+  const size_t kNumKeys{100};
+  const size_t kPageLimit{7};
+  // Max number of extra keys per page, i.e. max bucket size minus one. With
+  // max load factor of 1, a bucket virtually never holds 8 keys or more.
+  const size_t kMaxPageOverflow{7};
+  const std::string genValue = "generic-value";
+  const thrift::Value thriftVal = createThriftValue(
+      1 /* version */,
+      nodeId /* originatorId */,
+      genValue /* value */,
+      Constants::kTtlInfinity /* ttl */,
+      0 /* ttl version */,
+      generateHash(1, nodeId, thrift::Value().value() = std::string(genValue)));
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    kvStore_->setKey(kTestingAreaName, fmt::format("key-{}", i), thriftVal);
+  }
+  kvStore_->setKey(kTestingAreaName, "other-key", thriftVal);
+
+  thrift::PageParams pageParams;
+  pageParams.limit() = kPageLimit;
+  std::unordered_set<std::string> keys;
+  size_t numPages{0};
+  while (true) {
+    thrift::KeyDumpParams params;
+    params.keys() = {"key-"};
+    auto page = kvStore_->getKvStore()
+                    ->semifuture_dumpKvStoreKeysPage(
+                        kTestingAreaName.t, std::move(params), pageParams)
+                    .get();
+    EXPECT_LE(
+        page->publication()->keyVals()->size(), kPageLimit + kMaxPageOverflow);
+    for (auto const& [key, _] : *page->publication()->keyVals()) {
+      EXPECT_TRUE(keys.insert(key).second) << "Duplicate key " << key;
+    }
+    ++numPages;
+    if (not page->nextCursor().has_value()) {
+      break;
+    }
+    pageParams.cursor() = *page->nextCursor();
+  }
+  EXPECT_EQ(keys.size(), kNumKeys);
+  EXPECT_GE(numPages, kNumKeys / (kPageLimit + kMaxPageOverflow));
+  EXPECT_EQ(keys.count("other-key"), 0);
+
+  // Cursor taken from a differently sized table is rejected
+  thrift::PageCursor staleCursor;
+  staleCursor.bucketCount() = 3;
+  pageParams.cursor() = staleCursor;
+  EXPECT_THROW(
+      kvStore_->getKvStore()
+          ->semifuture_dumpKvStoreKeysPage(
+              kTestingAreaName.t, thrift::KeyDumpParams(), pageParams)
+          .get(),
+      thrift::KvStoreError);
+
+  kvStore_->stop();
+}
+
 /**
  * Verify KvStore publishes kvStoreSynced signal even when receiving empty peers
  * in initialization process.
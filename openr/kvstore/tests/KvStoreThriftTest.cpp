@@ -443,6 +443,13 @@ TEST_F(KvStoreThriftTestFixture, UnidirectionThriftFullSync) {
         EXPECT_EQ(
             0, counters.at("kvstore.thrift.num_finalized_sync_failure.count"));
 
+        // first full-sync response is sampled for compression stats
+        EXPECT_LT(
+            0, counters.at("kvstore.thrift.compression.sampled_bytes.sum"));
+        ASSERT_EQ(
+            1, counters.count("kvstore.thrift.compression.bytes_saved.sum"));
+        ASSERT_EQ(1, counters.count("kvstore.thrift.compression.cpu_us.sum"));
+
         evb.stop();
       });
   evb.run();
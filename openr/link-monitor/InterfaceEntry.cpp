@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/gen/Base.h>
 #include <folly/logging/xlog.h>
 
@@ -19,11 +20,15 @@ InterfaceEntry::InterfaceEntry(
     std::chrono::milliseconds const& initBackoff,
     std::chrono::milliseconds const& maxBackoff,
     AsyncThrottle& updateCallback,
-    folly::AsyncTimeout& updateTimeout)
+    folly::AsyncTimeout& updateTimeout,
+    std::optional<thrift::FlapDampingConfig> const& dampingConfig)
     : backoff_(initBackoff, maxBackoff),
       updateCallback_(updateCallback),
       updateTimeout_(updateTimeout) {
   CHECK(not ifName.empty());
+  if (dampingConfig.has_value()) {
+    damping_.emplace(*dampingConfig);
+  }
   // other attributes will be updated via:
   //  - updateAttrs()
   //  - updateAddr()
@@ -42,6 +47,16 @@ InterfaceEntry::updateAttrs(int ifIndex, bool isUp) {
   if (wasUp != isUp and wasUp) {
     // Penalize backoff on transitioning to DOWN state
     backoff_.reportError();
+
+    // Accumulate flap damping penalty
+    if (damping_ and damping_->reportFlap()) {
+      XLOG(INFO) << fmt::format(
+          "Interface {} is suppressed by flap damping for {}ms",
+          info_.ifName,
+          damping_->getTimeUntilReuse().count());
+      fb303::fbData->addStatValue(
+          "link_monitor.flap_damping.interface_suppressed", 1, fb303::SUM);
+    }
   }
 
   // Look for active to down transition
@@ -67,12 +82,26 @@ InterfaceEntry::isActive() {
   if (now - lastErrorTime > backoff_.getMaxBackoff()) {
     backoff_.reportSuccess();
   }
-  return backoff_.canTryNow();
+  return backoff_.canTryNow() and not isDampingSuppressed();
 }
 
 std::chrono::milliseconds
 InterfaceEntry::getBackoffDuration() const {
-  return backoff_.getTimeRemainingUntilRetry();
+  auto backoff = backoff_.getTimeRemainingUntilRetry();
+  if (damping_) {
+    backoff = std::max(backoff, damping_->getTimeUntilReuse());
+  }
+  return backoff;
+}
+
+bool
+InterfaceEntry::isDampingSuppressed() {
+  return damping_ and damping_->isSuppressed();
+}
+
+double
+InterfaceEntry::getDampingPenalty() const {
+  return damping_ ? damping_->getPenalty() : 0;
 }
 
 bool
@@ -11,6 +11,7 @@
 
 #include <openr/common/AsyncThrottle.h>
 #include <openr/common/ExponentialBackoff.h>
+#include <openr/common/FlapDamping.h>
 #include <openr/common/LsdbTypes.h>
 
 namespace openr {
@@ -23,6 +24,8 @@ namespace openr {
  * - Any change will always trigger throttled callback
  * - Interface transition from Active to Inactive schedules immediate timeout
  *   for fast reactions to down events.
+ * - If flap damping is configured, every UP to DOWN transition adds penalty
+ *   and interface is inactive while suppressed by damping.
  */
 class InterfaceEntry final {
  public:
@@ -31,7 +34,9 @@ class InterfaceEntry final {
       std::chrono::milliseconds const& initBackoff,
       std::chrono::milliseconds const& maxBackoff,
       AsyncThrottle& updateCallback,
-      folly::AsyncTimeout& updateTimeout);
+      folly::AsyncTimeout& updateTimeout,
+      std::optional<thrift::FlapDampingConfig> const& dampingConfig =
+          std::nullopt);
 
   // Update attributes
   bool updateAttrs(int ifIndex, bool isUp);
@@ -40,12 +45,16 @@ class InterfaceEntry final {
   bool updateAddr(folly::CIDRNetwork const& ipNetwork, bool isValid);
 
   // Is interface active. Interface is active only when it is in UP state and
-  // it's not backed off
+  // it's neither backed off nor suppressed by flap damping
   bool isActive();
 
-  // Get backoff time
+  // Get backoff time, including remaining flap damping suppression if any
   std::chrono::milliseconds getBackoffDuration() const;
 
+  // Flap damping state. Penalty is 0 if damping is not configured.
+  bool isDampingSuppressed();
+  double getDampingPenalty() const;
+
   // Used to check for updates if doing a re-sync
   bool
   operator==(const InterfaceEntry& interfaceEntry) {
@@ -90,6 +99,9 @@ class InterfaceEntry final {
   // Backoff variables
   ExponentialBackoff<std::chrono::milliseconds> backoff_;
 
+  // Penalty based flap damping. Unset if not configured.
+  std::optional<FlapDamping> damping_;
+
   // Update callback
   AsyncThrottle& updateCallback_;
   folly::AsyncTimeout& updateTimeout_;
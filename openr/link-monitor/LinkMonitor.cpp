@@ -6,12 +6,15 @@
  */
 
 #include <fb303/ServiceData.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/fibers/FiberManager.h>
 #include <folly/logging/xlog.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/EventLogger.h>
 #include <openr/common/LsdbUtil.h>
 #include <openr/common/NetworkUtil.h>
+#include <openr/common/Tracing.h>
 #include <openr/common/Types.h>
 #include <openr/config/Config.h>
 #include <openr/if/gen-cpp2/Network_types.h>
@@ -66,6 +69,44 @@ printLinkMonitorState(openr::thrift::LinkMonitorState const& state) {
   }
 }
 
+/**
+ * Stream netlink dump requested with `streamFn` and apply every object with
+ * `applyFn` in the calling fiber as soon as it is received. Fiber yields every
+ * kInterfaceSyncChunkSize objects so that other fibers, e.g. netlink event
+ * processing, are not starved. Returns status of the dump.
+ */
+template <typename T, typename StreamFn, typename ApplyFn>
+int
+streamDump(StreamFn&& streamFn, ApplyFn&& applyFn) {
+  // Objects of the dump, terminated by status of the dump
+  openr::messaging::RWQueue<folly::Expected<T, int>> dumpQueue;
+  std::forward<StreamFn>(streamFn)([&dumpQueue](T&& obj) {
+    dumpQueue.push(std::move(obj));
+  })
+      .via(&folly::InlineExecutor::instance())
+      .thenTry([&dumpQueue](folly::Try<int>&& status) {
+        dumpQueue.push(folly::makeUnexpected(
+            status.hasValue() ? status.value() : -EIO));
+      });
+
+  size_t numProcessed{0};
+  while (true) {
+    auto maybeObj = dumpQueue.get();
+    if (maybeObj.hasError()) {
+      return -EIO;
+    }
+    if (maybeObj->hasError()) {
+      return maybeObj->error();
+    }
+    if (numProcessed != 0 and
+        numProcessed % openr::Constants::kInterfaceSyncChunkSize == 0) {
+      folly::fibers::yield();
+    }
+    ++numProcessed;
+    applyFn(std::move(maybeObj->value()));
+  }
+}
+
 } // anonymous namespace
 
 namespace openr {
@@ -102,7 +143,7 @@ LinkMonitor::LinkMonitor(
     std::shared_ptr<const Config> config,
     fbnl::NetlinkProtocolSocket* nlSock,
     PersistentStore* configStore,
-    messaging::ReplicateQueue<InterfaceDatabase>& interfaceUpdatesQueue,
+    messaging::ReplicateQueue<InterfaceDatabaseDelta>& interfaceUpdatesQueue,
     messaging::ReplicateQueue<PrefixEvent>& prefixUpdatesQueue,
     messaging::ReplicateQueue<PeerEvent>& peerUpdatesQueue,
     messaging::ReplicateQueue<LogSample>& logSampleQueue,
@@ -131,6 +172,14 @@ LinkMonitor::LinkMonitor(
       peerUpdatesQueue_(peerUpdatesQueue),
       logSampleQueue_(logSampleQueue),
       kvRequestQueue_(kvRequestQueue),
+      interfaceDampingConfig_(
+          config->getLinkMonitorConfig()
+              .interface_flap_damping_config()
+              .to_optional()),
+      adjDampingConfig_(
+          config->getLinkMonitorConfig()
+              .adjacency_flap_damping_config()
+              .to_optional()),
       expBackoff_(Constants::kInitialBackoff, Constants::kMaxBackoff),
       configStore_(configStore),
       nlSock_(nlSock) {
@@ -152,16 +201,16 @@ LinkMonitor::LinkMonitor(
     advertiseRedistAddrs();
   });
 
-  // Create throttled adjacency advertiser per area
-  for (const auto& it : areas_) {
-    const auto& area = it.first;
-    advertiseAdjacenciesThrottledPerArea_.emplace(
-        area,
-        std::make_unique<AsyncThrottle>(
-            getEvb(),
-            Constants::kAdjacencyThrottleTimeout,
-            [this, area]() noexcept { advertiseAdjacencies(area); }));
-  }
+  // Re-advertise adjacencies once adjacency suppressed by flap damping can be
+  // reused
+  adjDampingReuseTimer_ = folly::AsyncTimeout::make(
+      *getEvb(), [this]() noexcept { scheduleAdvertiseAdjAllArea(); });
+
+  // Create throttled adjacency advertiser coalescing all areas
+  advertiseAdjacenciesThrottled_ = std::make_unique<AsyncThrottle>(
+      getEvb(), Constants::kAdjacencyThrottleTimeout, [this]() noexcept {
+        advertisePendingAdjacencies();
+      });
 
   // Create throttled interfaces and addresses advertiser
   advertiseIfaceAddrThrottled_ = std::make_unique<AsyncThrottle>(
@@ -339,6 +388,8 @@ LinkMonitor::LinkMonitor(
   fb303::fbData->addStatExportType(
       "link_monitor.advertise_adjacencies", fb303::SUM);
   fb303::fbData->addStatExportType("link_monitor.advertise_links", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.sync_interface.success", fb303::SUM);
   fb303::fbData->addStatExportType(
       "link_monitor.sync_interface.failure", fb303::SUM);
 }
@@ -428,7 +479,7 @@ LinkMonitor::neighborUpEvent(
   updateKvStorePeerNeighborUp(area, adjKey, tPeerSpec);
 
   // Advertise new adjancies in a throttled fashion
-  advertiseAdjacenciesThrottledPerArea_.at(area)->operator()();
+  scheduleAdvertiseAdjacencies(area);
 }
 
 void
@@ -498,6 +549,9 @@ LinkMonitor::neighborDownEvent(const NeighborEvent& event) {
   // update KvStore Peer
   updateKvStorePeerNeighborDown(area, adjId, adjValueIt->second.peerSpec_);
 
+  // [Flap-Damping] penalize adjacency going down
+  reportAdjFlap(area, adjId);
+
   // Remove such adjacencies.
   adjacencies_[area].erase(adjValueIt);
   if (adjacencies_[area].empty()) {
@@ -561,7 +615,7 @@ LinkMonitor::neighborRttChangeEvent(const NeighborEvent& event) {
       auto& adj = it->second.adj_;
       adj.metric() = newRttMetric;
       adj.rtt() = rttUs;
-      advertiseAdjacenciesThrottledPerArea_.at(area)->operator()();
+      scheduleAdvertiseAdjacencies(area);
     }
   }
 }
@@ -691,34 +745,71 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
     return;
   }
 
-  auto& advertiseAdjPerAreaThrottle =
-      advertiseAdjacenciesThrottledPerArea_.at(area);
-  // Cancel throttle timeout if scheduled
-  if (advertiseAdjPerAreaThrottle->isActive()) {
-    advertiseAdjPerAreaThrottle->cancel();
+  // Area is being advertised now. Cancel throttle timeout if no other area
+  // is pending.
+  adjPendingAreas_.erase(area);
+  if (adjPendingAreas_.empty() and advertiseAdjacenciesThrottled_->isActive()) {
+    advertiseAdjacenciesThrottled_->cancel();
   }
 
+  // Carry trace of pending neighbor event along with adjacency database
+  int64_t traceId{0};
+  if (auto it = adjPendingTraceIds_.find(area);
+      it != adjPendingTraceIds_.end()) {
+    traceId = it->second;
+    adjPendingTraceIds_.erase(it);
+  }
+  ScopedTraceSpan span(traceId, "link_monitor.advertise_adjacencies");
+
   // Extract information from `adjacencies_`
   auto adjDb = buildAdjacencyDatabase(area);
 
-  XLOG(INFO) << fmt::format(
-      "Updating adjacency database in KvStore with {} entries in area: {}",
-      adjDb.adjacencies()->size(),
-      area);
-
-  // Persist `adj:node_Id` key into KvStore
-  const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
+  // ATTN: perf events carry timestamps and are excluded from comparison with
+  // last advertised encoding
+  std::optional<thrift::PerfEvents> perfEvents;
+  if (adjDb.perfEvents().has_value()) {
+    perfEvents = std::move(*adjDb.perfEvents());
+    adjDb.perfEvents().reset();
+  }
   std::string adjDbStr = writeThriftObjStr(adjDb, serializer_);
-  auto persistAdjacencyKeyVal =
-      PersistKeyValueRequest(AreaId{area}, keyName, adjDbStr);
-  kvRequestQueue_.push(std::move(persistAdjacencyKeyVal));
+
+  auto& advertisedAdjDbStr = advertisedAdjDbs_[area];
+  if (adjDbStr == advertisedAdjDbStr) {
+    XLOG(DBG2) << fmt::format(
+        "Skip advertising unchanged adjacency database in area: {}", area);
+    fb303::fbData->addStatValue(
+        "link_monitor.advertise_adjacencies.suppressed", 1, fb303::SUM);
+  } else {
+    advertisedAdjDbStr = adjDbStr;
+
+    XLOG(INFO) << fmt::format(
+        "Updating adjacency database in KvStore with {} entries in area: {}",
+        adjDb.adjacencies()->size(),
+        area);
+
+    if (perfEvents.has_value()) {
+      if (traceId != 0) {
+        perfEvents->traceId() = traceId;
+      }
+      adjDb.perfEvents() = std::move(perfEvents).value();
+      adjDbStr = writeThriftObjStr(adjDb, serializer_);
+    }
+
+    // Persist `adj:node_Id` key into KvStore
+    const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
+    auto persistAdjacencyKeyVal =
+        PersistKeyValueRequest(AreaId{area}, keyName, adjDbStr);
+    persistAdjacencyKeyVal.setTraceId(traceId);
+    kvRequestQueue_.push(std::move(persistAdjacencyKeyVal));
+
+    fb303::fbData->addStatValue(
+        "link_monitor.advertise_adjacencies", 1, fb303::SUM);
+  }
 
   // Config is most likely to have changed. Update it in `ConfigStore`
   configStore_->storeThriftObj(kConfigKey, state_); // not awaiting on result
 
   // Update some flat counters
-  fb303::fbData->addStatValue(
-      "link_monitor.advertise_adjacencies", 1, fb303::SUM);
   fb303::fbData->setCounter("link_monitor.adjacencies", getTotalAdjacencies());
   for (const auto& [_, areaAdjacencies] : adjacencies_) {
     for (const auto& [_, adjValue] : areaAdjacencies) {
@@ -764,25 +855,49 @@ void
 LinkMonitor::advertiseInterfaces() {
   fb303::fbData->addStatValue("link_monitor.advertise_links", 1, fb303::SUM);
 
-  // Create interface database
-  InterfaceDatabase ifDb;
-  for (auto& [_, interface] : interfaces_) {
-    // Perform regex match
-    if (not anyAreaShouldDiscoverOnIface(interface.getIfName())) {
+  // Only interfaces changed since last advertisement are published, except
+  // for the very first advertisement which carries the full snapshot.
+  InterfaceDatabaseDelta ifDbDelta;
+  ifDbDelta.isFullSync = not initialLinksDiscovered_;
+
+  for (auto& [ifName, interface] : interfaces_) {
+    // Perform regex match (cached per interface name)
+    if (not anyAreaShouldDiscoverOnIface(ifName)) {
       continue;
     }
+
+    // ATTN: `UP` status is overridden by interface being active, i.e. UP and
+    // not backed off
+    const bool isActive = interface.isActive();
+
+    // Skip interface with no change since last advertisement. Compare in
+    // place to avoid copying networks of every interface.
+    auto it = advertisedInterfaces_.find(ifName);
+    if (it != advertisedInterfaces_.end() and it->second.isUp == isActive and
+        it->second.ifIndex == interface.getIfIndex() and
+        it->second.networks == interface.getNetworks()) {
+      if (ifDbDelta.isFullSync) {
+        ifDbDelta.updatedInterfaces.emplace_back(it->second);
+      }
+      continue;
+    }
+
     // Transform to `InterfaceInfo` object
     auto interfaceInfo = interface.getInterfaceInfo();
+    interfaceInfo.isUp = isActive;
 
-    // Override `UP` status
-    interfaceInfo.isUp = interface.isActive();
-
-    // Construct `InterfaceDatabase` object
-    ifDb.emplace_back(std::move(interfaceInfo));
+    advertisedInterfaces_.insert_or_assign(ifName, interfaceInfo);
+    ifDbDelta.updatedInterfaces.emplace_back(std::move(interfaceInfo));
   }
 
   // Publish via replicate queue
-  interfaceUpdatesQueue_.push(std::move(ifDb));
+  if (not ifDbDelta.empty()) {
+    fb303::fbData->addStatValue(
+        "link_monitor.advertise_links.updated_interfaces",
+        ifDbDelta.updatedInterfaces.size(),
+        fb303::SUM);
+    interfaceUpdatesQueue_.push(std::move(ifDbDelta));
+  }
 
   // Mark `initialLinkDiscovered_` for the first call upon initialization
   if (not initialLinksDiscovered_) {
@@ -907,10 +1022,14 @@ LinkMonitor::advertiseRedistAddrs() {
 std::chrono::milliseconds
 LinkMonitor::getRetryTimeOnUnstableInterfaces() {
   std::chrono::milliseconds minRemainMs{0};
+  size_t numSuppressedIfaces{0};
   for (auto& [_, interface] : interfaces_) {
     if (interface.isActive()) {
       continue;
     }
+    if (interface.isDampingSuppressed()) {
+      ++numSuppressedIfaces;
+    }
 
     const auto& curRemainMs = interface.getBackoffDuration();
     if (curRemainMs.count() > 0) {
@@ -920,6 +1039,8 @@ LinkMonitor::getRetryTimeOnUnstableInterfaces() {
     }
   }
 
+  fb303::fbData->setCounter(
+      "link_monitor.flap_damping.suppressed_interfaces", numSuppressedIfaces);
   return minRemainMs;
 }
 
@@ -947,9 +1068,25 @@ LinkMonitor::buildAdjacencyDatabase(const std::string& area) {
 
   // populate thrift::AdjacencyDatabase.adjacencies based on
   // various condition.
+  std::chrono::milliseconds minReuseMs{0};
+  size_t numSuppressedAdjs{0};
   auto areaAdjIt = adjacencies_.find(area);
   if (areaAdjIt != adjacencies_.end()) {
     for (auto& [adjKey, adjValue] : areaAdjIt->second) {
+      // [Flap-Damping] withhold adjacency suppressed by flap damping
+      if (auto reuseMs = getAdjDampingReuseTime(area, adjKey);
+          reuseMs.count() != 0) {
+        XLOG(DBG1) << fmt::format(
+            "Adjacency [{}, {}] suppressed by flap damping for {}ms",
+            adjKey.first,
+            adjKey.second,
+            reuseMs.count());
+        minReuseMs = minReuseMs.count() ? std::min(minReuseMs, reuseMs)
+                                        : reuseMs;
+        ++numSuppressedAdjs;
+        continue;
+      }
+
       // NOTE: copy on purpose
       auto adj = folly::copy(adjValue.adj_);
 
@@ -994,6 +1131,19 @@ LinkMonitor::buildAdjacencyDatabase(const std::string& area) {
     }
   }
 
+  fb303::fbData->setCounter(
+      fmt::format("link_monitor.flap_damping.suppressed_adjacencies.{}", area),
+      numSuppressedAdjs);
+  if (minReuseMs.count() != 0) {
+    // ATTN: keep the earliest reuse time across areas
+    const auto reuseTime = std::chrono::steady_clock::now() + minReuseMs;
+    if (not adjDampingReuseTimer_->isScheduled() or
+        reuseTime < adjDampingReuseTime_) {
+      adjDampingReuseTime_ = reuseTime;
+      adjDampingReuseTimer_->scheduleTimeout(minReuseMs);
+    }
+  }
+
   // Add perf information if enabled
   if (enablePerfMeasurement_) {
     thrift::PerfEvents perfEvents;
@@ -1028,7 +1178,8 @@ LinkMonitor::getOrCreateInterfaceEntry(const std::string& ifName) {
           linkflapInitBackoff_,
           linkflapMaxBackoff_,
           *advertiseIfaceAddrThrottled_,
-          *advertiseIfaceAddrTimer_));
+          *advertiseIfaceAddrTimer_,
+          interfaceDampingConfig_));
 
   return &(res.first->second);
 }
@@ -1041,6 +1192,12 @@ LinkMonitor::syncInterfaceTask() noexcept {
   // small amount of time when thread starts before syncing
   std::chrono::milliseconds timeout{expBackoff_.getInitialBackoff()};
 
+  // Interfaces are tracked via netlink LINK/ADDR events. Full dump is only
+  // performed at startup, upon detected loss of events, or upon audit interval
+  bool syncRequired{true};
+  auto lastSyncTime = std::chrono::steady_clock::now();
+  auto lastEventLossCount = nlSock_->getEventLossCount();
+
   while (true) { // Break when stop signal is ready
     // Sleep before next check
     if (syncInterfaceStopSignal_.try_wait_for(timeout)) {
@@ -1049,14 +1206,43 @@ LinkMonitor::syncInterfaceTask() noexcept {
       syncInterfaceStopSignal_.reset(); // Baton experienced timeout
     }
 
+    // Check for gap in netlink event stream
+    const auto eventLossCount = nlSock_->getEventLossCount();
+    if (eventLossCount != lastEventLossCount) {
+      XLOG(WARNING) << fmt::format(
+          "[Interface Sync] Detected {} netlink event loss(es). Resyncing interfaceDb.",
+          eventLossCount - lastEventLossCount);
+      fb303::fbData->addStatValue(
+          "link_monitor.sync_interface.event_loss", 1, fb303::SUM);
+      lastEventLossCount = eventLossCount;
+      syncRequired = true;
+    }
+
+    // Periodic audit as safety net
+    if (std::chrono::steady_clock::now() - lastSyncTime >=
+        Constants::kInterfaceAuditInterval) {
+      XLOG(INFO) << "[Interface Sync] Audit interval expired. Resyncing.";
+      syncRequired = true;
+    }
+
+    if (not syncRequired) {
+      timeout = Constants::kNetlinkEventLossCheckInterval;
+      continue;
+    }
+
     auto success = syncInterfaces();
     if (success) {
       expBackoff_.reportSuccess();
-      timeout = std::chrono::milliseconds(Constants::kPlatformSyncInterval);
+      syncRequired = false;
+      lastSyncTime = std::chrono::steady_clock::now();
+      timeout = Constants::kNetlinkEventLossCheckInterval;
+
+      fb303::fbData->addStatValue(
+          "link_monitor.sync_interface.success", 1, fb303::SUM);
 
       XLOG(DBG2) << fmt::format(
-          "[Interface Sync] Successfully synced interfaceDb. Schedule next sync in {}ms",
-          timeout.count());
+          "[Interface Sync] Successfully synced interfaceDb. Next audit in {}s",
+          Constants::kInterfaceAuditInterval.count());
     } else {
       // Apply exponential backoff and schedule next run
       expBackoff_.reportError();
@@ -1076,77 +1262,135 @@ LinkMonitor::syncInterfaceTask() noexcept {
 
 bool
 LinkMonitor::syncInterfaces() {
-  // Retrieve latest link snapshot from NetlinkProtocolSocket
-  folly::Try<InterfaceDatabase> maybeIfDb;
-  try {
-    maybeIfDb = semifuture_getAllLinks().getTry(Constants::kReadTimeout);
-    if (not maybeIfDb.hasValue()) {
-      XLOG(ERR) << fmt::format(
-          "[Interface Sync] Failed to sync interfaceDb. Exception: {}",
-          folly::exceptionStr(maybeIfDb.exception()));
+  // Networks of every interface in the dump. Once address dump completes, it
+  // is used to remove addresses which no longer exist.
+  std::unordered_map<
+      std::string /* ifName */,
+      std::unordered_set<folly::CIDRNetwork>>
+      dumpedNetworks;
+  std::unordered_set<std::string> correctedIfNames;
+
+  // ATTN: links and addresses are streamed from netlink and applied as they
+  // are received instead of buffering the entire dump
+  auto status = streamDump<fbnl::Link>(
+      [this](auto&& linkCb) {
+        return nlSock_->streamAllLinks(std::move(linkCb));
+      },
+      [&](fbnl::Link&& link) {
+        const auto& ifName = link.getLinkName();
+
+        // update cache of ifIndex -> ifName mapping
+        //  1) if ifIndex exists, override it with new ifName;
+        //  2) if ifIndex does NOT exist, cache the ifName;
+        ifIndexToName_[link.getIfIndex()] = ifName;
+        dumpedNetworks.try_emplace(ifName);
+
+        // Get interface entry
+        auto interfaceEntry = getOrCreateInterfaceEntry(ifName);
+        if (not interfaceEntry) {
+          return;
+        }
 
-      return false;
-    }
-  } catch (const folly::FutureTimeout&) {
-    XLOG(ERR)
-        << "[Interface Sync] Timeout retrieving links. Retry in a moment.";
+        // Update link attributes
+        const bool wasUp = interfaceEntry->isUp();
+        if (interfaceEntry->updateAttrs(link.getIfIndex(), link.isUp())) {
+          correctedIfNames.emplace(ifName);
+        }
 
+        // Event logging
+        logLinkEvent(
+            interfaceEntry->getIfName(),
+            wasUp,
+            interfaceEntry->isUp(),
+            interfaceEntry->getBackoffDuration());
+      });
+  if (not checkDumpStatus(status, "links")) {
     return false;
   }
 
   // ATTN: treat empty link as failure to make sure LinkMonitor can keep
   // retrying to retrieve data from underneath platform.
-  InterfaceDatabase ifDb = maybeIfDb.value();
-  if (ifDb.empty()) {
+  if (dumpedNetworks.empty()) {
     XLOG(ERR) << "[Interface Sync] No interface found. Retry in a moment.";
     return false;
   }
 
   XLOG(INFO) << fmt::format(
       "[Interface Sync] Successfully retrieved {} links from netlink.",
-      ifDb.size());
+      dumpedNetworks.size());
+
+  // Add new addresses
+  status = streamDump<fbnl::IfAddress>(
+      [this](auto&& addrCb) {
+        return nlSock_->streamAllIfAddresses(std::move(addrCb));
+      },
+      [&](fbnl::IfAddress&& addr) {
+        auto it = ifIndexToName_.find(addr.getIfIndex());
+        if (it == ifIndexToName_.end() or not addr.getPrefix().has_value()) {
+          return;
+        }
 
-  // Make updates in InterfaceEntry objects
-  for (const auto& info : ifDb) {
-    // update cache of ifIndex -> ifName mapping
-    //  1) if ifIndex exists, override it with new ifName;
-    //  2) if ifIndex does NOT exist, cache the ifName;
-    ifIndexToName_[info.ifIndex] = info.ifName;
+        // ATTN: link created after link dump is tracked via its events
+        auto networksIt = dumpedNetworks.find(it->second);
+        if (networksIt == dumpedNetworks.end()) {
+          return;
+        }
+        networksIt->second.emplace(addr.getPrefix().value());
 
-    // Get interface entry
-    auto interfaceEntry = getOrCreateInterfaceEntry(info.ifName);
+        auto interfaceEntry = getOrCreateInterfaceEntry(it->second);
+        if (interfaceEntry and
+            interfaceEntry->updateAddr(addr.getPrefix().value(), true)) {
+          correctedIfNames.emplace(it->second);
+        }
+      });
+  if (not checkDumpStatus(status, "addresses")) {
+    return false;
+  }
+
+  // Remove old addresses if they are not in dump
+  for (const auto& [ifName, networks] : dumpedNetworks) {
+    auto interfaceEntry = getOrCreateInterfaceEntry(ifName);
     if (not interfaceEntry) {
       continue;
     }
-
     const auto oldNetworks =
         interfaceEntry->getNetworks(); // NOTE: Copy intended
-    const auto& newNetworks = info.networks;
-
-    // Update link attributes
-    const bool wasUp = interfaceEntry->isUp();
-    interfaceEntry->updateAttrs(info.ifIndex, info.isUp);
-
-    // Event logging
-    logLinkEvent(
-        interfaceEntry->getIfName(),
-        wasUp,
-        interfaceEntry->isUp(),
-        interfaceEntry->getBackoffDuration());
-
-    // Remove old addresses if they are not in new
     for (auto const& oldNetwork : oldNetworks) {
-      if (newNetworks.count(oldNetwork) == 0) {
-        interfaceEntry->updateAddr(oldNetwork, false);
+      if (networks.count(oldNetwork) == 0 and
+          interfaceEntry->updateAddr(oldNetwork, false)) {
+        correctedIfNames.emplace(ifName);
       }
     }
+  }
 
-    // Add new addresses if they are not in old
-    for (auto const& newNetwork : newNetworks) {
-      if (oldNetworks.count(newNetwork) == 0) {
-        interfaceEntry->updateAddr(newNetwork, true);
-      }
-    }
+  // ATTN: after initial sync, interfaces corrected by full dump indicate
+  // netlink events missed without being detected
+  if (initialLinksDiscovered_) {
+    fb303::fbData->addStatValue(
+        "link_monitor.sync_interface.corrected_interfaces",
+        correctedIfNames.size(),
+        fb303::SUM);
+  }
+  return true;
+}
+
+bool
+LinkMonitor::checkDumpStatus(int status, std::string const& objects) {
+  if (status == -ENOBUFS) {
+    // Changes to objects already dumped might have been lost with the events
+    XLOG(WARNING) << fmt::format(
+        "[Interface Sync] Netlink events lost while dumping {}. Restart dump.",
+        objects);
+    fb303::fbData->addStatValue(
+        "link_monitor.sync_interface.dump_interrupted", 1, fb303::SUM);
+    return false;
+  }
+  if (status != 0) {
+    XLOG(ERR) << fmt::format(
+        "[Interface Sync] Failed to dump {}. Error: {}",
+        objects,
+        folly::errnoStr(-status));
+    return false;
   }
   return true;
 }
@@ -1216,6 +1460,11 @@ LinkMonitor::processNeighborEvents(NeighborEvents&& events) {
                << " Area:" << area
                << " Event Type: " << toString(event.eventType);
 
+    ScopedTraceSpan span(event.traceId, "link_monitor.neighbor_event");
+    if (event.traceId != 0) {
+      adjPendingTraceIds_.emplace(area, event.traceId);
+    }
+
     switch (event.eventType) {
     case NeighborEventType::NEIGHBOR_UP:
       logNeighborEvent(event);
@@ -1637,6 +1886,14 @@ LinkMonitor::semifuture_getInterfaces() {
         ifDetails.linkFlapBackOffMs().reset();
       }
 
+      // Add link flap damping state
+      if (interfaceDampingConfig_.has_value()) {
+        ifDetails.linkFlapDampingPenalty() =
+            static_cast<int64_t>(interface.getDampingPenalty());
+      }
+      ifDetails.isLinkFlapDampingSuppressed() =
+          interface.isDampingSuppressed();
+
       reply.interfaceDetails()->emplace(ifName, std::move(ifDetails));
     }
     p.setValue(std::make_unique<thrift::DumpLinksReply>(std::move(reply)));
@@ -1767,7 +2024,7 @@ LinkMonitor::logLinkEvent(
   sample.addString("interface", iface);
   sample.addInt("backoff_ms", backoffTime.count());
 
-  logSampleQueue_.push(sample);
+  logSampleQueue_.push(std::move(sample));
 
   SYSLOG(INFO) << "Interface " << iface << " is " << event
                << " and has backoff of " << backoffTime.count() << "ms";
@@ -1787,7 +2044,7 @@ LinkMonitor::logPeerEvent(
   sample.addString("peer_addr", peerAddr);
   sample.addInt("ctrl_port", ctrlPort);
 
-  logSampleQueue_.push(sample);
+  logSampleQueue_.push(std::move(sample));
 
   SYSLOG(INFO) << "[" << event << "] for " << peerName
                << " with address: " << peerAddr
@@ -1795,20 +2052,32 @@ LinkMonitor::logPeerEvent(
 }
 
 bool
-LinkMonitor::anyAreaShouldDiscoverOnIface(std::string const& iface) const {
+LinkMonitor::anyAreaShouldDiscoverOnIface(std::string const& iface) {
+  auto it = discoverOnIfaceCache_.find(iface);
+  if (it != discoverOnIfaceCache_.end()) {
+    return it->second;
+  }
+
   bool anyMatch = false;
   for (auto const& [_, areaConf] : areas_) {
     anyMatch |= areaConf.shouldDiscoverOnIface(iface);
   }
+  discoverOnIfaceCache_.emplace(iface, anyMatch);
   return anyMatch;
 }
 
 bool
-LinkMonitor::anyAreaShouldRedistributeIface(std::string const& iface) const {
+LinkMonitor::anyAreaShouldRedistributeIface(std::string const& iface) {
+  auto it = redistributeIfaceCache_.find(iface);
+  if (it != redistributeIfaceCache_.end()) {
+    return it->second;
+  }
+
   bool anyMatch = false;
   for (auto const& [_, areaConf] : areas_) {
     anyMatch |= areaConf.shouldRedistributeIface(iface);
   }
+  redistributeIfaceCache_.emplace(iface, anyMatch);
   return anyMatch;
 }
 
@@ -1824,10 +2093,69 @@ LinkMonitor::getStaticNodeSegmentLabel(
   return 0;
 }
 
+void
+LinkMonitor::reportAdjFlap(const std::string& area, const AdjacencyKey& adjId) {
+  if (not adjDampingConfig_.has_value()) {
+    return;
+  }
+
+  // Garbage collect fully decayed state in the area
+  auto& areaDamping = adjFlapDamping_[area];
+  for (auto it = areaDamping.begin(); it != areaDamping.end();) {
+    if (it->second.isDecayed()) {
+      it = areaDamping.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto it = areaDamping.try_emplace(adjId, *adjDampingConfig_).first;
+  if (it->second.reportFlap()) {
+    XLOG(INFO) << fmt::format(
+        "Adjacency [{}, {}] in area {} is suppressed by flap damping for {}ms",
+        adjId.first,
+        adjId.second,
+        area,
+        it->second.getTimeUntilReuse().count());
+    fb303::fbData->addStatValue(
+        "link_monitor.flap_damping.adjacency_suppressed", 1, fb303::SUM);
+  }
+}
+
+std::chrono::milliseconds
+LinkMonitor::getAdjDampingReuseTime(
+    const std::string& area, const AdjacencyKey& adjId) {
+  auto areaIt = adjFlapDamping_.find(area);
+  if (areaIt == adjFlapDamping_.end()) {
+    return std::chrono::milliseconds(0);
+  }
+  auto it = areaIt->second.find(adjId);
+  if (it == areaIt->second.end() or not it->second.isSuppressed()) {
+    return std::chrono::milliseconds(0);
+  }
+  return it->second.getTimeUntilReuse();
+}
+
+void
+LinkMonitor::scheduleAdvertiseAdjacencies(const std::string& area) {
+  adjPendingAreas_.emplace(area);
+  advertiseAdjacenciesThrottled_->operator()();
+}
+
 void
 LinkMonitor::scheduleAdvertiseAdjAllArea() {
   for (const auto& [area, _] : areas_) {
-    advertiseAdjacenciesThrottledPerArea_.at(area)->operator()();
+    adjPendingAreas_.emplace(area);
+  }
+  advertiseAdjacenciesThrottled_->operator()();
+}
+
+void
+LinkMonitor::advertisePendingAdjacencies() {
+  // ATTN: advertiseAdjacencies(area) erases area from pending set
+  auto pendingAreas = adjPendingAreas_;
+  for (const auto& area : pendingAreas) {
+    advertiseAdjacencies(area);
   }
 }
 
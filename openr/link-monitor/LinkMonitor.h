@@ -14,6 +14,7 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/AsyncThrottle.h>
+#include <openr/common/FlapDamping.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/common/Types.h>
 #include <openr/config-store/PersistentStore.h>
@@ -71,7 +72,7 @@ class LinkMonitor final : public OpenrEventBase {
       fbnl::NetlinkProtocolSocket* nlSock,
       PersistentStore* configStore,
       // producer queue
-      messaging::ReplicateQueue<InterfaceDatabase>& interfaceUpdatesQueue,
+      messaging::ReplicateQueue<InterfaceDatabaseDelta>& interfaceUpdatesQueue,
       messaging::ReplicateQueue<PrefixEvent>& prefixUpdatesQueue,
       messaging::ReplicateQueue<PeerEvent>& peerUpdatesQueue,
       messaging::ReplicateQueue<LogSample>& logSampleQueue,
@@ -195,9 +196,15 @@ class LinkMonitor final : public OpenrEventBase {
   void processLinkEvent(fbnl::Link&& link);
   void processAddressEvent(fbnl::IfAddress&& addr);
 
+  // Full interface sync from netlink dump. Performed at startup, upon netlink
+  // event loss being detected, and upon kInterfaceAuditInterval. Interface
+  // state is otherwise maintained via LINK/ADDRESS events.
   void syncInterfaceTask() noexcept;
   bool syncInterfaces();
 
+  // Log failure of streamed netlink dump. Return true if dump succeeded.
+  bool checkDumpStatus(int status, std::string const& objects);
+
   // Get or create InterfaceEntry object.
   // Returns nullptr if ifName doesn't qualify regex match
   // used in syncInterfaces() and LINK/ADDRESS EVENT
@@ -237,11 +244,22 @@ class LinkMonitor final : public OpenrEventBase {
    */
   void advertiseAdjacencies(const std::string& area);
   void advertiseAdjacencies(); // Advertise my adjacencies_ in to all areas
+
+  /*
+   * [Kvstore] Throttled version of advertiseAdjacencies(area)
+   *
+   * Mark area(s) as pending and advertise all pending areas in one throttled
+   * pass, coalescing changes triggered in several areas.
+   */
+  void scheduleAdvertiseAdjacencies(const std::string& area);
   void scheduleAdvertiseAdjAllArea();
+  void advertisePendingAdjacencies();
   /*
    * [Spark/Fib] Advertise interfaces_ over interfaceUpdatesQueue_ to Spark/Fib
    *
-   * Called in advertiseIfaceAddr() upon interface changes
+   * Called in advertiseIfaceAddr() upon interface changes. The very first
+   * publication carries the full interface snapshot, subsequent ones carry
+   * only interfaces changed since the last publication.
    */
   void advertiseInterfaces();
 
@@ -275,11 +293,20 @@ class LinkMonitor final : public OpenrEventBase {
   // build AdjacencyDatabase
   thrift::AdjacencyDatabase buildAdjacencyDatabase(const std::string& area);
 
+  // [Flap-Damping] add penalty on adjacency going down
+  void reportAdjFlap(const std::string& area, const AdjacencyKey& adjId);
+
+  // [Flap-Damping] remaining suppression of adjacency. 0 if not suppressed.
+  std::chrono::milliseconds getAdjDampingReuseTime(
+      const std::string& area, const AdjacencyKey& adjId);
+
   // returns any(a.shouldDiscoverOnIface(iface) for a in areas_)
-  bool anyAreaShouldDiscoverOnIface(std::string const& iface) const;
+  // NOTE: result is cached per interface name as areas_ is immutable
+  bool anyAreaShouldDiscoverOnIface(std::string const& iface);
 
   // returns any(a.anyAreaShouldRedistributeIface(iface) for a in areas_)
-  bool anyAreaShouldRedistributeIface(std::string const& iface) const;
+  // NOTE: result is cached per interface name as areas_ is immutable
+  bool anyAreaShouldRedistributeIface(std::string const& iface);
 
   // Total # of adjacencies stored.
   size_t getTotalAdjacencies();
@@ -346,7 +373,7 @@ class LinkMonitor final : public OpenrEventBase {
   thrift::LinkMonitorState state_;
 
   // Queue to publish interface updates to fib/spark
-  messaging::ReplicateQueue<InterfaceDatabase>& interfaceUpdatesQueue_;
+  messaging::ReplicateQueue<InterfaceDatabaseDelta>& interfaceUpdatesQueue_;
 
   // Queue to publish prefix updates to PrefixManager
   messaging::ReplicateQueue<PrefixEvent>& prefixUpdatesQueue_;
@@ -384,6 +411,17 @@ class LinkMonitor final : public OpenrEventBase {
   std::unordered_map<std::string /* interface name */, InterfaceEntry>
       interfaces_;
 
+  // Interfaces last advertised over interfaceUpdatesQueue_. Used to compute
+  // the delta for the next advertisement.
+  std::unordered_map<std::string /* interface name */, InterfaceInfo>
+      advertisedInterfaces_;
+
+  // Cache of per interface name regex match results against areas_
+  std::unordered_map<std::string /* interface name */, bool>
+      discoverOnIfaceCache_;
+  std::unordered_map<std::string /* interface name */, bool>
+      redistributeIfaceCache_;
+
   // Container storing map of advertised prefixes - Map<prefix, list<area>>
   std::map<folly::CIDRNetwork, std::vector<std::string>> advertisedPrefixes_;
 
@@ -394,10 +432,33 @@ class LinkMonitor final : public OpenrEventBase {
   // Throttled versions of "advertise<>" functions. It batches
   // up multiple calls and send them in one go!
 
-  // Advertise Adj needs per area throttle as KvStore calls can interrupt
-  // and cause race conditions, some batched call may otherwise be lost
-  std::unordered_map<std::string /* area */, std::unique_ptr<AsyncThrottle>>
-      advertiseAdjacenciesThrottledPerArea_;
+  // Advertise Adj is throttled across all areas. Areas with pending changes
+  // are tracked explicitly so that no per-area advertisement gets lost when
+  // KvStore calls interrupt the throttled pass.
+  std::unique_ptr<AsyncThrottle> advertiseAdjacenciesThrottled_;
+  std::unordered_set<std::string /* area */> adjPendingAreas_;
+  // Trace id of the oldest neighbor event not yet reflected in advertised
+  // adjacency database of the area
+  std::unordered_map<std::string /* area */, int64_t> adjPendingTraceIds_;
+
+  // Flap damping config for interfaces and adjacencies. Unset if disabled.
+  std::optional<thrift::FlapDampingConfig> interfaceDampingConfig_;
+  std::optional<thrift::FlapDampingConfig> adjDampingConfig_;
+
+  // Flap damping state per adjacency. Kept across adjacency down/up so that
+  // penalty accumulates, and garbage collected once fully decayed.
+  std::unordered_map<
+      std::string /* area */,
+      std::unordered_map<AdjacencyKey, FlapDamping>>
+      adjFlapDamping_;
+
+  // Timer to re-advertise adjacencies once suppressed ones can be reused
+  std::unique_ptr<folly::AsyncTimeout> adjDampingReuseTimer_;
+  std::chrono::steady_clock::time_point adjDampingReuseTime_;
+
+  // Last advertised encoding of `adj:<node-name>` per area. Used to suppress
+  // byte-identical re-advertisements into KvStore.
+  std::unordered_map<std::string /* area */, std::string> advertisedAdjDbs_;
   std::unique_ptr<AsyncThrottle> advertiseIfaceAddrThrottled_;
 
   // Timer for processing interfaces which are in backoff states
@@ -425,11 +425,22 @@ class LinkMonitorTestFixture : public testing::Test {
   // Receive and process interface updates from the update queue
   void
   recvAndReplyIfUpdate() {
-    auto ifDb = interfaceUpdatesReader.get();
-    ASSERT_TRUE(ifDb.hasValue());
+    auto ifDbDelta = interfaceUpdatesReader.get();
+    ASSERT_TRUE(ifDbDelta.hasValue());
+
+    // Apply delta on top of interfaces received so far, same as Spark does
+    if (ifDbDelta->isFullSync) {
+      sparkIfMap.clear();
+    }
+    for (const auto& info : ifDbDelta->updatedInterfaces) {
+      sparkIfMap.insert_or_assign(info.ifName, info);
+    }
 
     // ATTN: update class variable `sparkIfDb` for later verification
-    sparkIfDb = ifDb.value();
+    sparkIfDb.clear();
+    for (const auto& [_, info] : sparkIfMap) {
+      sparkIfDb.emplace_back(info);
+    }
     LOG(INFO) << "----------- Interface Updates ----------";
     for (const auto& info : sparkIfDb) {
       LOG(INFO) << "  Name=" << info.ifName << ", Status=" << info.isUp
@@ -635,7 +646,7 @@ class LinkMonitorTestFixture : public testing::Test {
   folly::EventBase nlEvb_;
   std::unique_ptr<fbnl::MockNetlinkProtocolSocket> nlSock{nullptr};
 
-  messaging::ReplicateQueue<InterfaceDatabase> interfaceUpdatesQueue;
+  messaging::ReplicateQueue<InterfaceDatabaseDelta> interfaceUpdatesQueue;
   messaging::ReplicateQueue<PeerEvent> peerUpdatesQueue;
   messaging::ReplicateQueue<KeyValueRequest> kvRequestQueue;
   messaging::ReplicateQueue<NeighborInitEvent> neighborUpdatesQueue;
@@ -645,7 +656,7 @@ class LinkMonitorTestFixture : public testing::Test {
   messaging::ReplicateQueue<DecisionRouteUpdate> staticRouteUpdatesQueue;
   messaging::ReplicateQueue<DecisionRouteUpdate> prefixMgrRouteUpdatesQueue;
   messaging::ReplicateQueue<DecisionRouteUpdate> fibRouteUpdatesQueue;
-  messaging::RQueue<InterfaceDatabase> interfaceUpdatesReader{
+  messaging::RQueue<InterfaceDatabaseDelta> interfaceUpdatesReader{
       interfaceUpdatesQueue.getReader()};
   messaging::ReplicateQueue<openr::LogSample> logSampleQueue;
 
@@ -669,6 +680,7 @@ class LinkMonitorTestFixture : public testing::Test {
 
   std::queue<thrift::AdjacencyDatabase> expectedAdjDbs;
   InterfaceDatabase sparkIfDb;
+  std::map<std::string, InterfaceInfo> sparkIfMap;
 
   // vector of thrift::AreaConfig
   std::vector<thrift::AreaConfig> areaConfigs_;
@@ -1530,6 +1542,10 @@ TEST_F(LinkMonitorTestFixture, NeighborGracefulRestartSuccess) {
 
     // no adj events
     CHECK_EQ(0, kvStoreWrapper->getReader().size());
+
+    // identical adjacency database is suppressed at origin
+    auto counters = facebook::fb303::fbData->getCounters();
+    EXPECT_GE(counters["link_monitor.advertise_adjacencies.suppressed.sum"], 1);
   }
 
   // neighbor 2 kvstore initial sync adj_2_1, adj_2_2 exit GR mode
@@ -1905,6 +1921,184 @@ TEST_F(DampenLinkTestFixture, DampenLinkFlaps) {
   }
 }
 
+class FlapDampingTestFixture : public LinkMonitorTestFixture {
+ public:
+  thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = LinkMonitorTestFixture::createConfig();
+
+    // two back-to-back flaps suppress, reuse after ~3s w/o further flaps
+    thrift::FlapDampingConfig dampingConfig;
+    dampingConfig.penalty_per_flap() = 1000;
+    dampingConfig.half_life_ms() = 2000;
+    dampingConfig.suppress_threshold() = 1500;
+    dampingConfig.reuse_threshold() = 750;
+    dampingConfig.max_suppress_ms() = 10000;
+
+    // override LM config
+    tConfig.link_monitor_config()->interface_flap_damping_config() =
+        dampingConfig;
+    tConfig.link_monitor_config()->adjacency_flap_damping_config() =
+        dampingConfig;
+
+    return tConfig;
+  }
+
+  static int64_t
+  getCounter(std::string const& key) {
+    auto counters = facebook::fb303::fbData->getCounters();
+    return counters.count(key) ? counters.at(key) : 0;
+  }
+
+  void
+  pushNeighborEvent(NeighborEvent const& event) {
+    auto neighborEvent = event;
+    neighborUpdatesQueue.push(
+        NeighborInitEvent(NeighborEvents({std::move(neighborEvent)})));
+  }
+};
+
+/*
+ * Flapping adjacency is withheld from adjacency database while suppressed,
+ * regardless of neighbor events received from Spark, and is re-advertised
+ * once its penalty decays below reuse threshold.
+ */
+TEST_F(FlapDampingTestFixture, AdjacencyFlapSuppression) {
+  const std::string suppressedKey{
+      "link_monitor.flap_damping.adjacency_suppressed.sum"};
+  const std::string dupAdvKey{
+      "link_monitor.advertise_adjacencies.suppressed.sum"};
+
+  // neighbor up on nb2 and nb3
+  {
+    pushNeighborEvent(nb2_up_event);
+    pushNeighborEvent(nb3_up_event);
+
+    expectedAdjDbs.push(createAdjDb("node-1", {adj_2_1, adj_3_1}, kNodeLabel));
+    checkNextAdjPub("adj:node-1");
+    EXPECT_EQ(0, getCounter(suppressedKey));
+  }
+
+  // nb2 flaps twice within throttle window and comes back up. Adjacency is
+  // suppressed and withheld despite being up.
+  {
+    pushNeighborEvent(nb2_down_event);
+    pushNeighborEvent(nb2_up_event);
+    pushNeighborEvent(nb2_down_event);
+    pushNeighborEvent(nb2_up_event);
+
+    expectedAdjDbs.push(createAdjDb("node-1", {adj_3_1}, kNodeLabel));
+    checkNextAdjPub("adj:node-1");
+    EXPECT_EQ(1, getCounter(suppressedKey));
+    EXPECT_EQ(
+        1,
+        getCounter(fmt::format(
+            "link_monitor.flap_damping.suppressed_adjacencies.{}",
+            kTestingAreaName.t)));
+  }
+
+  // nb2 keeps flapping. Adjacency stays withheld, hence the resulting
+  // adjacency database is identical and not re-advertised.
+  {
+    const auto numDupAdvs = getCounter(dupAdvKey);
+    pushNeighborEvent(nb2_down_event);
+    pushNeighborEvent(nb2_up_event);
+
+    checkUntilTimeout(
+        [&]() { return getCounter(dupAdvKey) > numDupAdvs; },
+        std::chrono::seconds(5));
+    EXPECT_EQ(1, getCounter(suppressedKey));
+
+    auto value = kvStoreWrapper->getKey(kTestingAreaName, "adj:node-1");
+    ASSERT_TRUE(value.has_value());
+    auto adjDb = readThriftObjStr<thrift::AdjacencyDatabase>(
+        value->value().value(), serializer);
+    ASSERT_EQ(1, adjDb.adjacencies()->size());
+    EXPECT_EQ("node-3", *adjDb.adjacencies()->at(0).otherNodeName());
+  }
+
+  // Penalty decays below reuse threshold without further flaps, adjacency is
+  // re-advertised without any new neighbor event.
+  {
+    const auto startTime = std::chrono::steady_clock::now();
+    expectedAdjDbs.push(createAdjDb("node-1", {adj_2_1, adj_3_1}, kNodeLabel));
+    checkNextAdjPub("adj:node-1");
+    EXPECT_GE(
+        std::chrono::steady_clock::now() - startTime,
+        std::chrono::seconds(1));
+    EXPECT_EQ(
+        0,
+        getCounter(fmt::format(
+            "link_monitor.flap_damping.suppressed_adjacencies.{}",
+            kTestingAreaName.t)));
+  }
+}
+
+/*
+ * Flapping interface is reported DOWN to Spark while suppressed, even though
+ * link is UP, and is reported UP once its penalty decays below reuse
+ * threshold.
+ */
+TEST_F(FlapDampingTestFixture, InterfaceFlapSuppression) {
+  const std::string linkX = kTestVethNamePrefix + "X";
+  const std::string suppressedKey{
+      "link_monitor.flap_damping.interface_suppressed.sum"};
+
+  // receive interface updates until linkX is reported in expected state
+  auto waitForIfState = [&](bool isUp) {
+    do {
+      recvAndReplyIfUpdate();
+    } while (not sparkIfMap.count(linkX) or sparkIfMap.at(linkX).isUp != isUp);
+  };
+  auto isSuppressed = [&]() {
+    auto links = linkMonitor->semifuture_getInterfaces().get();
+    return *links->interfaceDetails()->at(linkX).isLinkFlapDampingSuppressed();
+  };
+
+  nlEventsInjector->sendLinkEvent(
+      linkX /* link name */,
+      kTestVethIfIndex[0] /* ifIndex */,
+      false /* is up */);
+  waitForIfState(false);
+
+  // flap twice, second flap suppresses the interface
+  for (int i = 0; i < 2; ++i) {
+    nlEventsInjector->sendLinkEvent(
+        linkX /* link name */,
+        kTestVethIfIndex[0] /* ifIndex */,
+        true /* is up */);
+    waitForIfState(true);
+
+    nlEventsInjector->sendLinkEvent(
+        linkX /* link name */,
+        kTestVethIfIndex[0] /* ifIndex */,
+        false /* is up */);
+    waitForIfState(false);
+  }
+  const auto suppressTime = std::chrono::steady_clock::now();
+  EXPECT_EQ(1, getCounter(suppressedKey));
+  EXPECT_TRUE(isSuppressed());
+
+  // link comes back UP, but it is withheld from Spark
+  nlEventsInjector->sendLinkEvent(
+      linkX /* link name */,
+      kTestVethIfIndex[0] /* ifIndex */,
+      true /* is up */);
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  EXPECT_EQ(0, interfaceUpdatesReader.size());
+  EXPECT_TRUE(isSuppressed());
+  EXPECT_EQ(1, getCounter("link_monitor.flap_damping.suppressed_interfaces"));
+
+  // penalty decays below reuse threshold, interface is reported UP
+  waitForIfState(true);
+  EXPECT_GE(
+      std::chrono::steady_clock::now() - suppressTime,
+      std::chrono::seconds(2));
+  EXPECT_FALSE(isSuppressed());
+  EXPECT_EQ(1, getCounter(suppressedKey));
+}
+
 // Test Interface events to Spark
 TEST_F(LinkMonitorTestFixture, verifyLinkEventSubscription) {
   const std::string linkX = kTestVethNamePrefix + "X";
@@ -2136,6 +2330,59 @@ TEST_F(LinkMonitorTestFixture, verifyAddrEventSubscription) {
   }
 }
 
+/*
+ * Netlink events lost to socket receive buffer overrun (ENOBUFS) must trigger
+ * full resync of interfaces. Events lost while the dump is in progress must
+ * restart the dump.
+ */
+TEST_F(LinkMonitorTestFixture, ResyncOnNetlinkEventLoss) {
+  const std::string linkX = kTestVethNamePrefix + "X";
+  const std::string successKey{"link_monitor.sync_interface.success.sum"};
+  const std::string interruptedKey{
+      "link_monitor.sync_interface.dump_interrupted.sum"};
+  auto getCounter = [](std::string const& key) {
+    auto counters = facebook::fb303::fbData->getCounters();
+    return counters.count(key) ? counters.at(key) : 0;
+  };
+
+  nlEventsInjector->sendLinkEvent(
+      linkX /* link name */,
+      kTestVethIfIndex[0] /* ifIndex */,
+      false /* is up */);
+  recvAndReplyIfUpdate();
+
+  // Wait for initial interface sync, retried with backoff until link exists
+  checkUntilTimeout(
+      [&]() { return getCounter(successKey) >= 1; },
+      std::chrono::seconds(20));
+  const auto numSyncs = getCounter(successKey);
+
+  // Link goes UP but its event is lost. Loss is reported once while resync
+  // dump is in progress, failing that dump.
+  nlSock
+      ->addLink(
+          fbnl::utils::createLink(kTestVethIfIndex[0], linkX, true /* isUp */),
+          false /* publishEvent */)
+      .get();
+  nlSock->injectEventLoss(true /* duringDump */);
+  nlSock->injectEventLoss();
+
+  // Interface state is corrected by full resync
+  recvAndReplyIfUpdate();
+  EXPECT_NO_THROW({
+    auto res = collateIfUpdates(sparkIfDb);
+    EXPECT_EQ(1, res.size());
+    EXPECT_EQ(1, res.at(linkX).isUpCount);
+    EXPECT_EQ(0, res.at(linkX).isDownCount);
+  });
+
+  // Interrupted dump got restarted
+  checkUntilTimeout(
+      [&]() { return getCounter(successKey) == numSyncs + 1; },
+      std::chrono::seconds(20));
+  EXPECT_EQ(1, getCounter(interruptedKey));
+}
+
 class StaticNodeLabelTestFixture : public LinkMonitorTestFixture {
  public:
   std::vector<thrift::AreaConfig>
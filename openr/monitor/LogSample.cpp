@@ -7,7 +7,8 @@
 
 #include "openr/monitor/LogSample.h"
 
-#include <folly/DynamicConverter.h>
+#include <fmt/format.h>
+#include <folly/dynamic.h>
 #include <folly/json.h>
 
 namespace {
@@ -23,6 +24,76 @@ const std::string STRINGTAGSET_KEY{"tagset"};
 
 const std::string kTimeCol{"time"};
 
+template <typename Fields>
+auto
+findField(const Fields& fields, folly::StringPiece key)
+    -> const decltype(fields.begin()->second)* {
+  for (auto const& [fieldKey, value] : fields) {
+    if (key == fieldKey) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Fields, typename V>
+void
+setField(Fields& fields, folly::StringPiece key, V&& value) {
+  for (auto& [fieldKey, fieldValue] : fields) {
+    if (key == fieldKey) {
+      fieldValue = std::forward<V>(value);
+      return;
+    }
+  }
+  fields.emplace_back(key.str(), std::forward<V>(value));
+}
+
+template <typename Fields>
+auto
+getField(
+    const Fields& fields, folly::StringPiece keyType, folly::StringPiece key)
+    -> const decltype(fields.begin()->second)& {
+  if (auto value = findField(fields, key)) {
+    return *value;
+  }
+
+  throw std::invalid_argument(
+      fmt::format("invalid key: {} with keyType: {} ", key, keyType));
+}
+
+template <typename T>
+folly::dynamic
+toDynamic(const T& value) {
+  return folly::dynamic(value);
+}
+
+template <typename T>
+folly::dynamic
+toDynamic(const std::vector<T>& values) {
+  return folly::dynamic(values.begin(), values.end());
+}
+
+template <typename T>
+folly::dynamic
+toDynamic(const std::set<T>& values) {
+  return folly::dynamic(values.begin(), values.end());
+}
+
+// Render typed fields as json object, nothing if there is no field
+template <typename Fields>
+void
+insertFields(
+    const Fields& fields, const std::string& keyType, folly::dynamic& json) {
+  if (fields.empty()) {
+    return;
+  }
+  auto obj = folly::dynamic::object();
+  for (auto const& [key, value] : fields) {
+    obj.insert(key, toDynamic(value));
+  }
+  json.insert(keyType, std::move(obj));
+}
+
 } // anonymous namespace
 
 namespace openr {
@@ -31,9 +102,7 @@ LogSample::LogSample() : LogSample(std::chrono::system_clock::now()) {}
 
 LogSample::LogSample(std::chrono::system_clock::time_point timestamp)
     : timestamp_(timestamp) {
-  json_ = folly::dynamic::object;
-
-  // add the timestamp to the json sample
+  // add the timestamp to the sample
   addInt(
       kTimeCol,
       std::chrono::duration_cast<std::chrono::seconds>(
@@ -41,149 +110,136 @@ LogSample::LogSample(std::chrono::system_clock::time_point timestamp)
           .count());
 }
 
-LogSample::LogSample(
-    folly::dynamic json, std::chrono::system_clock::time_point timestamp)
-    : json_(json), timestamp_(timestamp) {}
-
 LogSample
 LogSample::fromJson(const std::string& json) {
   auto dynamic = folly::parseJson(json);
   // will throw if this sample doesn't have a timestamp
-  auto timestamp = std::chrono::system_clock::time_point(
-      std::chrono::seconds(dynamic[INT_KEY][kTimeCol].getInt()));
-  return LogSample(dynamic, timestamp);
+  LogSample sample(std::chrono::system_clock::time_point(
+      std::chrono::seconds(dynamic[INT_KEY][kTimeCol].getInt())));
+
+  for (auto const& [key, value] : dynamic[INT_KEY].items()) {
+    sample.addInt(key.getString(), value.asInt());
+  }
+  if (auto obj = dynamic.get_ptr(DOUBLE_KEY)) {
+    for (auto const& [key, value] : obj->items()) {
+      sample.addDouble(key.getString(), value.asDouble());
+    }
+  }
+  if (auto obj = dynamic.get_ptr(STRING_KEY)) {
+    for (auto const& [key, value] : obj->items()) {
+      sample.addString(key.getString(), value.getString());
+    }
+  }
+  if (auto obj = dynamic.get_ptr(STRINGVECTOR_KEY)) {
+    for (auto const& [key, value] : obj->items()) {
+      std::vector<std::string> values;
+      for (auto const& item : value) {
+        values.emplace_back(item.getString());
+      }
+      sample.addStringVector(key.getString(), values);
+    }
+  }
+  if (auto obj = dynamic.get_ptr(STRINGTAGSET_KEY)) {
+    for (auto const& [key, value] : obj->items()) {
+      std::set<std::string> tags;
+      for (auto const& item : value) {
+        tags.emplace(item.getString());
+      }
+      sample.addStringTagset(key.getString(), tags);
+    }
+  }
+  return sample;
 }
 
 std::string
 LogSample::toJson() const {
+  folly::dynamic json = folly::dynamic::object;
+  insertFields(ints_, INT_KEY, json);
+  insertFields(doubles_, DOUBLE_KEY, json);
+  insertFields(strings_, STRING_KEY, json);
+  insertFields(stringVectors_, STRINGVECTOR_KEY, json);
+  insertFields(stringTagsets_, STRINGTAGSET_KEY, json);
+
   folly::json::serialization_opts opts;
   opts.sort_keys = true;
-  return folly::json::serialize(json_, opts);
+  return folly::json::serialize(json, opts);
 }
 
 void
 LogSample::addInt(folly::StringPiece key, int64_t value) {
-  if (json_.find(INT_KEY) == json_.items().end()) {
-    json_.insert(INT_KEY, folly::dynamic::object());
-  }
-
-  json_[INT_KEY][key] = value;
+  setField(ints_, key, value);
 }
 
 void
 LogSample::addDouble(folly::StringPiece key, double value) {
-  if (json_.find(DOUBLE_KEY) == json_.items().end()) {
-    json_.insert(DOUBLE_KEY, folly::dynamic::object());
-  }
-
-  json_[DOUBLE_KEY][key] = value;
+  setField(doubles_, key, value);
 }
 
 void
 LogSample::addString(folly::StringPiece key, folly::StringPiece value) {
-  if (json_.find(STRING_KEY) == json_.items().end()) {
-    json_.insert(STRING_KEY, folly::dynamic::object());
-  }
-
-  json_[STRING_KEY][key] = value;
+  setField(strings_, key, value.str());
 }
 
 void
 LogSample::addStringVector(
     folly::StringPiece key, const std::vector<std::string>& values) {
-  if (json_.find(STRINGVECTOR_KEY) == json_.items().end()) {
-    json_.insert(STRINGVECTOR_KEY, folly::dynamic::object());
-  }
-
-  json_[STRINGVECTOR_KEY][key] = folly::dynamic(values.begin(), values.end());
+  setField(stringVectors_, key, values);
 }
 
 void
 LogSample::addStringTagset(
     folly::StringPiece key, const std::set<std::string>& tags) {
-  if (json_.find(STRINGTAGSET_KEY) == json_.items().end()) {
-    json_.insert(STRINGTAGSET_KEY, folly::dynamic::object());
-  }
-
-  json_[STRINGTAGSET_KEY][key] = folly::dynamic(tags.begin(), tags.end());
+  setField(stringTagsets_, key, tags);
 }
 
 int64_t
 LogSample::getInt(folly::StringPiece key) const {
-  return folly::convertTo<int64_t>(getInnerValue(INT_KEY, key));
+  return getField(ints_, INT_KEY, key);
 }
 
 double
 LogSample::getDouble(folly::StringPiece key) const {
-  return folly::convertTo<double>(getInnerValue(DOUBLE_KEY, key));
+  return getField(doubles_, DOUBLE_KEY, key);
 }
 
 std::string
 LogSample::getString(folly::StringPiece key) const {
-  return folly::convertTo<std::string>(getInnerValue(STRING_KEY, key));
+  return getField(strings_, STRING_KEY, key);
 }
 
 std::vector<std::string>
 LogSample::getStringVector(folly::StringPiece key) const {
-  return folly::convertTo<std::vector<std::string>>(
-      getInnerValue(STRINGVECTOR_KEY, key));
+  return getField(stringVectors_, STRINGVECTOR_KEY, key);
 }
 
 std::set<std::string>
 LogSample::getStringTagset(folly::StringPiece key) const {
-  return folly::convertTo<std::set<std::string>>(
-      getInnerValue(STRINGTAGSET_KEY, key));
+  return getField(stringTagsets_, STRINGTAGSET_KEY, key);
 }
 
 bool
 LogSample::isIntSet(folly::StringPiece key) const {
-  return isInnerValueSet(INT_KEY, key);
+  return findField(ints_, key) != nullptr;
 }
 
 bool
 LogSample::isDoubleSet(folly::StringPiece key) const {
-  return isInnerValueSet(DOUBLE_KEY, key);
+  return findField(doubles_, key) != nullptr;
 }
 
 bool
 LogSample::isStringSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRING_KEY, key);
+  return findField(strings_, key) != nullptr;
 }
 
 bool
 LogSample::isStringVectorSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRINGVECTOR_KEY, key);
+  return findField(stringVectors_, key) != nullptr;
 }
 
 bool
 LogSample::isStringTagsetSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRINGTAGSET_KEY, key);
-}
-
-bool
-LogSample::isInnerValueSet(
-    folly::StringPiece keyType, folly::StringPiece key) const {
-  if (auto obj = json_.get_ptr(keyType)) {
-    if (auto data = obj->get_ptr(key)) {
-      (void)data;
-      return true;
-    }
-  }
-
-  return false;
-}
-
-const folly::dynamic&
-LogSample::getInnerValue(
-    folly::StringPiece keyType, folly::StringPiece key) const {
-  if (auto obj = json_.get_ptr(keyType)) {
-    if (auto data = obj->get_ptr(key)) {
-      return *data;
-    }
-  }
-
-  throw std::invalid_argument(
-      fmt::format("invalid key: {} with keyType: {} ", key, keyType));
+  return findField(stringTagsets_, key) != nullptr;
 }
 
 } // namespace openr
@@ -13,7 +13,7 @@
 #include <vector>
 
 #include <folly/Range.h>
-#include <folly/dynamic.h>
+#include <folly/small_vector.h>
 
 namespace openr {
 
@@ -22,8 +22,10 @@ namespace openr {
  * application to easily create the events with many attriutes and send it
  * over wire to some central monitoring service.
  *
- * This class is strictly meant to make things easier for services to create
- * samples and serialize them to json objects.
+ * Attributes are stored as typed (binary) fields. JSON is ONLY rendered on
+ * demand via `toJson()`, i.e. when sample gets exported or queried, so that
+ * creating samples on hot paths (neighbor events, KvStore sync, route
+ * updates) stays cheap.
  *
  * Example usecase:
  *    LogSample sample(std::chrono::system_clock::now());
@@ -52,14 +54,11 @@ class LogSample {
    */
   explicit LogSample(std::chrono::system_clock::time_point timestamp);
 
-  LogSample(
-      folly::dynamic json, std::chrono::system_clock::time_point timestamp);
-
   static LogSample fromJson(const std::string& json);
 
   /**
    * Get json representation of the Sample. Can easily be sent to monitoring
-   * service over write.
+   * service over write. Keys are sorted, i.e. output is deterministic.
    */
   std::string toJson() const;
 
@@ -102,13 +101,16 @@ class LogSample {
   bool isStringTagsetSet(folly::StringPiece key) const;
 
  private:
-  bool isInnerValueSet(
-      folly::StringPiece keyType, folly::StringPiece key) const;
-  const folly::dynamic& getInnerValue(
-      folly::StringPiece keyType, folly::StringPiece key) const;
-
-  // Internal json representation of this sample
-  folly::dynamic json_ = folly::dynamic::object;
+  // Typed fields in insertion order. Samples carry a handful of attributes,
+  // linear lookup beats any map here.
+  template <typename T, size_t N>
+  using Fields = folly::small_vector<std::pair<std::string, T>, N>;
+
+  Fields<int64_t, 4> ints_;
+  Fields<double, 1> doubles_;
+  Fields<std::string, 6> strings_;
+  Fields<std::vector<std::string>, 1> stringVectors_;
+  Fields<std::set<std::string>, 1> stringTagsets_;
 
   // Timepoint associated with this sample
   std::chrono::system_clock::time_point timestamp_;
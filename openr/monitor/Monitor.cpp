@@ -9,6 +9,9 @@
 
 #include <folly/logging/xlog.h>
 
+#include <openr/common/Constants.h>
+#include <openr/common/Util.h>
+
 namespace openr {
 
 void
@@ -20,8 +23,15 @@ Monitor::processEventLog(LogSample const& eventLog) {
 
 void
 Monitor::dumpHeapProfile() {
-  XLOG(INFO)
-      << "Please add your own implementation to dump the heap memory profile.";
+  // NOTE: Could add your own implementation to upload profiles.
+  const auto filePath = fmt::format(
+      "{}.{}.heap", Constants::kHeapProfileFilePrefix, getUnixTimeStampMs());
+  auto ret = memory::dumpHeapProfile(filePath);
+  if (ret.hasError()) {
+    XLOG(ERR) << "Failed to dump heap profile: " << ret.error();
+    return;
+  }
+  XLOG(INFO) << "Dumped heap profile to " << filePath;
 }
 
 } // namespace openr
@@ -22,6 +22,9 @@ MonitorBase::MonitorBase(
   // Initialize stats counter
   fb303::fbData->addStatExportType("monitor.log.publish.failure", fb303::COUNT);
 
+  // Preallocate ring buffer of recent logs
+  recentLog_.wlock()->logs.resize(maxLogEvents_);
+
   // Periodically set process cpu/uptime/memory counter
   setProcessCounterTimer_ =
       folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
@@ -68,11 +71,12 @@ MonitorBase::MonitorBase(
             // throws std::invalid_argument if not exist
             inputLog.getString("event");
 
-            // add to recent log list
-            if (recentLog_.size() >= maxLogEvents_) {
-              recentLog_.pop_front();
-            }
-            recentLog_.emplace_back(inputLog.toJson());
+            // add to recent log ring, overwriting the oldest one
+            recentLog_.withWLock([&inputLog](auto& ring) {
+              if (not ring.logs.empty()) {
+                ring.logs[ring.count++ % ring.logs.size()] = inputLog;
+              }
+            });
 
             // publish the log if enable log submission
             if (config->isLogSubmissionEnabled()) {
@@ -90,7 +94,22 @@ MonitorBase::MonitorBase(
 
 std::list<std::string>
 MonitorBase::getRecentEventLogs() {
-  return recentLog_;
+  // Copy out under lock and render JSON outside of it
+  std::vector<LogSample> logs;
+  recentLog_.withRLock([&logs](auto const& ring) {
+    const auto size = ring.logs.size();
+    const auto start = ring.count > size ? ring.count - size : 0;
+    logs.reserve(ring.count - start);
+    for (auto i = start; i < ring.count; ++i) {
+      logs.emplace_back(ring.logs[i % size]);
+    }
+  });
+
+  std::list<std::string> recentLogs;
+  for (auto const& log : logs) {
+    recentLogs.emplace_back(log.toJson());
+  }
+  return recentLogs;
 }
 
 void
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <folly/Function.h>
+#include <folly/Synchronized.h>
 
 #include <fb303/ServiceData.h>
 #include <openr/common/OpenrEventBase.h>
@@ -36,7 +37,7 @@ class MonitorBase : public OpenrEventBase {
       const std::string& category,
       messaging::RQueue<LogSample> logSampleQueue);
 
-  // Get recent event logs
+  // Get recent event logs, oldest first. JSON is rendered on every call.
   std::list<std::string> getRecentEventLogs();
 
   // Destructor
@@ -62,8 +63,17 @@ class MonitorBase : public OpenrEventBase {
   // Number of last log events to queue
   const uint32_t maxLogEvents_{0};
 
-  // List of recent log
-  std::list<std::string> recentLog_{};
+  /**
+   * Ring buffer of recent logs. Slots are preallocated and overwritten in
+   * place, logs are kept in typed form and ONLY rendered to JSON when
+   * queried via getRecentEventLogs().
+   */
+  struct RecentLogRing {
+    std::vector<LogSample> logs;
+    // number of logs ever added, next slot is `count % logs.size()`
+    uint64_t count{0};
+  };
+  folly::Synchronized<RecentLogRing> recentLog_;
 
   // Timer to periodically set process cpu/uptime/memory counter
   std::unique_ptr<folly::AsyncTimeout> setProcessCounterTimer_;
@@ -153,6 +153,27 @@ TEST(LogSampleTest, fromJsonTest) {
   EXPECT_THROW(LogSample::fromJson(jsonSampleNoTimeKey), std::exception);
 }
 
+TEST(LogSampleTest, OverwriteAndRoundTripTest) {
+  LogSample sample(
+      std::chrono::system_clock::time_point(std::chrono::seconds(222)));
+  sample.addString("event", "NEIGHBOR_UP");
+  sample.addInt("rtt_us", 100);
+
+  // Adding existing key overwrites the value, other types are independent
+  sample.addString("event", "NEIGHBOR_DOWN");
+  sample.addInt("rtt_us", 200);
+  sample.addDouble("rtt_us", 1.5);
+  EXPECT_EQ("NEIGHBOR_DOWN", sample.getString("event"));
+  EXPECT_EQ(200, sample.getInt("rtt_us"));
+  EXPECT_EQ(1.5, sample.getDouble("rtt_us"));
+  EXPECT_EQ(1, folly::parseJson(sample.toJson()).at("normal").size());
+
+  // JSON rendering is deterministic and lossless
+  auto parsed = LogSample::fromJson(sample.toJson());
+  EXPECT_EQ(sample.getTimestamp(), parsed.getTimestamp());
+  EXPECT_EQ(sample.toJson(), parsed.toJson());
+}
+
 } // namespace openr
 
 int
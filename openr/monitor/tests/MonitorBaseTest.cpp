@@ -110,6 +110,35 @@ TEST_F(MonitorTestFixture, LogBasicOperation) {
   }
 }
 
+TEST_F(MonitorTestFixture, RecentLogRingTest) {
+  // Default `max_event_log` is 100
+  const int64_t kMaxLogEvents{100};
+  const int64_t kNumLogs{kMaxLogEvents + 50};
+  EXPECT_CALL(*monitor, processEventLog(_)).Times(AnyNumber());
+
+  for (int64_t i = 0; i < kNumLogs; ++i) {
+    LogSample log;
+    log.addString("event", "event_unit_test");
+    log.addInt("num", i);
+    eventLogUpdatesQueue.push(std::move(log));
+  }
+
+  // Wait for the last log to show up, oldest ones got overwritten
+  while (true) {
+    auto recentLogs = monitor->getRecentEventLogs();
+    if (not recentLogs.empty() and
+        LogSample::fromJson(recentLogs.back()).getInt("num") == kNumLogs - 1) {
+      ASSERT_EQ(kMaxLogEvents, static_cast<int64_t>(recentLogs.size()));
+      int64_t expectedNum = kNumLogs - kMaxLogEvents;
+      for (auto const& recentLog : recentLogs) {
+        EXPECT_EQ(expectedNum++, LogSample::fromJson(recentLog).getInt("num"));
+      }
+      break;
+    }
+    std::this_thread::yield();
+  }
+}
+
 TEST_F(MonitorTestFixture, ProcessCounterTest) {
   // Wait for calling getCPUpercentage() twice for calculating the cpu% counter
   while (true) {
@@ -7,20 +7,150 @@
 
 #include <openr/neighbor-monitor/NeighborMonitor.h>
 
+#include <fb303/ServiceData.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/common/Constants.h>
+#include <openr/common/NetworkUtil.h>
+
+extern "C" {
+#include <linux/neighbour.h>
+}
+
+namespace fb303 = facebook::fb303;
+
 namespace openr {
 
-class NeighborMonitorImpl {};
+/*
+ * NetlinkEventProcessor dispatches netlink events NeighborMonitor is
+ * interested in, i.e. LINK for interface names and NEIGH for reachability.
+ */
+struct NeighborMonitor::NetlinkEventProcessor {
+  NeighborMonitor& nm_;
+  explicit NetlinkEventProcessor(NeighborMonitor& nm) : nm_(nm) {}
+
+  void
+  operator()(fbnl::Link&& link) {
+    nm_.processLinkEvent(std::move(link));
+  }
+
+  void
+  operator()(fbnl::IfAddress&&) {}
+
+  void
+  operator()(fbnl::Neighbor&& neighbor) {
+    nm_.processNeighborEvent(std::move(neighbor));
+  }
+
+  void
+  operator()(fbnl::Rule&&) {}
+};
+
+NeighborMonitor::NeighborMonitor(
+    fbnl::NetlinkProtocolSocket* nlSock,
+    messaging::RQueue<fbnl::NetlinkEvent> netlinkEventsQueue,
+    messaging::ReplicateQueue<AddressEvent>& addrEventQueue)
+    : nlSock_(nlSock), addrEventQueue_(addrEventQueue) {
+  CHECK(nlSock_) << "Netlink socket can't be nullptr";
 
-NeighborMonitor::NeighborMonitor(messaging::ReplicateQueue<AddressEvent>&) {}
+  // Add fiber to process the LINK/NEIGH events from platform
+  addFiberTask([q = std::move(netlinkEventsQueue), this]() mutable noexcept {
+    // Learn existing interfaces before processing any neighbor event
+    syncLinks();
+
+    NetlinkEventProcessor visitor(*this);
+    while (true) {
+      auto maybeEvent = q.get();
+      if (maybeEvent.hasError()) {
+        XLOG(INFO) << "Terminating netlink events processing fiber";
+        break;
+      }
+      std::visit(visitor, std::move(*maybeEvent));
+    }
+  });
+
+  // Initialize stats keys
+  fb303::fbData->addStatExportType(
+      "neighbor_monitor.neighbor_unreachable", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "neighbor_monitor.neighbor_probe", fb303::SUM);
+}
+
+void
+NeighborMonitor::syncLinks() {
+  // Not fatal on failure, mapping will be learnt from subsequent LINK events
+  folly::Try<folly::Expected<std::vector<fbnl::Link>, int>> maybeLinks;
+  try {
+    maybeLinks = nlSock_->getAllLinks().getTry(Constants::kReadTimeout);
+  } catch (const folly::FutureTimeout&) {
+    XLOG(ERR) << "Timeout retrieving links from netlink";
+    return;
+  }
+  if (not maybeLinks.hasValue() or maybeLinks->hasError()) {
+    XLOG(ERR) << "Failed to retrieve links from netlink";
+    return;
+  }
+  for (auto const& link : maybeLinks->value()) {
+    ifIndexToName_.insert_or_assign(link.getIfIndex(), link.getLinkName());
+  }
+}
 
 void
-NeighborMonitor::stop() {
-  return;
+NeighborMonitor::processLinkEvent(fbnl::Link&& link) {
+  ifIndexToName_.insert_or_assign(link.getIfIndex(), link.getLinkName());
 }
 
 void
-NeighborMonitor::run() {
-  return;
+NeighborMonitor::processNeighborEvent(fbnl::Neighbor&& neighbor) {
+  const auto dest = neighbor.getDestination();
+  if (dest.isV6() and not dest.isLinkLocal()) {
+    return;
+  }
+
+  const auto key = std::make_pair(neighbor.getIfIndex(), dest);
+  const auto state = neighbor.getState();
+
+  // Entry removed from neighbor table, e.g. garbage collected. This is NOT
+  // a sign of unreachability, stop tracking it.
+  if (not state.has_value() or
+      (not neighbor.isReachable() and state.value() != NUD_FAILED)) {
+    nudStates_.erase(key);
+    return;
+  }
+
+  auto [it, inserted] = nudStates_.emplace(key, state.value());
+  const auto prevState = inserted ? NUD_NONE : it->second;
+  it->second = state.value();
+  if (prevState == state.value()) {
+    return;
+  }
+
+  // Reachability is no longer confirmed and kernel is unicast probing the
+  // neighbor. Outcome is either NUD_REACHABLE or NUD_FAILED.
+  if (state.value() == NUD_PROBE) {
+    XLOG(DBG1) << "Probing neighbor " << dest.str() << " on ifIndex "
+               << neighbor.getIfIndex();
+    fb303::fbData->addStatValue(
+        "neighbor_monitor.neighbor_probe", 1, fb303::SUM);
+    return;
+  }
+  if (state.value() != NUD_FAILED) {
+    return;
+  }
+
+  auto ifIt = ifIndexToName_.find(neighbor.getIfIndex());
+  if (ifIt == ifIndexToName_.end()) {
+    XLOG(WARNING) << "Neighbor " << dest.str() << " unreachable on unknown "
+                  << "ifIndex " << neighbor.getIfIndex();
+    return;
+  }
+
+  XLOG(INFO) << fmt::format(
+      "Neighbor {} on {} is unreachable", dest.str(), ifIt->second);
+  fb303::fbData->addStatValue(
+      "neighbor_monitor.neighbor_unreachable", 1, fb303::SUM);
+  addrEventQueue_.push(AddressEvent{
+      false /* resolvable */, toBinaryAddress(dest), ifIt->second});
 }
 
 } // namespace openr
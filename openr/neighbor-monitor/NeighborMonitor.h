@@ -7,31 +7,64 @@
 
 #pragma once
 
+#include <map>
+#include <unordered_map>
+
+#include <folly/IPAddress.h>
+
 #include <openr/common/LsdbTypes.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/messaging/ReplicateQueue.h>
+#include <openr/nl/NetlinkProtocolSocket.h>
 
 namespace openr {
 
-class NeighborMonitorImpl;
-
+/**
+ * NeighborMonitor watches kernel neighbor table (ARP/NDP) through netlink
+ * RTM_NEWNEIGH/RTM_DELNEIGH notifications. When the kernel fails to resolve
+ * a neighbor, i.e. its entry transitions into NUD_FAILED after unicast
+ * probes went unanswered, an unresolvable `AddressEvent` is published for
+ * the address. Spark brings down the adjacency with matching transport
+ * address right away instead of waiting for its hold timer to expire.
+ *
+ * ONLY IPv6 link-local and IPv4 addresses are reported, as those are the
+ * transport addresses used by Spark neighbors.
+ */
 class NeighborMonitor : public OpenrEventBase {
  public:
-  explicit NeighborMonitor(
+  NeighborMonitor(
+      fbnl::NetlinkProtocolSocket* nlSock,
+      messaging::RQueue<fbnl::NetlinkEvent> netlinkEventsQueue,
       messaging::ReplicateQueue<AddressEvent>& addrEventQueue);
 
   NeighborMonitor(const NeighborMonitor&) = delete;
 
   NeighborMonitor& operator=(const NeighborMonitor&) = delete;
 
-  ~NeighborMonitor() = default;
+  ~NeighborMonitor() override = default;
+
+ private:
+  struct NetlinkEventProcessor;
 
-  void stop() override;
+  // Populate ifIndex -> ifName mapping from existing links
+  void syncLinks();
 
-  void run() override;
+  void processLinkEvent(fbnl::Link&& link);
 
- private:
-  std::shared_ptr<NeighborMonitorImpl> impl_;
+  void processNeighborEvent(fbnl::Neighbor&& neighbor);
+
+  // Netlink socket to query existing links
+  fbnl::NetlinkProtocolSocket* nlSock_{nullptr};
+
+  // Queue to publish unresolvable neighbor address to Spark
+  messaging::ReplicateQueue<AddressEvent>& addrEventQueue_;
+
+  // Neighbor notifications ONLY carry interface index
+  std::unordered_map<int, std::string> ifIndexToName_;
+
+  // Last known NUD state of tracked neighbor entries. Used to report the
+  // transition into NUD_FAILED exactly once.
+  std::map<std::pair<int /* ifIndex */, folly::IPAddress>, int> nudStates_;
 
 #ifdef NeighborMonitor_TEST_FRIENDS
   NeighborMonitor_TEST_FRIENDS
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/EventBase.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/NetworkUtil.h>
+#include <openr/neighbor-monitor/NeighborMonitor.h>
+#include <openr/tests/mocks/NetlinkEventsInjector.h>
+
+extern "C" {
+#include <linux/neighbour.h>
+}
+
+using namespace openr;
+
+namespace {
+const std::string kIfName1{"eth1"};
+const std::string kIfName2{"eth2"};
+} // namespace
+
+class NeighborMonitorFixture : public ::testing::Test {
+ public:
+  void
+  SetUp() override {
+    facebook::fb303::fbData->resetAllData();
+
+    nlSock_ = std::make_unique<fbnl::MockNetlinkProtocolSocket>(&nlEvb_);
+    nlEventsInjector_ = std::make_unique<NetlinkEventsInjector>(nlSock_.get());
+
+    // Link existing before NeighborMonitor starts, learnt via initial sync
+    nlEventsInjector_->sendLinkEvent(kIfName1, 1, true /* isUp */);
+
+    neighborMonitor_ = std::make_unique<NeighborMonitor>(
+        nlSock_.get(), nlSock_->getReader(), addrEventQueue_);
+    neighborMonitorThread_ = std::make_unique<std::thread>(
+        [this]() { neighborMonitor_->run(); });
+    neighborMonitor_->waitUntilRunning();
+  }
+
+  void
+  TearDown() override {
+    nlSock_->closeQueue();
+    addrEventQueue_.close();
+    neighborMonitor_->stop();
+    neighborMonitorThread_->join();
+    neighborMonitor_.reset();
+    nlEventsInjector_.reset();
+    nlSock_.reset();
+  }
+
+  AddressEvent
+  recvAddrEvent() {
+    auto maybeEvent = addrEventReader_.get();
+    EXPECT_TRUE(maybeEvent.hasValue());
+    return std::move(maybeEvent).value();
+  }
+
+  folly::EventBase nlEvb_;
+  std::unique_ptr<fbnl::MockNetlinkProtocolSocket> nlSock_;
+  std::unique_ptr<NetlinkEventsInjector> nlEventsInjector_;
+
+  messaging::ReplicateQueue<AddressEvent> addrEventQueue_;
+  messaging::RQueue<AddressEvent> addrEventReader_{
+      addrEventQueue_.getReader()};
+
+  std::unique_ptr<NeighborMonitor> neighborMonitor_;
+  std::unique_ptr<std::thread> neighborMonitorThread_;
+};
+
+TEST_F(NeighborMonitorFixture, UnreachableNeighbor) {
+  // REACHABLE -> STALE -> PROBE -> FAILED reports neighbor exactly once
+  for (auto state : {NUD_REACHABLE, NUD_STALE, NUD_PROBE, NUD_FAILED}) {
+    nlEventsInjector_->sendNeighborEvent(kIfName1, "fe80::2", state);
+  }
+  {
+    auto event = recvAddrEvent();
+    EXPECT_FALSE(event.resolvable);
+    EXPECT_EQ(toBinaryAddress(folly::IPAddress("fe80::2")), event.addr);
+    EXPECT_EQ(kIfName1, event.ifName);
+  }
+
+  // Repeated FAILED, deleted entry and global v6 address are not reported
+  nlEventsInjector_->sendNeighborEvent(kIfName1, "fe80::2", NUD_FAILED);
+  nlEventsInjector_->sendNeighborEvent(kIfName1, "fe80::3", NUD_STALE);
+  nlEventsInjector_->sendNeighborEvent(
+      kIfName1, "fe80::3", NUD_STALE, true /* deleted */);
+  nlEventsInjector_->sendNeighborEvent(kIfName1, "2001::3", NUD_FAILED);
+
+  // V4 neighbor on link learnt after start
+  nlEventsInjector_->sendLinkEvent(kIfName2, 2, true /* isUp */);
+  nlEventsInjector_->sendNeighborEvent(kIfName2, "10.0.0.2", NUD_FAILED);
+  {
+    auto event = recvAddrEvent();
+    EXPECT_EQ(toBinaryAddress(folly::IPAddress("10.0.0.2")), event.addr);
+    EXPECT_EQ(kIfName2, event.ifName);
+  }
+
+  // Neighbor becomes reachable again and fails once more
+  nlEventsInjector_->sendNeighborEvent(kIfName1, "fe80::2", NUD_REACHABLE);
+  nlEventsInjector_->sendNeighborEvent(kIfName1, "fe80::2", NUD_FAILED);
+  {
+    auto event = recvAddrEvent();
+    EXPECT_EQ(toBinaryAddress(folly::IPAddress("fe80::2")), event.addr);
+  }
+
+  auto counters = facebook::fb303::fbData->getCounters();
+  EXPECT_EQ(3, counters.at("neighbor_monitor.neighbor_unreachable.sum"));
+  EXPECT_EQ(1, counters.at("neighbor_monitor.neighbor_probe.sum"));
+}
+
+int
+main(int argc, char** argv) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::Init init(&argc, &argv);
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
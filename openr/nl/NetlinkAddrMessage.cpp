@@ -19,6 +19,10 @@ NetlinkAddrMessage::~NetlinkAddrMessage() {
 
 void
 NetlinkAddrMessage::rcvdIfAddress(IfAddress&& ifAddr) {
+  if (addrCb_) {
+    addrCb_(std::move(ifAddr));
+    return;
+  }
   rcvdAddrs_.emplace_back(std::move(ifAddr));
 }
 
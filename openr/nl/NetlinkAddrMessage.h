@@ -51,6 +51,14 @@ class NetlinkAddrMessage final : public NetlinkMessageBase {
     return addrPromise_.getSemiFuture();
   }
 
+  // Hand over every address received in response to GET request to `cb`
+  // instead of accumulating them. Addresses future is then fulfilled with an
+  // empty list.
+  void
+  setIfAddressCallback(std::function<void(IfAddress&&)> cb) {
+    addrCb_ = std::move(cb);
+  }
+
   // initiallize address message with default params
   void init(int type);
 
@@ -77,6 +85,10 @@ class NetlinkAddrMessage final : public NetlinkMessageBase {
   // promise to be fulfilled when receiving kernel reply
   folly::Promise<folly::Expected<std::vector<IfAddress>, int>> addrPromise_;
   std::vector<IfAddress> rcvdAddrs_;
+
+  // optional callback streaming received addresses, see
+  // `setIfAddressCallback()`
+  std::function<void(IfAddress&&)> addrCb_;
 };
 
 } // namespace openr::fbnl
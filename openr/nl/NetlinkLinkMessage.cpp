@@ -25,6 +25,10 @@ NetlinkLinkMessage::~NetlinkLinkMessage() {
 
 void
 NetlinkLinkMessage::rcvdLink(Link&& link) {
+  if (linkCb_) {
+    linkCb_(std::move(link));
+    return;
+  }
   rcvdLinks_.emplace_back(std::move(link));
 }
 
@@ -55,6 +55,13 @@ class NetlinkLinkMessage final : public NetlinkMessageBase {
     return linkPromise_.getSemiFuture();
   }
 
+  // Hand over every link received in response to GET request to `cb` instead
+  // of accumulating them. Links future is then fulfilled with an empty list.
+  void
+  setLinkCallback(std::function<void(Link&&)> cb) {
+    linkCb_ = std::move(cb);
+  }
+
   // initiallize link message with default params
   void init(int type, uint32_t flags);
 
@@ -94,6 +101,9 @@ class NetlinkLinkMessage final : public NetlinkMessageBase {
   // promise to be fulfilled when receiving kernel reply
   folly::Promise<folly::Expected<std::vector<Link>, int>> linkPromise_;
   std::vector<Link> rcvdLinks_;
+
+  // optional callback streaming received links, see `setLinkCallback()`
+  std::function<void(Link&&)> linkCb_;
 };
 
 } // namespace openr::fbnl
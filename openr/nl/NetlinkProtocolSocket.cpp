@@ -444,6 +444,14 @@ NetlinkProtocolSocket::recvNetlinkMessage() {
     if (errno == EINTR || errno == EAGAIN) {
       return;
     }
+    if (errno == ENOBUFS) {
+      // Socket receive buffer overrun. Kernel has dropped notifications and
+      // consumers need to resync their state.
+      XLOG(WARNING) << "Netlink socket receive buffer overrun. "
+                    << "Notifications from kernel are lost.";
+      reportEventLoss();
+      return;
+    }
     XLOG(ERR) << "Error in netlink socket receive: " << bytesRead
               << " err: " << folly::errnoStr(std::abs(errno));
     fbData->addStatValue("netlink.errors", 1, fb303::SUM);
@@ -661,6 +669,53 @@ NetlinkProtocolSocket::getAllIfAddresses() {
   return future;
 }
 
+folly::SemiFuture<int>
+NetlinkProtocolSocket::streamAllLinks(
+    std::function<void(fbnl::Link&&)> linkCb) {
+  XLOG(DBG3) << "Netlink stream links";
+  auto linkMsg = std::make_unique<openr::fbnl::NetlinkLinkMessage>();
+  linkMsg->setLinkCallback(std::move(linkCb));
+  auto future = failOnEventLoss(linkMsg->getSemiFuture());
+
+  // Initialize message fields to get all links
+  linkMsg->init(RTM_GETLINK, 0);
+  notifQueue_.putMessage(std::move(linkMsg));
+
+  return future;
+}
+
+folly::SemiFuture<int>
+NetlinkProtocolSocket::streamAllIfAddresses(
+    std::function<void(fbnl::IfAddress&&)> addrCb) {
+  XLOG(DBG3) << "Netlink stream interface addresses";
+  auto addrMsg = std::make_unique<openr::fbnl::NetlinkAddrMessage>();
+  addrMsg->setIfAddressCallback(std::move(addrCb));
+  auto future = failOnEventLoss(addrMsg->getSemiFuture());
+
+  // Initialize message fields to get all addresses
+  addrMsg->init(RTM_GETADDR);
+  notifQueue_.putMessage(std::move(addrMsg));
+
+  return future;
+}
+
+folly::SemiFuture<int>
+NetlinkProtocolSocket::failOnEventLoss(folly::SemiFuture<int>&& future) {
+  return std::move(future).deferValue(
+      [this, eventLossCount = getEventLossCount()](int status) {
+        if (status == 0 and getEventLossCount() != eventLossCount) {
+          return -ENOBUFS;
+        }
+        return status;
+      });
+}
+
+void
+NetlinkProtocolSocket::reportEventLoss() {
+  ++eventLossCount_;
+  fbData->addStatValue("netlink.notifications.lost", 1, fb303::SUM);
+}
+
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Neighbor>, int>>
 NetlinkProtocolSocket::getAllNeighbors() {
   XLOG(DBG1) << "Netlink get neighbors";
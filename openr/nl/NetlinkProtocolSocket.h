@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <folly/IPAddress.h>
 #include <folly/futures/Future.h>
 #include <folly/io/async/AsyncTimeout.h>
@@ -95,6 +97,7 @@ constexpr std::chrono::milliseconds kNlRequestAckTimeout{1000};
  *   netlink.notifications.addr : Received address notifications
  *   netlink.notifications.neighbors : Received neighbor notifications
  *   netlink.notifications.route : Received route notifications
+ *   netlink.notifications.lost : Socket overrun (ENOBUFS) losing notifications
  */
 class NetlinkProtocolSocket : public folly::EventHandler {
  public:
@@ -191,6 +194,21 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   virtual folly::SemiFuture<folly::Expected<std::vector<fbnl::IfAddress>, int>>
   getAllIfAddresses();
 
+  /**
+   * Streaming variants of `getAllLinks()` and `getAllIfAddresses()`. Every
+   * object of the dump is handed over to the callback, on netlink event-base,
+   * as soon as it is received instead of accumulating the entire dump.
+   *
+   * @returns 0 once dump completes, -ENOBUFS if netlink notifications got lost
+   *          while the dump was in progress (dump must be restarted, as
+   *          changes to objects already dumped might be lost), else
+   *          appropriate system error code
+   */
+  virtual folly::SemiFuture<int> streamAllLinks(
+      std::function<void(fbnl::Link&&)> linkCb);
+  virtual folly::SemiFuture<int> streamAllIfAddresses(
+      std::function<void(fbnl::IfAddress&&)> addrCb);
+
   /**
    * API to get neighbors from kernel
    */
@@ -231,6 +249,17 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   getMplsRoutes(
       uint8_t protocolId, std::optional<uint8_t> routeTableId = std::nullopt);
 
+  /**
+   * Number of times notifications from kernel got lost due to socket receive
+   * buffer overrun (ENOBUFS). Consumers of netlink events compare it against
+   * last seen value to detect gap in event stream and resync with full dump.
+   * Can be called from any thread.
+   */
+  uint64_t
+  getEventLossCount() const {
+    return eventLossCount_.load();
+  }
+
   /**
    * Utility function to accumulate result of multiple requests into one.
    * It will throw the exception with the first non-zero value(aka error code),
@@ -244,6 +273,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Initialize netlink socket and add to eventloop for polling
   virtual void init();
 
+  // Record loss of notifications, e.g. upon socket receive buffer overrun
+  void reportEventLoss();
+
  private:
   NetlinkProtocolSocket(NetlinkProtocolSocket const&) = delete;
   NetlinkProtocolSocket& operator=(NetlinkProtocolSocket const&) = delete;
@@ -258,6 +290,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // message received.
   void recvNetlinkMessage();
 
+  // Fail dump with -ENOBUFS if notifications got lost while it was in progress
+  folly::SemiFuture<int> failOnEventLoss(folly::SemiFuture<int>&& future);
+
   // Process received netlink message. Set return values for pending requests
   // or send notifications.
   void processMessage(
@@ -338,6 +373,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Timer for initializing this socket. This gets cancelled automatically if
   // event-base is never started
   std::unique_ptr<folly::AsyncTimeout> nlInitTimer_{nullptr};
+
+  // Number of detected notification losses (ENOBUFS)
+  std::atomic<uint64_t> eventLossCount_{0};
 };
 
 } // namespace openr::fbnl
@@ -5,23 +5,114 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <boost/functional/hash.hpp>
+#include <fb303/ServiceData.h>
+
+#include <openr/common/Constants.h>
 #include <openr/policy/PolicyManager.h>
 
+namespace fb303 = facebook::fb303;
+
 namespace openr {
 
 class PolicyManagerImpl {};
 
 PolicyManager::PolicyManager(
-    const neteng::config::routing_policy::PolicyConfig& config) {}
+    const neteng::config::routing_policy::PolicyConfig& config)
+    : resultCache_(Constants::kPolicyResultCacheSize) {}
 PolicyManager::~PolicyManager() = default;
 
+void
+PolicyManager::updatePolicyConfig(
+    const neteng::config::routing_policy::PolicyConfig& config) {
+  ++policyVersion_;
+  resultCache_.clear();
+}
+
+size_t
+PolicyManager::getCacheKey(
+    const std::string& policyStatementName,
+    const thrift::PrefixEntry& prefixEntry,
+    const std::optional<OpenrPolicyActionData>& policyActionData,
+    const std::optional<OpenrPolicyMatchData>& policyMatchData) const {
+  size_t seed = 0;
+  boost::hash_combine(seed, policyVersion_);
+  boost::hash_combine(seed, policyStatementName);
+  if (policyActionData.has_value() and policyActionData->weight.has_value()) {
+    boost::hash_combine(seed, *policyActionData->weight);
+  }
+  if (policyMatchData.has_value()) {
+    boost::hash_combine(seed, policyMatchData->igpCost);
+  }
+
+  // Fields of prefix entry matched by policies
+  const auto& prefix = *prefixEntry.prefix();
+  boost::hash_combine(seed, *prefix.prefixAddress()->addr());
+  boost::hash_combine(seed, *prefix.prefixLength());
+  boost::hash_range(
+      seed, prefixEntry.tags()->begin(), prefixEntry.tags()->end());
+  boost::hash_range(
+      seed, prefixEntry.area_stack()->begin(), prefixEntry.area_stack()->end());
+  const auto& metrics = *prefixEntry.metrics();
+  boost::hash_combine(seed, *metrics.path_preference());
+  boost::hash_combine(seed, *metrics.source_preference());
+  boost::hash_combine(seed, *metrics.distance());
+  boost::hash_combine(seed, *metrics.drain_metric());
+  return seed;
+}
+
 std::pair<std::shared_ptr<thrift::PrefixEntry>, std::string /*policy name*/>
 PolicyManager::applyPolicy(
     const std::string& policyStatementName,
     const std::shared_ptr<thrift::PrefixEntry>& prefixEntry,
     const std::optional<OpenrPolicyActionData>& policyActionData,
     const std::optional<OpenrPolicyMatchData>& policyMatchData) noexcept {
-  return {prefixEntry, "Always Allow"};
+  const auto key = getCacheKey(
+      policyStatementName, *prefixEntry, policyActionData, policyMatchData);
+
+  // ATTN: hit is served only if cached input equals the given one. Fields not
+  //       hashed into the key (and hash collisions) lead to re-evaluation.
+  auto it = resultCache_.find(key);
+  if (it != resultCache_.end() and
+      it->second.policyStatementName == policyStatementName and
+      it->second.policyActionData == policyActionData and
+      it->second.policyMatchData == policyMatchData and
+      it->second.prefixEntry == *prefixEntry) {
+    fb303::fbData->addStatValue("policy_manager.cache_hits", 1, fb303::SUM);
+    const auto& result = it->second;
+    if (not result.accepted) {
+      return {nullptr, result.hitPolicyName};
+    }
+    // ATTN: hand out a private copy of the modified entry, as callers own and
+    //       may further modify the returned entry.
+    if (result.modifiedEntry.has_value()) {
+      return {
+          std::make_shared<thrift::PrefixEntry>(*result.modifiedEntry),
+          result.hitPolicyName};
+    }
+    return {prefixEntry, result.hitPolicyName};
+  }
+  fb303::fbData->addStatValue("policy_manager.cache_misses", 1, fb303::SUM);
+
+  // Policy evaluation. Policy implementation is not part of this tree,
+  // all prefixes are accepted as is.
+  std::shared_ptr<thrift::PrefixEntry> postPolicyEntry = prefixEntry;
+  std::string hitPolicyName{"Always Allow"};
+
+  PolicyResult result;
+  result.policyStatementName = policyStatementName;
+  result.policyActionData = policyActionData;
+  result.policyMatchData = policyMatchData;
+  result.prefixEntry = *prefixEntry;
+  result.accepted = postPolicyEntry != nullptr;
+  if (postPolicyEntry and postPolicyEntry != prefixEntry and
+      *postPolicyEntry != *prefixEntry) {
+    result.modifiedEntry = *postPolicyEntry;
+  }
+  result.hitPolicyName = hitPolicyName;
+  resultCache_.set(key, std::move(result));
+
+  return {std::move(postPolicyEntry), std::move(hitPolicyName)};
 }
 
 } // namespace openr
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <configerator/structs/neteng/config/gen-cpp2/routing_policy_types.h>
+#include <folly/container/EvictingCacheMap.h>
 #include <openr/if/gen-cpp2/Types_types.h>
 #include <openr/policy/PolicyStructs.h>
 
@@ -17,6 +18,15 @@ class PolicyManagerImpl;
 
 /**
  * PolicyManager manages all policies defined in the config file.
+ *
+ * Policy evaluation results are memoized in a bounded LRU cache. Cache key is
+ * a hash of the policy version (derived from policy config), the policy
+ * statement name, the action/match data and the prefix entry fields matched
+ * by policies (prefix, tags, area stack and metrics), computed without
+ * serializing the entry. A hit is only served if the cached input is equal to
+ * the given one, which rules out hash collisions.
+ *
+ * NOTE: not thread-safe, expected to be used from the owner's event base.
  */
 class PolicyManager {
  public:
@@ -33,9 +43,44 @@ class PolicyManager {
       const std::optional<OpenrPolicyMatchData>& policyMatchData =
           std::nullopt) noexcept;
 
+  /**
+   * Replace policy config. Memoized results of previous config are dropped.
+   */
+  void updatePolicyConfig(
+      const neteng::config::routing_policy::PolicyConfig& config);
+
   // PolicyManagerImpl uses forward declaration
   // Use shared_ptr because it works with incomplete type, where unique_ptr
   // requires full declaration
   std::shared_ptr<PolicyManagerImpl> impl_{nullptr};
+
+ private:
+  // Memoized result of one policy evaluation along with its input
+  struct PolicyResult {
+    std::string policyStatementName;
+    std::optional<OpenrPolicyActionData> policyActionData;
+    std::optional<OpenrPolicyMatchData> policyMatchData;
+    thrift::PrefixEntry prefixEntry;
+
+    // false if prefix is rejected by policy
+    bool accepted{false};
+
+    // post-policy entry if policy modified the prefix entry
+    std::optional<thrift::PrefixEntry> modifiedEntry{std::nullopt};
+
+    std::string hitPolicyName;
+  };
+
+  size_t getCacheKey(
+      const std::string& policyStatementName,
+      const thrift::PrefixEntry& prefixEntry,
+      const std::optional<OpenrPolicyActionData>& policyActionData,
+      const std::optional<OpenrPolicyMatchData>& policyMatchData) const;
+
+  // Bumped upon every policy config change, part of every cache key
+  uint64_t policyVersion_{0};
+
+  // Cache key -> memoized result
+  folly::EvictingCacheMap<size_t, PolicyResult> resultCache_;
 };
 } // namespace openr
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/LsdbUtil.h>
+#include <openr/common/NetworkUtil.h>
+#include <openr/policy/PolicyManager.h>
+
+namespace fb303 = facebook::fb303;
+
+using namespace openr;
+
+namespace {
+const std::string kPolicy1{"policy-1"};
+const std::string kPolicy2{"policy-2"};
+
+int64_t
+getCounter(const std::string& name) {
+  auto counters = fb303::fbData->getCounters();
+  return counters.count(name) ? counters.at(name) : 0;
+}
+} // namespace
+
+class PolicyManagerTestFixture : public ::testing::Test {
+ public:
+  void
+  SetUp() override {
+    fb303::fbData->resetAllData();
+  }
+
+  void
+  expectCacheStats(int64_t hits, int64_t misses) {
+    EXPECT_EQ(hits, getCounter("policy_manager.cache_hits.sum"));
+    EXPECT_EQ(misses, getCounter("policy_manager.cache_misses.sum"));
+  }
+
+  PolicyManager policyManager_{
+      neteng::config::routing_policy::PolicyConfig{}};
+};
+
+/*
+ * Verify policy result is memoized per (policy, prefix entry, action data,
+ * match data) and any change of them leads to re-evaluation.
+ */
+TEST_F(PolicyManagerTestFixture, ResultCache) {
+  auto entry = std::make_shared<thrift::PrefixEntry>(
+      createPrefixEntry(toIpPrefix("10.0.0.0/24")));
+
+  auto [postPolicyEntry, hitPolicyName] =
+      policyManager_.applyPolicy(kPolicy1, entry);
+  ASSERT_NE(nullptr, postPolicyEntry);
+  EXPECT_EQ(*entry, *postPolicyEntry);
+  expectCacheStats(0, 1);
+
+  // same policy and an equal (but not the same) entry hits the cache
+  auto entryCp = std::make_shared<thrift::PrefixEntry>(*entry);
+  auto [cachedEntry, cachedHitPolicyName] =
+      policyManager_.applyPolicy(kPolicy1, entryCp);
+  ASSERT_NE(nullptr, cachedEntry);
+  EXPECT_EQ(*entry, *cachedEntry);
+  EXPECT_EQ(hitPolicyName, cachedHitPolicyName);
+  expectCacheStats(1, 1);
+
+  // different policy
+  policyManager_.applyPolicy(kPolicy2, entry);
+  expectCacheStats(1, 2);
+
+  // different action and match data
+  policyManager_.applyPolicy(kPolicy1, entry, OpenrPolicyActionData(10));
+  expectCacheStats(1, 3);
+  policyManager_.applyPolicy(
+      kPolicy1, entry, std::nullopt, OpenrPolicyMatchData(5));
+  expectCacheStats(1, 4);
+  policyManager_.applyPolicy(
+      kPolicy1, entry, std::nullopt, OpenrPolicyMatchData(5));
+  expectCacheStats(2, 4);
+
+  // modified prefix attributes matched by policies
+  entryCp->metrics()->distance() = *entry->metrics()->distance() + 1;
+  policyManager_.applyPolicy(kPolicy1, entryCp);
+  expectCacheStats(2, 5);
+  entryCp->tags()->emplace("COMMODITY");
+  policyManager_.applyPolicy(kPolicy1, entryCp);
+  expectCacheStats(2, 6);
+
+  // field not hashed into cache key still leads to re-evaluation
+  entryCp->minNexthop() = 2;
+  auto [reEvaluatedEntry, _] = policyManager_.applyPolicy(kPolicy1, entryCp);
+  ASSERT_NE(nullptr, reEvaluatedEntry);
+  EXPECT_EQ(2, *reEvaluatedEntry->minNexthop());
+  expectCacheStats(2, 7);
+  policyManager_.applyPolicy(kPolicy1, entryCp);
+  expectCacheStats(3, 7);
+}
+
+/*
+ * Verify memoized results are dropped upon policy config change.
+ */
+TEST_F(PolicyManagerTestFixture, ResultCacheClearedOnConfigChange) {
+  auto entry = std::make_shared<thrift::PrefixEntry>(
+      createPrefixEntry(toIpPrefix("10.0.0.0/24")));
+
+  policyManager_.applyPolicy(kPolicy1, entry);
+  policyManager_.applyPolicy(kPolicy1, entry);
+  expectCacheStats(1, 1);
+
+  policyManager_.updatePolicyConfig(
+      neteng::config::routing_policy::PolicyConfig{});
+  policyManager_.applyPolicy(kPolicy1, entry);
+  expectCacheStats(1, 2);
+}
+
+int
+main(int argc, char** argv) {
+  // Basic initialization
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
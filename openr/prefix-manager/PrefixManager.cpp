@@ -19,6 +19,7 @@
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Types.h>
 #include <openr/if/gen-cpp2/Network_types.h>
+#include <openr/if/gen-cpp2/OpenrCtrl_types.h>
 #include <openr/if/gen-cpp2/OpenrConfig_types.h>
 #include <openr/if/gen-cpp2/Types_types.h>
 #include <openr/prefix-manager/PrefixManager.h>
@@ -260,6 +261,26 @@ PrefixManager::processPublication(thrift::Publication&& thriftPub) {
     try {
       const auto prefixDb =
           readThriftObjStr<thrift::PrefixDatabase>(*val.value(), serializer_);
+
+      // Self-originated prefix database shard, which is not (or no longer)
+      // advertised by us, e.g. from previous incarnation. Mark it as changed
+      // so that it is either re-advertised or cleared by next sync.
+      if (auto maybeShardKey = PrefixShardKey::fromStr(keyStr);
+          maybeShardKey.hasValue()) {
+        const auto shardId = maybeShardKey->getShardId();
+        if (maybeShardKey->getNodeName() == nodeId_ and
+            (not *prefixDb.deletePrefix()) and
+            prefixDbShards_[area].count(shardId) == 0) {
+          XLOG(DBG1) << fmt::format(
+              "[Prefix Update]: Area: {}, stale shard {} inside KvStore",
+              area,
+              keyStr);
+          changedPrefixDbShards_[area].emplace(shardId);
+          syncKvStoreThrottled_->operator()();
+        }
+        continue;
+      }
+
       if (prefixDb.prefixEntries()->size() != 1) {
         LOG(WARNING) << "Skip processing unexpected number of prefix entries";
         continue;
@@ -271,8 +292,20 @@ PrefixManager::processPublication(thrift::Publication&& thriftPub) {
         auto const& thisNodeName = *prefixDb.thisNodeName();
         auto const& network = toIPNetwork(*tPrefixEntry.prefix());
 
-        // Skip none-self advertised prefixes or already persisted keys.
-        if (thisNodeName != nodeId_ or advertiseStatus_.count(network) > 0) {
+        // Skip none-self advertised prefixes.
+        if (thisNodeName != nodeId_) {
+          continue;
+        }
+
+        // Per-prefix key is replaced by prefix database shard. Clear it with
+        // next sync.
+        if (config_->isPrefixDbShardingEnabled()) {
+          legacyPrefixKeys_[area].emplace(keyStr, network);
+          syncKvStoreThrottled_->operator()();
+        }
+
+        // Skip already persisted keys.
+        if (advertiseStatus_.count(network) > 0) {
           continue;
         }
 
@@ -353,12 +386,9 @@ PrefixManager::buildOriginatedPrefixes(
     }
 
     // ATTN: upon initialization, no supporting routes
-    originatedPrefixDb_.emplace(
-        network,
-        OriginatedRoute(
-            prefix,
-            std::move(unicastEntry),
-            std::unordered_set<folly::CIDRNetwork>{}));
+    auto [it, _] = originatedPrefixDb_.emplace(
+        network, OriginatedRoute(prefix, std::move(unicastEntry)));
+    originatedPrefixTrie_.insert(network, &it->second);
   }
 
   // Publish static routes for config originated prefixes. This makes sure
@@ -552,15 +582,19 @@ PrefixManager::addKvStoreKeyHelper(const PrefixEntry& entry) {
       postPolicyTPrefixEntry = tPrefixEntry;
     }
 
-    const auto prefixKeyStr =
-        PrefixKey(nodeId_, entry.network, toArea).getPrefixKeyV2();
-    auto prefixDb = createPrefixDb(nodeId_, {*postPolicyTPrefixEntry});
-    auto prefixDbStr = writeThriftObjStr(std::move(prefixDb), serializer_);
-
-    // advertise key to `KvStore`
-    auto persistPrefixKeyVal =
-        PersistKeyValueRequest(AreaId{toArea}, prefixKeyStr, prefixDbStr);
-    kvRequestQueue_.push(std::move(persistPrefixKeyVal));
+    if (config_->isPrefixDbShardingEnabled()) {
+      // advertise with the prefix database shard at the end of sync
+      addPrefixToShard(toArea, *postPolicyTPrefixEntry);
+    } else {
+      const auto prefixKeyStr =
+          PrefixKey(nodeId_, entry.network, toArea).getPrefixKeyV2();
+      auto prefixDb = createPrefixDb(nodeId_, {*postPolicyTPrefixEntry});
+      auto prefixDbStr = writeThriftObjStr(std::move(prefixDb), serializer_);
+
+      // advertise key to `KvStore` with next batch of key updates
+      pendingKvRequests_.try_emplace(toArea, AreaId{toArea})
+          .first->second.addPersistKey(prefixKeyStr, std::move(prefixDbStr));
+    }
 
     fb303::fbData->addStatValue(
         "prefix_manager.route_advertisements", 1, fb303::SUM);
@@ -598,23 +632,21 @@ PrefixManager::deleteKvStoreKeyHelper(
     const folly::CIDRNetwork& prefix,
     const std::unordered_set<std::string>& deletedArea) {
   for (const auto& area : deletedArea) {
-    // Prepare thrift::PrefixDatabase object for deletion
-    thrift::PrefixDatabase deletedPrefixDb;
-    deletedPrefixDb.thisNodeName() = nodeId_;
-    deletedPrefixDb.deletePrefix() = true;
-
-    const auto prefixKeyStr = PrefixKey(nodeId_, prefix, area).getPrefixKeyV2();
     thrift::PrefixEntry entry;
     entry.prefix() = toIpPrefix(prefix);
-    deletedPrefixDb.prefixEntries() = {entry};
 
-    // Remove prefix from KvStore and flood deletion by setting deleted value.
-    auto unsetPrefixRequest = ClearKeyValueRequest(
-        AreaId{area},
-        prefixKeyStr,
-        writeThriftObjStr(std::move(deletedPrefixDb), serializer_),
-        true);
-    kvRequestQueue_.push(std::move(unsetPrefixRequest));
+    if (config_->isPrefixDbShardingEnabled()) {
+      // withdraw with the prefix database shard at the end of sync
+      removePrefixFromShard(area, prefix);
+    } else {
+      // Remove prefix from KvStore and flood deletion by setting deleted
+      // value.
+      const auto prefixKeyStr =
+          PrefixKey(nodeId_, prefix, area).getPrefixKeyV2();
+      pendingKvRequests_.try_emplace(area, AreaId{area})
+          .first->second.addUnsetKey(
+              prefixKeyStr, createDeletedPrefixDbStr({entry}));
+    }
 
     XLOG(DBG1) << "[Prefix Withdraw] "
                << "Area: " << area << ", " << toString(*entry.prefix());
@@ -623,6 +655,111 @@ PrefixManager::deleteKvStoreKeyHelper(
   }
 }
 
+std::string
+PrefixManager::createDeletedPrefixDbStr(
+    std::vector<thrift::PrefixEntry> prefixEntries) {
+  // Prepare thrift::PrefixDatabase object for deletion
+  thrift::PrefixDatabase deletedPrefixDb;
+  deletedPrefixDb.thisNodeName() = nodeId_;
+  deletedPrefixDb.deletePrefix() = true;
+  deletedPrefixDb.prefixEntries() = std::move(prefixEntries);
+  return writeThriftObjStr(std::move(deletedPrefixDb), serializer_);
+}
+
+void
+PrefixManager::addPrefixToShard(
+    const std::string& area, const thrift::PrefixEntry& tPrefixEntry) {
+  const auto network = toIPNetwork(*tPrefixEntry.prefix());
+  const auto shardId =
+      PrefixShardKey::getShardId(network, config_->getPrefixDbShardCount());
+  prefixDbShards_[area][shardId].insert_or_assign(network, tPrefixEntry);
+  changedPrefixDbShards_[area].emplace(shardId);
+}
+
+void
+PrefixManager::removePrefixFromShard(
+    const std::string& area, const folly::CIDRNetwork& prefix) {
+  const auto shardId =
+      PrefixShardKey::getShardId(prefix, config_->getPrefixDbShardCount());
+  auto areaIt = prefixDbShards_.find(area);
+  if (areaIt == prefixDbShards_.end()) {
+    return;
+  }
+  auto shardIt = areaIt->second.find(shardId);
+  if (shardIt == areaIt->second.end() or shardIt->second.erase(prefix) == 0) {
+    return;
+  }
+  if (shardIt->second.empty()) {
+    areaIt->second.erase(shardIt);
+  }
+  changedPrefixDbShards_[area].emplace(shardId);
+}
+
+void
+PrefixManager::updatePrefixDbShardKeys() {
+  for (const auto& [area, shardIds] : changedPrefixDbShards_) {
+    auto& batchRequest =
+        pendingKvRequests_.try_emplace(area, AreaId{area}).first->second;
+    auto& areaShards = prefixDbShards_[area];
+    for (const auto shardId : shardIds) {
+      const auto prefixShardKeyStr =
+          PrefixShardKey(nodeId_, shardId).getPrefixShardKey();
+      auto shardIt = areaShards.find(shardId);
+      if (shardIt == areaShards.end()) {
+        // All prefixes of the shard are withdrawn. Clear the key.
+        batchRequest.addUnsetKey(
+            prefixShardKeyStr, createDeletedPrefixDbStr({}));
+        continue;
+      }
+
+      std::vector<thrift::PrefixEntry> prefixEntries;
+      prefixEntries.reserve(shardIt->second.size());
+      for (const auto& [_, tPrefixEntry] : shardIt->second) {
+        prefixEntries.emplace_back(tPrefixEntry);
+      }
+      auto prefixDb = createPrefixDb(nodeId_, std::move(prefixEntries));
+      batchRequest.addPersistKey(
+          prefixShardKeyStr,
+          writeThriftObjStr(std::move(prefixDb), serializer_));
+    }
+    fb303::fbData->addStatValue(
+        "prefix_manager.prefix_db_shard_updates", shardIds.size(), fb303::SUM);
+  }
+  changedPrefixDbShards_.clear();
+
+  // Clear per-prefix keys replaced by shards. Sent with the same batch as the
+  // shards so that subscribers never see the prefixes withdrawn.
+  for (auto& [area, keys] : legacyPrefixKeys_) {
+    auto& batchRequest =
+        pendingKvRequests_.try_emplace(area, AreaId{area}).first->second;
+    for (const auto& [key, network] : keys) {
+      thrift::PrefixEntry entry;
+      entry.prefix() = toIpPrefix(network);
+      batchRequest.addUnsetKey(key, createDeletedPrefixDbStr({entry}));
+    }
+  }
+  legacyPrefixKeys_.clear();
+}
+
+void
+PrefixManager::flushKvStoreRequests() {
+  updatePrefixDbShardKeys();
+
+  for (auto& [area, batchRequest] : pendingKvRequests_) {
+    if (batchRequest.empty()) {
+      continue;
+    }
+    XLOG(DBG1) << fmt::format(
+        "[KvStore Sync] Sending {} key updates to area {}",
+        batchRequest.size(),
+        area);
+    fb303::fbData->addStatValue(
+        "prefix_manager.kvstore_batch_requests", 1, fb303::SUM);
+    kvRequestQueue_.push(std::move(batchRequest));
+  }
+  pendingKvRequests_.clear();
+}
+
 void
 PrefixManager::triggerInitialPrefixDbSync() {
   if (uninitializedPrefixTypes_.empty()) {
@@ -743,6 +880,9 @@ PrefixManager::syncKvStore() {
   // Reset pendingUpdates_ since all pending updates are processed.
   pendingUpdates_.clear();
 
+  // Send out key updates of all processed prefixes, one request per area.
+  flushKvStoreRequests();
+
   // Push originatedRoutes update to staticRouteUpdatesQueue_.
   if (not routeUpdatesForDecision.empty()) {
     CHECK(routeUpdatesForDecision.mplsRoutesToUpdate.empty());
@@ -831,6 +971,35 @@ PrefixManager::syncPrefixesByType(
   return sf;
 }
 
+folly::SemiFuture<bool>
+PrefixManager::syncPrefixesByTypeChunk(
+    thrift::PrefixType prefixType,
+    std::vector<thrift::PrefixEntry> prefixes,
+    bool isFirstChunk,
+    bool isLastChunk) {
+  folly::Promise<bool> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([this,
+                        p = std::move(p),
+                        prefixType = std::move(prefixType),
+                        prefixes = std::move(prefixes),
+                        isFirstChunk,
+                        isLastChunk]() mutable noexcept {
+    if ((not isFirstChunk) and (not chunkedSyncPrefixes_.count(prefixType))) {
+      thrift::OpenrError error;
+      error.message() = fmt::format(
+          "No chunked sync in progress for prefix type {}",
+          toString(prefixType));
+      p.setException(error);
+      return;
+    }
+    auto dstAreas = allAreaIds();
+    p.setValue(syncPrefixesByTypeChunkImpl(
+        prefixType, prefixes, dstAreas, isFirstChunk, isLastChunk));
+  });
+  return sf;
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::PrefixEntry>>>
 PrefixManager::getPrefixes() {
   folly::Promise<std::unique_ptr<std::vector<thrift::PrefixEntry>>> p;
@@ -899,6 +1068,57 @@ PrefixManager::getAdvertisedRoutesFiltered(
   return std::move(sf);
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::AdvertisedRoutesPage>>
+PrefixManager::getAdvertisedRoutesFilteredPage(
+    thrift::AdvertisedRouteFilter filter, thrift::PageParams pageParams) {
+  if (filter.prefixes()) {
+    // Explicit lookup is bounded by the request itself, serve in one page
+    return getAdvertisedRoutesFiltered(std::move(filter))
+        .deferValue([](auto&& routes) {
+          auto page = std::make_unique<thrift::AdvertisedRoutesPage>();
+          page->routes() = std::move(*routes);
+          return page;
+        });
+  }
+
+  auto [p, sf] = folly::makePromiseContract<
+      std::unique_ptr<thrift::AdvertisedRoutesPage>>();
+  runInEventBaseThread([this,
+                        p = std::move(p),
+                        filter = std::move(filter),
+                        pageParams = std::move(pageParams)]() mutable noexcept {
+    try {
+      if (*pageParams.limit() <= 0) {
+        throw std::invalid_argument("Page limit must be positive");
+      }
+      auto page = std::make_unique<thrift::AdvertisedRoutesPage>();
+      auto& routes = *page->routes();
+      size_t budget = *pageParams.limit();
+      auto nextCursor = visitPage(
+          prefixMap_,
+          pageParams.cursor().value_or(thrift::PageCursor()),
+          budget,
+          [&](folly::CIDRNetwork const& prefix,
+              std::unordered_map<thrift::PrefixType, PrefixEntry> const&
+                  prefixEntries) {
+            const auto numRoutes = routes.size();
+            filterAndAddAdvertisedRoute(
+                routes, filter.prefixType(), prefix, prefixEntries);
+            return routes.size() > numRoutes;
+          });
+      if (nextCursor.has_value()) {
+        page->nextCursor() = std::move(*nextCursor);
+      }
+      p.setValue(std::move(page));
+    } catch (std::invalid_argument const& e) {
+      thrift::OpenrError error;
+      error.message() = e.what();
+      p.setException(error);
+    }
+  });
+  return std::move(sf);
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdvertisedRoute>>>
 PrefixManager::getAdvertisedRoutesWithOriginationPolicy(
     thrift::RouteFilterType routeFilterType,
@@ -1093,14 +1313,20 @@ PrefixManager::getOriginatedPrefixes() {
     // convert content inside originatedPrefixDb_ into thrift struct
     auto prefixes =
         std::make_unique<std::vector<thrift::OriginatedPrefixEntry>>();
-    for (auto const& [_, route] : originatedPrefixDb_) {
+    // supporting routes are only tracked as counters, derive them on demand
+    std::unordered_map<folly::CIDRNetwork, std::vector<std::string>>
+        supportingRoutesMap;
+    for (auto const& ribPrefix : ribPrefixDb_) {
+      originatedPrefixTrie_.forEachContaining(
+          ribPrefix.first,
+          [&](const folly::CIDRNetwork& network, OriginatedRoute* const&) {
+            supportingRoutesMap[network].emplace_back(
+                folly::IPAddress::networkToString(ribPrefix));
+          });
+    }
+    for (auto const& [network, route] : originatedPrefixDb_) {
       auto const& prefix = route.originatedPrefix;
-      auto supportingRoutes =
-          folly::gen::from(route.supportingRoutes) |
-          folly::gen::mapped([](const folly::CIDRNetwork& network) {
-            return folly::IPAddress::networkToString(network);
-          }) |
-          folly::gen::as<std::vector<std::string>>();
+      auto supportingRoutes = std::move(supportingRoutesMap[network]);
 
       auto entry = createOriginatedPrefixEntry(
           prefix,
@@ -1418,30 +1644,125 @@ PrefixManager::syncPrefixesByTypeImpl(
     const std::unordered_set<std::string>& dstAreas,
     const std::optional<std::string>& policyName) {
   XLOG(DBG1) << "Syncing prefixes of type " << toString(type);
-  // building these lists so we can call add and remove and get detailed
-  // logging
-  std::vector<thrift::PrefixEntry> toAddOrUpdate, toRemove;
-  std::unordered_set<folly::CIDRNetwork> toRemoveSet;
-  for (auto const& [prefix, typeToPrefixes] : prefixMap_) {
-    if (typeToPrefixes.count(type)) {
-      toRemoveSet.emplace(prefix);
-    }
+  std::unordered_set<folly::CIDRNetwork> syncedPrefixes;
+  syncedPrefixes.reserve(tPrefixEntries.size());
+
+  bool updated{false};
+  updated |= advertiseChangedPrefixesImpl(
+      type, tPrefixEntries, dstAreas, policyName, syncedPrefixes);
+  updated |= withdrawUnsyncedPrefixesImpl(type, syncedPrefixes);
+  return updated;
+}
+
+bool
+PrefixManager::syncPrefixesByTypeChunkImpl(
+    thrift::PrefixType type,
+    const std::vector<thrift::PrefixEntry>& tPrefixEntries,
+    const std::unordered_set<std::string>& dstAreas,
+    bool isFirstChunk,
+    bool isLastChunk) {
+  XLOGF(
+      DBG1,
+      "Syncing chunk of {} prefixes of type {} (first: {}, last: {})",
+      tPrefixEntries.size(),
+      toString(type),
+      isFirstChunk,
+      isLastChunk);
+
+  // ATTN: first chunk starts over, abandoning any unfinished chunked sync of
+  //       the same type. Prefixes of the abandoned sync remain advertised
+  //       until withdrawn by the next completed sync.
+  auto& syncedPrefixes = chunkedSyncPrefixes_[type];
+  if (isFirstChunk) {
+    syncedPrefixes.clear();
   }
+
+  bool updated{false};
+  updated |= advertiseChangedPrefixesImpl(
+      type, tPrefixEntries, dstAreas, std::nullopt, syncedPrefixes);
+  if (isLastChunk) {
+    updated |= withdrawUnsyncedPrefixesImpl(type, syncedPrefixes);
+    chunkedSyncPrefixes_.erase(type);
+  }
+  return updated;
+}
+
+bool
+PrefixManager::advertiseChangedPrefixesImpl(
+    thrift::PrefixType type,
+    const std::vector<thrift::PrefixEntry>& tPrefixEntries,
+    const std::unordered_set<std::string>& dstAreas,
+    const std::optional<std::string>& policyName,
+    std::unordered_set<folly::CIDRNetwork>& syncedPrefixes) {
+  std::vector<thrift::PrefixEntry> toAddOrUpdate;
   for (auto const& entry : tPrefixEntries) {
     CHECK(type == *entry.type());
-    toRemoveSet.erase(toIPNetwork(*entry.prefix()));
-    toAddOrUpdate.emplace_back(entry);
-  }
-  for (auto const& prefix : toRemoveSet) {
-    toRemove.emplace_back(*prefixMap_.at(prefix).at(type).tPrefixEntry);
-  }
-  bool updated = false;
-  updated |=
-      ((advertisePrefixesImpl(std::move(toAddOrUpdate), dstAreas, policyName))
-           ? 1
-           : 0);
-  updated |= ((withdrawPrefixesImpl(toRemove)) ? 1 : 0);
-  return updated;
+    auto network = toIPNetwork(*entry.prefix());
+    if (not isPrefixEntryUnchanged(network, entry, dstAreas, policyName)) {
+      toAddOrUpdate.emplace_back(entry);
+    }
+    syncedPrefixes.emplace(std::move(network));
+  }
+  fb303::fbData->addStatValue(
+      "prefix_manager.sync_unchanged_prefixes",
+      tPrefixEntries.size() - toAddOrUpdate.size(),
+      fb303::SUM);
+  return advertisePrefixesImpl(std::move(toAddOrUpdate), dstAreas, policyName);
+}
+
+bool
+PrefixManager::withdrawUnsyncedPrefixesImpl(
+    thrift::PrefixType type,
+    const std::unordered_set<folly::CIDRNetwork>& syncedPrefixes) {
+  std::vector<thrift::PrefixEntry> toRemove;
+  for (auto const& [prefix, typeToPrefixes] : prefixMap_) {
+    auto it = typeToPrefixes.find(type);
+    if (it != typeToPrefixes.end() and (not syncedPrefixes.count(prefix))) {
+      toRemove.emplace_back(*it->second.tPrefixEntry);
+    }
+  }
+  return withdrawPrefixesImpl(toRemove);
+}
+
+bool
+PrefixManager::isPrefixEntryUnchanged(
+    const folly::CIDRNetwork& network,
+    const thrift::PrefixEntry& tPrefixEntry,
+    const std::unordered_set<std::string>& dstAreas,
+    const std::optional<std::string>& policyName) const {
+  const auto& type = *tPrefixEntry.type();
+  const PrefixEntry* storedEntry{nullptr};
+
+  if (policyName) {
+    // Compare against the pre-policy entry. Origination policy never changes
+    // at runtime, hence the same input leads to the same post-policy entry.
+    auto typeIt = originatedPrefixMap_.find(network);
+    if (typeIt == originatedPrefixMap_.end()) {
+      return false;
+    }
+    auto it = typeIt->second.find(type);
+    if (it == typeIt->second.end() or it->second.second != *policyName) {
+      return false;
+    }
+    storedEntry = &it->second.first;
+  } else {
+    auto typeIt = prefixMap_.find(network);
+    if (typeIt == prefixMap_.end()) {
+      return false;
+    }
+    auto it = typeIt->second.find(type);
+    if (it == typeIt->second.end()) {
+      return false;
+    }
+    storedEntry = &it->second;
+  }
+
+  // Same as `PrefixEntry::operator==` against the entry that
+  // advertisePrefixesImpl() would create out of @tPrefixEntry.
+  return *storedEntry->tPrefixEntry == tPrefixEntry and
+      storedEntry->dstAreas == dstAreas and
+      storedEntry->policyMatchData == OpenrPolicyMatchData() and
+      (not storedEntry->policyActionData.has_value());
 }
 
 bool
@@ -1461,56 +1782,43 @@ void
 PrefixManager::aggregatesToAdvertise(const folly::CIDRNetwork& prefix) {
   // ATTN: ignore attribute-ONLY update for existing RIB entries
   //       as it won't affect `supporting_route_cnt`
-  auto [ribPrefixIt, inserted] =
-      ribPrefixDb_.emplace(prefix, std::vector<folly::CIDRNetwork>());
-  if (not inserted) {
+  if (not ribPrefixDb_.emplace(prefix).second) {
     return;
   }
 
-  for (auto& [network, route] : originatedPrefixDb_) {
-    // folly::CIDRNetwork.first -> IPAddress
-    // folly::CIDRNetwork.second -> cidr length
-    if (not prefix.first.inSubnet(network.first, network.second)) {
-      continue;
-    }
-
-    XLOG(DBG1) << "[Route Origination] Adding supporting route "
-               << folly::IPAddress::networkToString(prefix)
-               << " for originated route "
-               << folly::IPAddress::networkToString(network);
+  // originated prefixes containing the route address, same as inSubnet()
+  originatedPrefixTrie_.forEachContaining(
+      prefix.first,
+      [&](const folly::CIDRNetwork& network, OriginatedRoute* const& route) {
+        XLOG(DBG1) << "[Route Origination] Adding supporting route "
+                   << folly::IPAddress::networkToString(prefix)
+                   << " for originated route "
+                   << folly::IPAddress::networkToString(network);
 
-    // reverse mapping: RIB prefixEntry -> OriginatedPrefixes
-    ribPrefixIt->second.emplace_back(network);
-
-    // mapping: OriginatedPrefix -> RIB prefixEntries
-    route.supportingRoutes.emplace(prefix);
-  }
+        ++route->supportingRouteCnt;
+      });
 }
 
 void
 PrefixManager::aggregatesToWithdraw(const folly::CIDRNetwork& prefix) {
   // ignore invalid RIB entry
-  auto ribPrefixIt = ribPrefixDb_.find(prefix);
-  if (ribPrefixIt == ribPrefixDb_.end()) {
+  if (not ribPrefixDb_.erase(prefix)) {
     return;
   }
 
-  // clean mapping
-  for (auto& network : ribPrefixIt->second) {
-    auto originatedPrefixIt = originatedPrefixDb_.find(network);
-    CHECK(originatedPrefixIt != originatedPrefixDb_.end());
-    auto& route = originatedPrefixIt->second;
-
-    XLOG(DBG1) << "[Route Origination] Removing supporting route "
-               << folly::IPAddress::networkToString(prefix)
-               << " for originated route "
-               << folly::IPAddress::networkToString(network);
+  // ATTN: originated prefixes never change after initialization, hence the
+  //       same set of originated prefixes is supported as when advertised.
+  originatedPrefixTrie_.forEachContaining(
+      prefix.first,
+      [&](const folly::CIDRNetwork& network, OriginatedRoute* const& route) {
+        XLOG(DBG1) << "[Route Origination] Removing supporting route "
+                   << folly::IPAddress::networkToString(prefix)
+                   << " for originated route "
+                   << folly::IPAddress::networkToString(network);
 
-    route.supportingRoutes.erase(prefix);
-  }
-
-  // clean local caching
-  ribPrefixDb_.erase(prefix);
+        CHECK_GT(route->supportingRouteCnt, 0);
+        --route->supportingRouteCnt;
+      });
 }
 
 void
@@ -1667,8 +1975,14 @@ PrefixManager::redistributePrefixesAcrossAreas(
       fibRouteUpdate.unicastRoutesToUpdate.size(),
       fibRouteUpdate.unicastRoutesToDelete.size());
 
+  // Redisrtibute RIB route ONLY when there are multiple `areaId` configured.
+  // Supporting routes of originated prefixes are tracked regardless.
+  const bool redistribute = areaToPolicy_.size() > 1;
+  const auto areaIds = allAreaIds();
+
   std::vector<PrefixEntry> advertisedPrefixes{};
   std::vector<thrift::PrefixEntry> withdrawnPrefixes{};
+  size_t unchangedCnt{0};
 
   // ATTN: Routes imported from local BGP won't show up inside
   // `fibRouteUpdate`. However, local-originated static route
@@ -1691,6 +2005,13 @@ PrefixManager::redistributePrefixesAcrossAreas(
       }
     }
 
+    // Adjust supporting route count due to prefix advertisement
+    aggregatesToAdvertise(prefix);
+
+    if (not redistribute) {
+      continue;
+    }
+
     // Update interested mutable transitive attributes.
     //
     // For OpenR route representation, referring to
@@ -1715,21 +2036,32 @@ PrefixManager::redistributePrefixesAcrossAreas(
     resetNonTransitiveAttrs(prefixEntry);
 
     // Populate routes to be advertised to KvStore
-    auto dstAreas = allAreaIds();
+    auto dstAreas = areaIds;
     for (const auto& nh : route.nexthops) {
       if (nh.area().has_value()) {
         dstAreas.erase(*nh.area());
       }
     }
+
+    // Keep the redistributed entry by reference if neither its attributes
+    // nor its destination areas changed, e.g. upon nexthop ONLY change within
+    // the same area. This skips re-building and re-comparing the entry.
+    const auto* redistributedEntry = getRedistributedPrefixEntry(prefix);
+    if (redistributedEntry and
+        *redistributedEntry->tPrefixEntry == prefixEntry and
+        redistributedEntry->dstAreas == dstAreas and
+        redistributedEntry->policyActionData == policyActionData and
+        redistributedEntry->policyMatchData == policyMatchData) {
+      ++unchangedCnt;
+      continue;
+    }
+
     advertisedPrefixes.emplace_back(
         std::make_shared<thrift::PrefixEntry>(std::move(prefixEntry)),
         std::move(dstAreas),
         policyActionData,
         policyMatchData,
         route.localRouteConsidered /* prefer over local*/);
-
-    // Adjust supporting route count due to prefix advertisement
-    aggregatesToAdvertise(prefix);
   }
 
   // Delete unicast routes
@@ -1741,28 +2073,43 @@ PrefixManager::redistributePrefixesAcrossAreas(
       continue;
     }
 
-    // Routes to be withdrawn via KvStore
-    withdrawnPrefixes.emplace_back(
-        createPrefixEntry(toIpPrefix(prefix), thrift::PrefixType::RIB));
-
     // adjust supporting route count due to prefix withdrawn
     aggregatesToWithdraw(prefix);
+
+    // Routes to be withdrawn via KvStore, ONLY if redistributed before
+    if (redistribute and getRedistributedPrefixEntry(prefix)) {
+      withdrawnPrefixes.emplace_back(
+          createPrefixEntry(toIpPrefix(prefix), thrift::PrefixType::RIB));
+    }
   }
 
   // Maybe advertise/withdrawn for local originated routes
   processOriginatedPrefixes();
 
-  // Redisrtibute RIB route ONLY when there are multiple `areaId` configured .
   // We want to keep processFibRouteUpdates() running as dynamic
   // configuration could add/remove areas.
-  if (areaToPolicy_.size() > 1) {
-    advertisePrefixesImpl(advertisedPrefixes);
-    withdrawPrefixesImpl(withdrawnPrefixes);
-  }
+  advertisePrefixesImpl(advertisedPrefixes);
+  withdrawPrefixesImpl(withdrawnPrefixes);
+
+  fb303::fbData->addStatValue(
+      "prefix_manager.redistribution_unchanged_routes",
+      unchangedCnt,
+      fb303::SUM);
 
   // ignore mpls updates
 }
 
+const PrefixEntry*
+PrefixManager::getRedistributedPrefixEntry(
+    const folly::CIDRNetwork& prefix) const {
+  auto typeIt = prefixMap_.find(prefix);
+  if (typeIt == prefixMap_.end()) {
+    return nullptr;
+  }
+  auto it = typeIt->second.find(thrift::PrefixType::RIB);
+  return it == typeIt->second.end() ? nullptr : &it->second;
+}
+
 std::unordered_set<std::string>
 PrefixManager::allAreaIds() {
   std::unordered_set<std::string> allAreaIds;
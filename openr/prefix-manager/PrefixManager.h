@@ -13,6 +13,7 @@
 
 #include <openr/common/AsyncThrottle.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/PrefixTrie.h>
 #include <openr/common/Types.h>
 #include <openr/common/Util.h>
 #include <openr/config/Config.h>
@@ -110,6 +111,9 @@ class PrefixManager final : public OpenrEventBase {
    *  - withdraw prefixes
    *  - withdraw prefixes by type
    *  - sync prefixes by type: replace all prefixes of @type w/ @prefixes
+   *  - sync prefixes by type in chunks: same as above, but @prefixes are
+   *    split across multiple calls. Prefixes of @type not present in any
+   *    chunk are withdrawn upon the last chunk.
    *
    *
    * Read APIs - dump internal prefixDb
@@ -127,6 +131,12 @@ class PrefixManager final : public OpenrEventBase {
   folly::SemiFuture<bool> syncPrefixesByType(
       thrift::PrefixType prefixType, std::vector<thrift::PrefixEntry> prefixes);
 
+  folly::SemiFuture<bool> syncPrefixesByTypeChunk(
+      thrift::PrefixType prefixType,
+      std::vector<thrift::PrefixEntry> prefixes,
+      bool isFirstChunk,
+      bool isLastChunk);
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::PrefixEntry>>>
   getPrefixes();
 
@@ -136,6 +146,15 @@ class PrefixManager final : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdvertisedRouteDetail>>>
   getAdvertisedRoutesFiltered(thrift::AdvertisedRouteFilter filter);
 
+  /*
+   * Paginated variant of getAdvertisedRoutesFiltered(). Returns at most
+   * `pageParams.limit` routes and the cursor to fetch the next page with.
+   * Explicitly requested prefixes are always returned in a single page.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::AdvertisedRoutesPage>>
+  getAdvertisedRoutesFilteredPage(
+      thrift::AdvertisedRouteFilter filter, thrift::PageParams pageParams);
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::OriginatedPrefixEntry>>>
   getOriginatedPrefixes();
 
@@ -245,6 +264,38 @@ class PrefixManager final : public OpenrEventBase {
       const std::vector<thrift::PrefixEntry>& tPrefixEntries,
       const std::unordered_set<std::string>& dstAreas,
       const std::optional<std::string>& policyName = std::nullopt);
+  bool syncPrefixesByTypeChunkImpl(
+      thrift::PrefixType type,
+      const std::vector<thrift::PrefixEntry>& tPrefixEntries,
+      const std::unordered_set<std::string>& dstAreas,
+      bool isFirstChunk,
+      bool isLastChunk);
+
+  /*
+   * Helpers of sync prefixes by type.
+   *
+   * Advertise entries of @tPrefixEntries which differ from the stored ones,
+   * and record all of them into @syncedPrefixes. Unchanged entries are
+   * compared in place and never copied.
+   */
+  bool advertiseChangedPrefixesImpl(
+      thrift::PrefixType type,
+      const std::vector<thrift::PrefixEntry>& tPrefixEntries,
+      const std::unordered_set<std::string>& dstAreas,
+      const std::optional<std::string>& policyName,
+      std::unordered_set<folly::CIDRNetwork>& syncedPrefixes);
+
+  // Withdraw stored prefixes of @type which are not in @syncedPrefixes
+  bool withdrawUnsyncedPrefixesImpl(
+      thrift::PrefixType type,
+      const std::unordered_set<folly::CIDRNetwork>& syncedPrefixes);
+
+  // Check if the stored entry is the same as what @tPrefixEntry would become
+  bool isPrefixEntryUnchanged(
+      const folly::CIDRNetwork& network,
+      const thrift::PrefixEntry& tPrefixEntry,
+      const std::unordered_set<std::string>& dstAreas,
+      const std::optional<std::string>& policyName) const;
   std::vector<PrefixEntry> applyOriginationPolicy(
       const std::vector<PrefixEntry>& prefixEntries,
       const std::string& policyName);
@@ -288,6 +339,23 @@ class PrefixManager final : public OpenrEventBase {
       const folly::CIDRNetwork& prefix,
       const std::unordered_set<std::string>& deletedArea);
 
+  // Add/remove prefix entry of the area to/from its prefix database shard.
+  void addPrefixToShard(
+      const std::string& area, const thrift::PrefixEntry& tPrefixEntry);
+  void removePrefixFromShard(
+      const std::string& area, const folly::CIDRNetwork& prefix);
+
+  // Add KvStore key updates of changed prefix database shards and
+  // to-be-cleared legacy per-prefix keys into `pendingKvRequests_`.
+  void updatePrefixDbShardKeys();
+
+  // Serialized prefix database to withdraw given prefix entries.
+  std::string createDeletedPrefixDbStr(
+      std::vector<thrift::PrefixEntry> prefixEntries);
+
+  // Push key updates accumulated in `pendingKvRequests_` to KvStore.
+  void flushKvStoreRequests();
+
   /*
    * Perform best entry selection among the given prefixTypeToEntry
    */
@@ -361,6 +429,11 @@ class PrefixManager final : public OpenrEventBase {
   // routers in BGP.
   void redistributePrefixesAcrossAreas(DecisionRouteUpdate&& fibRouteUpdate);
 
+  // Get entry of the prefix redistributed across areas, i.e. `prefixMap_`
+  // entry of RIB type. Return nullptr if not redistributed.
+  const PrefixEntry* getRedistributedPrefixEntry(
+      const folly::CIDRNetwork& prefix) const;
+
   // get all areaIds
   std::unordered_set<std::string> allAreaIds();
 
@@ -393,6 +466,11 @@ class PrefixManager final : public OpenrEventBase {
   // queue to send key-value update requests to KvStore
   messaging::ReplicateQueue<KeyValueRequest>& kvRequestQueue_;
 
+  // Key updates accumulated during one syncKvStore() run. Flushed as a single
+  // BatchKeyValueRequest per area at the end of the run.
+  std::unordered_map<std::string /* area */, BatchKeyValueRequest>
+      pendingKvRequests_;
+
   // Queue to publish prefix updates to bgprib
   messaging::ReplicateQueue<DecisionRouteUpdate>& prefixMgrRouteUpdatesQueue_;
 
@@ -413,6 +491,10 @@ class PrefixManager final : public OpenrEventBase {
       folly::CIDRNetwork,
       std::unordered_map<thrift::PrefixType, PrefixEntry>>
       prefixMap_;
+  // Prefixes received so far by in-progress chunked syncs, per prefix type.
+  std::unordered_map<thrift::PrefixType, std::unordered_set<folly::CIDRNetwork>>
+      chunkedSyncPrefixes_;
+
   // Advertised prefixes in KvStore and associated best PrefixEntry.
   std::unordered_map<folly::CIDRNetwork, PrefixEntry> advertisedPrefixEntries_;
 
@@ -445,6 +527,31 @@ class PrefixManager final : public OpenrEventBase {
   };
   std::unordered_map<folly::CIDRNetwork, AdervertiseStatus> advertiseStatus_{};
 
+  /*
+   * [Sharded Prefix Database]
+   *
+   * With `prefix_db_shard_count` configured, advertised prefixes are packed
+   * into a bounded number of `prefix:<node>:<shard>` keys per area instead of
+   * one key per prefix. Shards are rewritten once per syncKvStore() run if
+   * any of their prefixes changed.
+   */
+  // area -> shardId -> prefix -> post-policy entry advertised in the shard
+  std::unordered_map<
+      std::string,
+      std::unordered_map<
+          uint32_t,
+          std::map<folly::CIDRNetwork, thrift::PrefixEntry>>>
+      prefixDbShards_;
+  // area -> shards changed since last flush to KvStore
+  std::unordered_map<std::string, std::unordered_set<uint32_t>>
+      changedPrefixDbShards_;
+  // area -> self-originated per-prefix keys (e.g. from previous incarnation)
+  // to be cleared from KvStore after migrating to sharded prefix database
+  std::unordered_map<
+      std::string,
+      std::unordered_map<std::string /* key */, folly::CIDRNetwork>>
+      legacyPrefixKeys_;
+
   // store pending updates from advertise/withdraw operation
   detail::PrefixManagerPendingUpdates pendingUpdates_;
 
@@ -471,19 +578,16 @@ class PrefixManager final : public OpenrEventBase {
     // unicastEntry contains nexthops info
     RibUnicastEntry unicastEntry;
 
-    // supporting routes for this originated prefix
-    std::unordered_set<folly::CIDRNetwork> supportingRoutes{};
+    // number of supporting routes for this originated prefix
+    size_t supportingRouteCnt{0};
 
     // flag indicates is local route has been originated
     bool isAdvertised{false};
 
     OriginatedRoute(
         const thrift::OriginatedPrefix& originatedPrefix,
-        const RibUnicastEntry& unicastEntry,
-        const std::unordered_set<folly::CIDRNetwork>& supportingRoutes)
-        : originatedPrefix(originatedPrefix),
-          unicastEntry(unicastEntry),
-          supportingRoutes(supportingRoutes) {}
+        const RibUnicastEntry& unicastEntry)
+        : originatedPrefix(originatedPrefix), unicastEntry(unicastEntry) {}
 
     /*
      * Util function for route-agg check
@@ -498,19 +602,19 @@ class PrefixManager final : public OpenrEventBase {
       const auto& minSupportingRouteCnt =
           *originatedPrefix.minimum_supporting_routes();
       return (not isAdvertised) and
-          (supportingRoutes.size() >= minSupportingRouteCnt);
+          (supportingRouteCnt >= minSupportingRouteCnt);
     }
 
     bool
     shouldWithdraw() const {
       const auto& minSupportingRouteCnt =
           *originatedPrefix.minimum_supporting_routes();
-      return isAdvertised and (supportingRoutes.size() < minSupportingRouteCnt);
+      return isAdvertised and (supportingRouteCnt < minSupportingRouteCnt);
     }
 
     bool
     supportingRoutesFulfilled() const {
-      return supportingRoutes.size() >=
+      return supportingRouteCnt >=
           *originatedPrefix.minimum_supporting_routes();
     }
   };
@@ -522,22 +626,24 @@ class PrefixManager final : public OpenrEventBase {
   bool preferOpenrOriginatedRoutes_{false};
 
   /*
-   * prefixes to be originated from prefix-manager
-   * ATTN: to support quick information retrieval, cache the mapping:
-   *
-   *  OriginatedPrefix -> set of FIB prefixEntry(i.e. supporting routes)
+   * prefixes to be originated from prefix-manager, with the number of
+   * supporting routes for each of them.
    */
   std::unordered_map<folly::CIDRNetwork, OriginatedRoute> originatedPrefixDb_;
 
   /*
-   * prefixes received from OpenR/Fib.
-   * ATTN: to avoid loop through ALL entries inside `originatedPrefixes`,
-   *       cache the reverse mapping:
-   *
-   *  FIB prefixEntry -> vector of OriginatedPrefix(i.e. supported routes)
+   * Trie of originated prefixes pointing into `originatedPrefixDb_`, both are
+   * built once upon initialization and never modified afterwards.
+   * ATTN: to avoid loop through ALL entries inside `originatedPrefixDb_`,
+   *       every FIB prefixEntry looks up its covering originated prefixes
+   *       (i.e. supported routes) in O(prefix length).
+   */
+  PrefixTrie<OriginatedRoute*> originatedPrefixTrie_;
+
+  /*
+   * prefixes received from OpenR/Fib, i.e. candidates of supporting routes.
    */
-  std::unordered_map<folly::CIDRNetwork, std::vector<folly::CIDRNetwork>>
-      ribPrefixDb_;
+  std::unordered_set<folly::CIDRNetwork> ribPrefixDb_;
 
   /*
    * MPLS labels with label routes already programmed by FIB. For one prefix
@@ -113,10 +113,15 @@ class PMToKvStoreBMTestFixture {
     }
   }
 
-  void
+  /*
+   * Wait until `num` prefix keys are flooded by KvStore.
+   * @return: number of publications carrying those keys.
+   */
+  uint32_t
   checkThriftPublication(uint32_t num, bool checkDeletion) {
     auto suspender = folly::BenchmarkSuspender();
     uint32_t total{0};
+    uint32_t numPublications{0};
     auto kvStoreUpdatesQ = kvStoreWrapper_->getReader();
 
     // start measuring time
@@ -131,6 +136,7 @@ class PMToKvStoreBMTestFixture {
       suspender.rehire();
 
       if (auto* pub = std::get_if<thrift::Publication>(&thriftPub.value())) {
+        ++numPublications;
         if (not checkDeletion) {
           total += pub->keyVals()->size();
         } else {
@@ -147,7 +153,7 @@ class PMToKvStoreBMTestFixture {
       suspender.dismiss();
 
       if (total >= num) {
-        return;
+        return numPublications;
       }
 
       // wait until all keys are populated
@@ -225,12 +231,14 @@ BM_PrefixManagerAdvertisePrefixes(
 
     // advertise prefixes into `KvStore` and make sure update received
     prefixMgr->advertisePrefixes(prefixesToAdvertise).get();
-    testFixture->checkThriftPublication(numOfUpdatedPrefixes, false);
+    auto numPublications =
+        testFixture->checkThriftPublication(numOfUpdatedPrefixes, false);
 
     // Stop measuring benchmark time
     suspender.rehire();
 
     if (record) {
+      counters["kvstore_publications"] = numPublications;
       auto mem = sysMetrics.getVirtualMemBytes();
       if (mem.has_value()) {
         counters["memory_after_operation(MB)"] = mem.value() / 1024 / 1024;
@@ -291,12 +299,14 @@ BM_PrefixManagerWithdrawPrefixes(
 
     // withdraw prefixes from `KvStore` and make sure update received
     prefixMgr->withdrawPrefixes(prefixesToWithdraw).get();
-    testFixture->checkThriftPublication(numOfWithdrawnPrefixes, true);
+    auto numPublications =
+        testFixture->checkThriftPublication(numOfWithdrawnPrefixes, true);
 
     // Stop measuring benchmark time
     suspender.rehire();
 
     if (record) {
+      counters["kvstore_publications"] = numPublications;
       auto mem = sysMetrics.getVirtualMemBytes();
       if (mem.has_value()) {
         counters["memory_after_operation(MB)"] = mem.value() / 1024 / 1024;
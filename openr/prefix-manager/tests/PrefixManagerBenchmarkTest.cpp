@@ -123,23 +123,27 @@ class PrefixManagerBenchmarkTestFixture {
 
     // Start measuring time
     suspender.dismiss();
-    while (true) {
-      auto total = kvRequestReaderQ.size();
-      if (total != 0) {
-        // Stop measuring time
-        suspender.rehire();
-
-        if (total >= num) {
-          return;
-        }
-
-        // Start measuring time again
-        suspender.dismiss();
+    while (numKeysRequested_ < num) {
+      auto maybeRequest = kvRequestReaderQ.get();
+      if (maybeRequest.hasError()) {
+        break;
       }
 
-      // Wait until all keys are populated
-      std::this_thread::yield();
+      // Stop measuring time
+      suspender.rehire();
+
+      // One batch request carries keys of many prefixes
+      if (auto pBatchRequest =
+              std::get_if<BatchKeyValueRequest>(&maybeRequest.value())) {
+        numKeysRequested_ += pBatchRequest->size();
+      } else {
+        ++numKeysRequested_;
+      }
+
+      // Start measuring time again
+      suspender.dismiss();
     }
+    suspender.rehire();
   }
 
   // Queue for publishing entries to PrefixManager
@@ -157,6 +161,8 @@ class PrefixManagerBenchmarkTestFixture {
   std::unique_ptr<KvStoreWrapper<thrift::KvStoreServiceAsyncClient>>
       kvStoreWrapper_;
   PrefixGenerator prefixGenerator_; // for prefixes generation usage
+  // Total number of keys received from kvRequestQueue so far
+  uint32_t numKeysRequested_{0};
 };
 
 /*
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/IPAddress.h>
 #include <folly/init/Init.h>
 #include <glog/logging.h>
@@ -29,6 +30,8 @@
 
 using namespace openr;
 
+namespace fb303 = facebook::fb303;
+
 using apache::thrift::CompactSerializer;
 
 namespace {
@@ -344,6 +347,54 @@ TEST_F(PrefixManagerTestFixture, RemoveUpdateType) {
   EXPECT_TRUE(prefixManager->withdrawPrefixes({prefixEntry8}).get());
 }
 
+/*
+ * Verify chunked sync advertises prefixes of every chunk and withdraws the
+ * prefixes of the same type missing from all chunks upon the last chunk.
+ */
+TEST_F(PrefixManagerTestFixture, SyncPrefixesByTypeChunk) {
+  const auto type = thrift::PrefixType::PREFIX_ALLOCATOR;
+  EXPECT_TRUE(
+      prefixManager->advertisePrefixes({prefixEntry2, prefixEntry4}).get());
+
+  // chunk without a sync in progress is rejected
+  EXPECT_THROW(
+      prefixManager->syncPrefixesByTypeChunk(type, {prefixEntry6}, false, true)
+          .get(),
+      thrift::OpenrError);
+
+  // unchanged prefix, nothing to update
+  EXPECT_FALSE(
+      prefixManager->syncPrefixesByTypeChunk(type, {prefixEntry2}, true, false)
+          .get());
+  // new prefix advertised right away
+  EXPECT_TRUE(
+      prefixManager->syncPrefixesByTypeChunk(type, {prefixEntry6}, false, false)
+          .get());
+  auto prefixes = prefixManager->getPrefixesByType(type).get();
+  EXPECT_EQ(3, prefixes->size());
+
+  // last chunk withdraws prefixEntry4 of the same type
+  EXPECT_TRUE(
+      prefixManager->syncPrefixesByTypeChunk(type, {prefixEntry8}, false, true)
+          .get());
+  prefixes = prefixManager->getPrefixesByType(type).get();
+  EXPECT_THAT(
+      *prefixes,
+      testing::UnorderedElementsAre(prefixEntry2, prefixEntry6, prefixEntry8));
+
+  // sync is completed, further chunks must start a new one
+  EXPECT_THROW(
+      prefixManager->syncPrefixesByTypeChunk(type, {}, false, true).get(),
+      thrift::OpenrError);
+
+  // single chunk sync is the same as syncPrefixesByType()
+  EXPECT_TRUE(
+      prefixManager->syncPrefixesByTypeChunk(type, {prefixEntry2}, true, true)
+          .get());
+  prefixes = prefixManager->getPrefixesByType(type).get();
+  EXPECT_THAT(*prefixes, testing::UnorderedElementsAre(prefixEntry2));
+}
+
 TEST_F(PrefixManagerTestFixture, VerifyKvStore) {
   int scheduleAt{0};
   auto prefixKey =
@@ -843,6 +894,90 @@ TEST_F(PrefixManagerSmallTtlTestFixture, PrefixWithdrawExpiry) {
   evb.run();
 }
 
+class PrefixManagerShardedPrefixDbTestFixture
+    : public PrefixManagerTestFixture {
+ public:
+  thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = PrefixManagerTestFixture::createConfig();
+    // pack all prefixes into one shard to ease verification
+    tConfig.prefix_db_shard_count() = 1;
+    return tConfig;
+  }
+
+  // Get prefix database of the only shard
+  std::optional<thrift::PrefixDatabase>
+  getShardPrefixDb() {
+    auto maybeValue = kvStoreWrapper->getKey(
+        kTestingAreaName, PrefixShardKey(nodeId_, 0).getPrefixShardKey());
+    if (not maybeValue.has_value()) {
+      return std::nullopt;
+    }
+    return readThriftObjStr<thrift::PrefixDatabase>(
+        *maybeValue->value(), serializer);
+  }
+};
+
+/**
+ * Verify prefixes are advertised/withdrawn with prefix database shard instead
+ * of per-prefix keys.
+ */
+TEST_F(PrefixManagerShardedPrefixDbTestFixture, AdvertiseWithdrawPrefixes) {
+  int scheduleAt{0};
+  const auto prefixKeyStr1 =
+      PrefixKey(nodeId_, toIPNetwork(*prefixEntry1.prefix()), kTestingAreaName)
+          .getPrefixKeyV2();
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(scheduleAt += 0), [&]() noexcept {
+        prefixManager->advertisePrefixes({prefixEntry1, prefixEntry2}).get();
+      });
+
+  // both prefixes are packed into the shard
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        EXPECT_FALSE(
+            kvStoreWrapper->getKey(kTestingAreaName, prefixKeyStr1)
+                .has_value());
+        auto prefixDb = getShardPrefixDb();
+        ASSERT_TRUE(prefixDb.has_value());
+        EXPECT_FALSE(*prefixDb->deletePrefix());
+        EXPECT_EQ(2, prefixDb->prefixEntries()->size());
+
+        prefixManager->withdrawPrefixes({prefixEntry1}).get();
+      });
+
+  // only prefixEntry2 is left inside the shard
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        auto prefixDb = getShardPrefixDb();
+        ASSERT_TRUE(prefixDb.has_value());
+        ASSERT_EQ(1, prefixDb->prefixEntries()->size());
+        EXPECT_EQ(
+            *prefixEntry2.prefix(), *prefixDb->prefixEntries()->at(0).prefix());
+
+        prefixManager->withdrawPrefixes({prefixEntry2}).get();
+      });
+
+  // shard is withdrawn
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        auto prefixDb = getShardPrefixDb();
+        ASSERT_TRUE(prefixDb.has_value());
+        EXPECT_TRUE(*prefixDb->deletePrefix());
+        EXPECT_EQ(0, prefixDb->prefixEntries()->size());
+        evb.stop();
+      });
+
+  evb.run();
+}
+
 TEST_F(PrefixManagerTestFixture, GetPrefixes) {
   prefixManager->advertisePrefixes({prefixEntry1});
   prefixManager->advertisePrefixes({prefixEntry2});
@@ -1207,6 +1342,59 @@ TEST_F(PrefixManagerTestFixture, GetAdvertisedRoutes) {
   }
 }
 
+/**
+ * Verifies `getAdvertisedRoutesFilteredPage` returns every matching route
+ * exactly once across pages.
+ */
+TEST_F(PrefixManagerTestFixture, GetAdvertisedRoutesPaginated) {
+  const size_t kNumPrefixes{50};
+  const size_t kPageLimit{7};
+  // Routes sharing a hash bucket are never split across pages
+  const size_t kMaxPageOverflow{7};
+
+  std::vector<thrift::PrefixEntry> prefixEntries;
+  for (size_t i = 0; i < kNumPrefixes; ++i) {
+    prefixEntries.emplace_back(createPrefixEntry(
+        toIpPrefix(fmt::format("10.0.{}.0/24", i)),
+        thrift::PrefixType::DEFAULT));
+  }
+  prefixManager->advertisePrefixes(std::move(prefixEntries)).get();
+  prefixManager
+      ->advertisePrefixes({createPrefixEntry(
+          toIpPrefix("11.0.0.0/8"), thrift::PrefixType::LOOPBACK)})
+      .get();
+
+  thrift::AdvertisedRouteFilter filter;
+  filter.prefixType() = thrift::PrefixType::DEFAULT;
+  thrift::PageParams pageParams;
+  pageParams.limit() = kPageLimit;
+  std::unordered_set<thrift::IpPrefix> prefixes;
+  while (true) {
+    auto page = prefixManager
+                    ->getAdvertisedRoutesFilteredPage(filter, pageParams)
+                    .get();
+    EXPECT_LE(page->routes()->size(), kPageLimit + kMaxPageOverflow);
+    for (auto const& routeDetail : *page->routes()) {
+      EXPECT_TRUE(prefixes.insert(*routeDetail.prefix()).second);
+      ASSERT_EQ(1, routeDetail.routes()->size());
+      EXPECT_EQ(thrift::PrefixType::DEFAULT, routeDetail.routes()->at(0).key());
+    }
+    if (not page->nextCursor().has_value()) {
+      break;
+    }
+    pageParams.cursor() = *page->nextCursor();
+  }
+  EXPECT_EQ(kNumPrefixes, prefixes.size());
+  EXPECT_EQ(0, prefixes.count(toIpPrefix("11.0.0.0/8")));
+
+  // Non-positive page limit is rejected
+  pageParams = thrift::PageParams();
+  pageParams.limit() = 0;
+  EXPECT_THROW(
+      prefixManager->getAdvertisedRoutesFilteredPage(filter, pageParams).get(),
+      thrift::OpenrError);
+}
+
 /**
  * Verifies the test case with empty entries. Other cases are exercised above
  */
@@ -1540,6 +1728,26 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
     EXPECT_EQ(0, gotDeleted.size());
   }
 
+  //
+  // 3.1 replace nexthop within area A, ecmp areas = [A, C], best area = A
+  //    => no update, redistributed entry is kept as is
+  //
+  const auto unchangedCounter{
+      "prefix_manager.redistribution_unchanged_routes.sum"};
+  const auto unchangedCnt = fb303::fbData->getCounters()[unchangedCounter];
+  auto path1_3_1 = createNextHop(
+      toBinaryAddress(folly::IPAddress("fe80::3")),
+      std::string("iface_1_3_1"),
+      1);
+  path1_3_1.area() = areaStrA;
+  unicast1A.nexthops.erase(path1_2_1);
+  unicast1A.nexthops.emplace(path1_3_1);
+  {
+    DecisionRouteUpdate routeUpdate;
+    routeUpdate.addRouteToUpdate(unicast1A);
+    fibRouteUpdatesQueue.push(std::move(routeUpdate));
+  }
+
   //
   // 4. change ecmp group to [B], best area = B
   //    => B receive withdraw, {A, C} receive update
@@ -1582,6 +1790,10 @@ TEST_F(PrefixManagerMultiAreaTestFixture, DecisionRouteNexthopUpdates) {
 
     EXPECT_EQ(1, gotDeleted.size());
     EXPECT_EQ(addr1, *gotDeleted.at(prefixKeyAreaB).prefix());
+
+    // route update of step 3.1 is processed in order before this one
+    EXPECT_EQ(
+        unchangedCnt + 1, fb303::fbData->getCounters()[unchangedCounter]);
   }
 
   //
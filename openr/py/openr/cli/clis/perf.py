@@ -13,6 +13,7 @@ from openr.cli.utils.options import breeze_option
 class PerfCli(object):
     def __init__(self):
         self.perf.add_command(ViewFibCli().fib)
+        self.perf.add_command(TraceCli().trace)
 
     @click.group()
     @click.pass_context
@@ -28,3 +29,24 @@ class ViewFibCli(object):
         """View latest perf log of fib module from this node"""
 
         perf.ViewFibCmd(cli_opts).run()
+
+
+class TraceCli(object):
+    @click.command()
+    @click.option(
+        "--trace-id",
+        default=0,
+        type=int,
+        help="Only dump spans of this trace. Dump all spans by default.",
+    )
+    @click.option(
+        "--output",
+        "-o",
+        default=None,
+        help="File to write Chrome trace JSON into, load it with Perfetto UI.",
+    )
+    @click.pass_obj
+    def trace(cli_opts, trace_id, output):  # noqa: B902
+        """Dump convergence event spans in Chrome trace format"""
+
+        perf.TraceCmd(cli_opts).run(trace_id, output)
@@ -24,6 +24,21 @@ from openr.utils.serializer import serialize_json
 from thrift.python.serializer import deserialize
 
 
+async def fetch_received_routes(
+    client: OpenrCtrlCppClient.Async, route_filter: ctrl_types.ReceivedRouteFilter
+) -> List[ctrl_types.ReceivedRouteDetail]:
+    """
+    Fetch received routes matching the filter from Decision page by page
+    """
+
+    pages = await utils.fetch_all_pages(
+        lambda page_params: client.getReceivedRoutesFilteredPage(
+            route_filter, page_params
+        )
+    )
+    return [route for page in pages for route in page.routes]
+
+
 class DecisionRoutesComputedCmd(OpenrCtrlCmd):
     async def _run(
         self,
@@ -526,7 +541,7 @@ class DecisionValidateCmd(OpenrCtrlCmd):
         adj_filter = ctrl_types.AdjacenciesFilter(selectAreas={area})
         decision_adj_dbs = await client.getDecisionAdjacenciesFiltered(adj_filter)
         route_filter = ctrl_types.ReceivedRouteFilter(areaName=area)
-        decision_prefix_dbs = await client.getReceivedRoutesFiltered(route_filter)
+        decision_prefix_dbs = await fetch_received_routes(client, route_filter)
 
         area_id = await utils.get_area_id(client, area)
         # get LSDB from KvStore
@@ -791,7 +806,7 @@ class ReceivedRoutesCmd(OpenrCtrlCmd):
         )
 
         # Get routes
-        return await client.getReceivedRoutesFiltered(route_filter)
+        return await fetch_received_routes(client, route_filter)
 
     async def render(
         self,
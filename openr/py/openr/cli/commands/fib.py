@@ -281,7 +281,7 @@ class FibValidateRoutesCmd(FibAgentCmd):
             # fetch routes from decision module
             decision_route_db = await client.getRouteDbComputed("")
             # fetch routes from fib module
-            fib_route_db = await client.getRouteDb()
+            fib_route_db = await utils.get_route_db_paged(client)
             # fetch link_db from link-monitor module
             lm_links = (await client.getInterfaces()).interfaceDetails
 
@@ -273,6 +273,27 @@ class KvStoreCmdBase(OpenrCtrlCmd):
             )
         return area_to_publication_dict
 
+    async def fetch_keyvals_paged(
+        self,
+        client: OpenrCtrlCppClient.Async,
+        area: str,
+        keyDumpParams: KeyDumpParams,
+    ) -> Publication:
+        """
+        Fetch the keyval publication of the area page by page, so that a large
+        KvStore is never serialized into a single response
+        """
+
+        pages = await utils.fetch_all_pages(
+            lambda page_params: client.getKvStoreKeyValsFilteredAreaPage(
+                keyDumpParams, area, page_params
+            )
+        )
+        key_vals = {}
+        for page in pages:
+            key_vals.update(page.publication.keyVals)
+        return pages[-1].publication(keyVals=key_vals)
+
 
 class KvStoreWithInitAreaCmdBase(KvStoreCmdBase):
     async def _init_area(self, client: OpenrCtrlCppClient.Async) -> None:
@@ -411,8 +432,9 @@ class KeysCmd(KvKeysCmd):
 
         area_kv = {}
         for area in self.areas:
-            resp = await client.getKvStoreKeyValsFilteredArea(keyDumpParams, area)
-            area_kv[area] = resp
+            area_kv[area] = await self.fetch_keyvals_paged(
+                client, area, keyDumpParams
+            )
 
         self.print_kvstore_keys(area_kv, ttl, json)
 
@@ -6,6 +6,7 @@
 
 
 from builtins import range
+from typing import Optional
 
 import tabulate
 from openr.cli.utils.commands import OpenrCtrlCmd
@@ -35,3 +36,21 @@ class ViewFibCmd(OpenrCtrlCmd):
             print("Perf Event Item: {}, total duration: {}ms".format(i, total_duration))
             print(tabulate.tabulate(rows, headers=headers))
             print()
+
+
+class TraceCmd(OpenrCtrlCmd):
+    async def _run(
+        self,
+        client: OpenrCtrlCppClient.Async,
+        trace_id: int,
+        output: Optional[str],
+        *args,
+        **kwargs,
+    ) -> None:
+        trace = await client.getTraceEvents(trace_id)
+        if output is None:
+            print(trace)
+            return
+        with open(output, "w") as f:
+            f.write(trace)
+        print(f"Wrote trace to {output}")
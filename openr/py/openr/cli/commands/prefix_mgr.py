@@ -170,8 +170,13 @@ class AdvertisedRoutesCmd(PrefixMgrCmd):
         # Create filter
         route_filter = get_advertised_route_filter(prefixes, prefix_type)
 
-        # Get routes
-        return await client.getAdvertisedRoutesFiltered(route_filter)
+        # Get routes page by page
+        pages = await utils.fetch_all_pages(
+            lambda page_params: client.getAdvertisedRoutesFilteredPage(
+                route_filter, page_params
+            )
+        )
+        return [route for page in pages for route in page.routes]
 
     async def render(
         self, routes: Sequence[ctrl_types.AdvertisedRouteDetail], detailed: bool
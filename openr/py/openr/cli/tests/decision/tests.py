@@ -14,6 +14,7 @@ from click.testing import CliRunner
 from later.unittest import TestCase
 from openr.cli.clis import decision
 from openr.cli.tests import helpers
+from openr.thrift.OpenrCtrl import thrift_types as ctrl_types
 
 from .fixtures import (
     AREA_SUMMARIES,
@@ -63,8 +64,8 @@ class CliDecisionTests(TestCase):
             DECISION_ADJ_DBS_OK
         )
         # Have routes returned
-        mocked_returned_connection.getReceivedRoutesFiltered.return_value = (
-            RECEIVED_ROUTES_DB_OK
+        mocked_returned_connection.getReceivedRoutesFilteredPage.return_value = (
+            ctrl_types.ReceivedRoutesPage(routes=RECEIVED_ROUTES_DB_OK)
         )
         # Have kvstore data returned
         mocked_returned_connection.getKvStoreKeyValsFilteredArea.return_value = (
@@ -145,8 +146,8 @@ class CliDecisionTests(TestCase):
             mocked_openr_client
         )
         # Retturn a List of ReceivedRouteDetail
-        mocked_returned_connection.getReceivedRoutesFiltered.return_value = (
-            MOCKED_RECEIVED_ROUTES
+        mocked_returned_connection.getReceivedRoutesFilteredPage.return_value = (
+            ctrl_types.ReceivedRoutesPage(routes=MOCKED_RECEIVED_ROUTES)
         )
         invoked_return = self.runner.invoke(
             decision.ReceivedRoutesCli.show,
@@ -164,7 +165,9 @@ class CliDecisionTests(TestCase):
             mocked_openr_client
         )
         # Retturn a List of ReceivedRouteDetail
-        mocked_returned_connection.getReceivedRoutesFiltered.return_value = []
+        mocked_returned_connection.getReceivedRoutesFilteredPage.return_value = (
+            ctrl_types.ReceivedRoutesPage(routes=[])
+        )
         invoked_return = self.runner.invoke(
             decision.ReceivedRoutesCli.show,
             ["--json"],
@@ -14,6 +14,7 @@ from later.unittest import TestCase
 from openr.cli.clis import prefix_mgr
 from openr.cli.tests import helpers
 from openr.thrift.KvStore import thrift_types as openr_kvstore_types
+from openr.thrift.OpenrCtrl import thrift_types as ctrl_types
 
 from .fixtures import (
     ADVERTISED_ROUTES_OUTPUT,
@@ -53,8 +54,8 @@ class CliPrefixManagerTests(TestCase):
         mocked_returned_connection = helpers.get_enter_thrift_asyncmock(
             mocked_openr_client
         )
-        mocked_returned_connection.getAdvertisedRoutesFiltered.return_value = (
-            MOCKED_ADVERTISED_ROUTES
+        mocked_returned_connection.getAdvertisedRoutesFilteredPage.return_value = (
+            ctrl_types.AdvertisedRoutesPage(routes=MOCKED_ADVERTISED_ROUTES)
         )
 
         tag_map = {
@@ -18,6 +18,7 @@ from io import TextIOBase
 from itertools import product
 from typing import (
     Any,
+    Awaitable,
     Callable,
     Dict,
     Iterable,
@@ -1995,6 +1996,40 @@ async def get_areas_list(client: OpenrCtrlCppClient.Async) -> Set[str]:
     return {a.area_id for a in (await client.getRunningConfigThrift()).areas}
 
 
+async def fetch_all_pages(
+    fetch_page: Callable[[kv_store_types.PageParams], Awaitable[Any]],
+) -> List[Any]:
+    """
+    Call a paginated dump API page by page, passing back the cursor of the
+    previous page, and return all pages once the last one is received
+    """
+
+    pages = []
+    cursor = None
+    while True:
+        page = await fetch_page(
+            kv_store_types.PageParams(cursor=cursor, limit=Consts.DUMP_PAGE_SIZE)
+        )
+        pages.append(page)
+        cursor = page.nextCursor
+        if cursor is None:
+            return pages
+
+
+async def get_route_db_paged(
+    client: OpenrCtrlCppClient.Async,
+) -> openr_types.RouteDatabase:
+    """
+    Fetch the Fib route database page by page
+    """
+
+    pages = await fetch_all_pages(client.getRouteDbPage)
+    return pages[-1].routeDb(
+        unicastRoutes=[r for page in pages for r in page.routeDb.unicastRoutes],
+        mplsRoutes=[r for page in pages for r in page.routeDb.mplsRoutes],
+    )
+
+
 # This API is used by commands that need one and only one
 # area ID. For older images that don't support area feature, this API will
 # return 'None'. If area ID is passed, API checks if it's valid and returns
@@ -18,6 +18,8 @@ class Consts:
     DEFAULT_FIB_AGENT_PORT = 5909
 
     TIMEOUT_MS = 10000  # 10 seconds
+    # Max number of entries fetched per call from paginated dump APIs
+    DUMP_PAGE_SIZE = 1000
     CONST_TTL_INF = -(2**31)
     IP_TOS = 192
     ADJ_DB_MARKER = "adj:"
@@ -16,10 +16,12 @@
 #include <openr/common/EventLogger.h>
 #include <openr/common/LsdbUtil.h>
 #include <openr/common/NetworkUtil.h>
+#include <openr/common/Tracing.h>
 #include <openr/common/Types.h>
 #include <openr/if/gen-cpp2/Types_types.h>
 #include <openr/spark/Spark.h>
 
+#include <linux/filter.h>
 #include <thrift/lib/cpp/protocol/TProtocolException.h>
 
 namespace fb303 = facebook::fb303;
@@ -39,6 +41,12 @@ const int kSparkHopLimit = 255;
 // number of restarting packets to send out per interface before I'm going down
 const int kNumRestartingPktSent = 3;
 
+//
+// Field type of a struct inside compact protocol field header. All messages
+// carried by SparkHelloPacket are structs.
+//
+const uint8_t kCompactTypeStruct = 0x0C;
+
 //
 // Subscribe/unsubscribe to a multicast group on given interface
 //
@@ -286,7 +294,7 @@ Spark::SparkNeighbor::shouldResetAdjacency(
 }
 
 Spark::Spark(
-    messaging::RQueue<InterfaceDatabase> interfaceUpdatesQueue,
+    messaging::RQueue<InterfaceDatabaseDelta> interfaceUpdatesQueue,
     messaging::RQueue<thrift::InitializationEvent> initializationEventQueue,
     messaging::RQueue<AddressEvent> addrEventQueue,
     messaging::ReplicateQueue<NeighborInitEvent>& neighborUpdatesQueue,
@@ -348,6 +356,10 @@ Spark::Spark(
               numBuckets, sec));
     }
   }
+  if (auto maybePps =
+          config_->getSparkConfig().max_allowed_pps_per_interface()) {
+    maybeMaxAllowedPpsPerInterface_ = static_cast<uint32_t>(*maybePps);
+  }
   // Timer scheduled with lower bound timeout, after which  NEIGHBOR_DISCOVERED
   // initialization signal may be published to LM over neighborUpdatesQueue_.
   minNeighborDiscoveryIntervalTimer_ =
@@ -572,6 +584,11 @@ Spark::prepareSocket() noexcept {
                 << folly::errnoStr(errno);
   }
 
+  // drop packets from unexpected sources in kernel if enabled
+  if (*config_->getSparkConfig().enable_socket_filter()) {
+    attachSocketFilter();
+  }
+
   // disable looping packets to ourselves
   const int loop = 0;
   if (ioProvider_->setsockopt(
@@ -609,6 +626,40 @@ Spark::prepareSocket() noexcept {
   counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
 }
 
+void
+Spark::attachSocketFilter() noexcept {
+  // Spark hello packets are always sent to link-local multicast from the
+  // link-local address of the sender with max hop-limit. Offsets are relative
+  // to the IPv6 header (SKF_NET_OFF) as socket filter sees the UDP payload.
+  struct sock_filter code[] = {
+      // A <- hop-limit
+      BPF_STMT(BPF_LD | BPF_B | BPF_ABS, SKF_NET_OFF + 7),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, kSparkHopLimit, 0, 3),
+      // A <- first 16 bits of source address, check against fe80::/10
+      BPF_STMT(BPF_LD | BPF_H | BPF_ABS, SKF_NET_OFF + 8),
+      BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0xffc0),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0xfe80, 1, 0),
+      // drop
+      BPF_STMT(BPF_RET | BPF_K, 0),
+      // accept the whole packet
+      BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+  };
+  struct sock_fprog prog;
+  prog.len = sizeof(code) / sizeof(code[0]);
+  prog.filter = code;
+
+  if (ioProvider_->setsockopt(
+          mcastFd_, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) != 0) {
+    // Not fatal. User space checks still apply.
+    XLOG(ERR) << "Failed attaching socket filter to Spark socket. Error: "
+              << folly::errnoStr(errno);
+    fb303::fbData->setCounter("spark.socket_filter_attached", 0);
+    return;
+  }
+  XLOG(INFO) << "Attached socket filter to Spark socket";
+  fb303::fbData->setCounter("spark.socket_filter_attached", 1);
+}
+
 PacketValidationResult
 Spark::sanityCheckMsg(
     std::string const& neighborName, std::string const& ifName) {
@@ -642,6 +693,27 @@ Spark::sanityCheckMsg(
 bool
 Spark::shouldProcessPacket(
     std::string const& ifName, folly::IPAddress const& addr) {
+  // check aggregated rate on this interface first. This bounds the work done
+  // for an interface even if the sender keeps changing its source address.
+  if (maybeMaxAllowedPpsPerInterface_.has_value()) {
+    auto it = ifNameToTokenBuckets_.find(ifName);
+    if (it == ifNameToTokenBuckets_.end()) {
+      // allow a burst worth of one second of packets
+      it = ifNameToTokenBuckets_
+               .emplace(
+                   ifName,
+                   folly::TokenBucket(
+                       *maybeMaxAllowedPpsPerInterface_,
+                       *maybeMaxAllowedPpsPerInterface_))
+               .first;
+    }
+    if (not it->second.consume(1)) {
+      fb303::fbData->addStatValue(
+          "spark.packet_dropped.interface_rate_limit", 1, fb303::SUM);
+      return false;
+    }
+  }
+
   if (not maybeMaxAllowedPps_.has_value()) {
     return true; // no rate limit
   }
@@ -654,6 +726,8 @@ Spark::shouldProcessPacket(
 
   if (timeSeriesVector_[index].count() > *maybeMaxAllowedPps_) {
     // drop the packet
+    fb303::fbData->addStatValue(
+        "spark.packet_dropped.neighbor_rate_limit", 1, fb303::SUM);
     return false;
   }
   // otherwise, count this packet and process it
@@ -662,6 +736,17 @@ Spark::shouldProcessPacket(
   return true;
 }
 
+bool
+Spark::isValidPacketHeader(const uint8_t* buf, ssize_t len) {
+  if (len <= 0) {
+    return false;
+  }
+  // compact protocol field header: field id delta in the high nibble and the
+  // field type in the low nibble. An empty packet (STOP) carries no message.
+  const uint8_t header = buf[0];
+  return (header >> 4) != 0 and (header & 0x0F) == kCompactTypeStruct;
+}
+
 bool
 Spark::parsePacket(
     thrift::SparkHelloPacket& pkt,
@@ -684,6 +769,8 @@ Spark::parsePacket(
         clientAddr.getAddressStr(),
         hopLimit,
         kSparkHopLimit);
+    fb303::fbData->addStatValue(
+        "spark.packet_dropped.hop_limit", 1, fb303::SUM);
     return false;
   }
 
@@ -693,6 +780,8 @@ Spark::parsePacket(
         "Received packet from {} with unknown ifIndex: {}. Skip processing.",
         clientAddr.getAddressStr(),
         ifIndex);
+    fb303::fbData->addStatValue(
+        "spark.packet_dropped.unknown_ifindex", 1, fb303::SUM);
     return false;
   }
 
@@ -706,7 +795,7 @@ Spark::parsePacket(
   fb303::fbData->addStatValue("spark.packet_recv_size", bytesRead, fb303::SUM);
 
   if (not shouldProcessPacket(ifName, clientAddr.getIPAddress())) {
-    XLOG(ERR) << fmt::format(
+    XLOG(DBG2) << fmt::format(
         "Dropping pkt due to rate limiting on iface: {} from addr: {}",
         ifName,
         clientAddr.getAddressStr());
@@ -715,8 +804,6 @@ Spark::parsePacket(
     return false;
   }
 
-  fb303::fbData->addStatValue("spark.packet_processed", 1, fb303::SUM);
-
   if (bytesRead >= 0) {
     XLOG(DBG3) << fmt::format(
         "Read a total of {} bytes from fd {}", bytesRead, mcastFd_);
@@ -724,6 +811,8 @@ Spark::parsePacket(
     if (static_cast<size_t>(bytesRead) > kMinIpv6Mtu) {
       XLOG(ERR) << fmt::format(
           "Message from {} has been truncated.", clientAddr.getAddressStr());
+      fb303::fbData->addStatValue(
+          "spark.packet_dropped.truncated", 1, fb303::SUM);
       return false;
     }
   } else {
@@ -734,6 +823,19 @@ Spark::parsePacket(
     return false;
   }
 
+  // cheap check before deserialization
+  if (not isValidPacketHeader(buf, bytesRead)) {
+    XLOG(DBG2) << fmt::format(
+        "Dropping pkt with invalid header on iface: {} from addr: {}",
+        ifName,
+        clientAddr.getAddressStr());
+    fb303::fbData->addStatValue(
+        "spark.packet_dropped.invalid_header", 1, fb303::SUM);
+    return false;
+  }
+
+  fb303::fbData->addStatValue("spark.packet_processed", 1, fb303::SUM);
+
   // Copy buffer into string object and parse it into helloPacket.
   try {
     // assign value to pkt and pass it back via argument list
@@ -741,9 +843,13 @@ Spark::parsePacket(
     pkt = readThriftObjStr<thrift::SparkHelloPacket>(readBuf, serializer_);
   } catch (std::out_of_range const& err) {
     XLOG(ERR) << "Malformed Thrift packet: " << folly::exceptionStr(err);
+    fb303::fbData->addStatValue(
+        "spark.packet_dropped.malformed", 1, fb303::SUM);
     return false;
   } catch (apache::thrift::protocol::TProtocolException const& err) {
     XLOG(ERR) << "Malformed Thrift packet: " << folly::exceptionStr(err);
+    fb303::fbData->addStatValue(
+        "spark.packet_dropped.malformed", 1, fb303::SUM);
     return false;
   } catch (std::exception const& err) {
     XLOG(ERR) << "Failed to parse packet: " << folly::exceptionStr(err);
@@ -1317,7 +1423,7 @@ Spark::neighborDownWrapper(
 void
 Spark::notifySparkNeighborEvent(
     NeighborEventType eventType, SparkNeighbor const& neighbor) {
-  neighborUpdatesQueue_.push(NeighborEvents({NeighborEvent(
+  NeighborEvent event(
       eventType,
       neighbor.nodeName,
       neighbor.transportAddressV4,
@@ -1327,7 +1433,12 @@ Spark::notifySparkNeighborEvent(
       neighbor.area,
       neighbor.openrCtrlThriftPort,
       neighbor.rtt.count(),
-      neighbor.adjOnlyUsedByOtherNode)}));
+      neighbor.adjOnlyUsedByOtherNode);
+
+  // Neighbor state change is the origin of convergence event trace
+  event.traceId = TraceRecorder::generateTraceId();
+  ScopedTraceSpan span(event.traceId, "spark.neighbor_event");
+  neighborUpdatesQueue_.push(NeighborEvents({std::move(event)}));
 }
 
 void
@@ -2086,19 +2197,20 @@ Spark::processInitializationEvent(thrift::InitializationEvent&& event) {
 
 void
 Spark::processAddressEvent(AddressEvent&& event) {
-  // Process Address Event reported by neighborMonitor(FSDB)
+  // Process Address Event reported by NeighborMonitor
   // [ATTN] We assume the only event received is neighbor_unresolvable
 
-  const auto& v6 = event.v6Addr;
+  const auto& addr = event.addr;
   const auto& ifName = event.ifName;
   auto it = sparkNeighbors_.find(ifName);
 
   // Find the unresolvable sparkNeighbor by comparing interface name
-  // and V6 address
+  // and V6/V4 transport address
   if (it != sparkNeighbors_.end()) {
     auto& ifNeighbors = it->second;
     for (const auto& [name, neighbor] : ifNeighbors) {
-      if (neighbor.transportAddressV6 == v6) {
+      if (neighbor.transportAddressV6 == addr or
+          neighbor.transportAddressV4 == addr) {
         XLOG(INFO) << fmt::format(
             "Bringing down neighbor {} on {} due to unreachability",
             name,
@@ -2112,7 +2224,8 @@ Spark::processAddressEvent(AddressEvent&& event) {
 }
 
 void
-Spark::processInterfaceUpdates(InterfaceDatabase&& ifDb) {
+Spark::processInterfaceUpdates(InterfaceDatabaseDelta&& ifDbDelta) {
+  // Interfaces carried in this update which qualify for Spark tracking
   decltype(interfaceDb_) newInterfaceDb{};
 
   //
@@ -2121,7 +2234,7 @@ Spark::processInterfaceUpdates(InterfaceDatabase&& ifDb) {
   // - have a v6LinkLocal IP
   // - have an IPv4 addr when v4 is enabled
   //
-  for (const auto& info : ifDb) {
+  for (const auto& info : ifDbDelta.updatedInterfaces) {
     // ATTN: multiple networks can be associated with one ifName.
     //  - Retrieve networks in sorted order;
     //  - Use the lowest one (other node will do similar)
@@ -2153,29 +2266,40 @@ Spark::processInterfaceUpdates(InterfaceDatabase&& ifDb) {
   std::vector<std::string> toDel{};
   std::vector<std::string> toUpdate{};
 
-  // iterate old and new interfaceDb to catch difference
-  for (const auto& [oldIfName, oldInterface] : interfaceDb_) {
-    auto it = newInterfaceDb.find(oldIfName);
-    if (it != newInterfaceDb.end()) {
-      if (it->second != oldInterface) {
-        // interface info has changed!
-        toUpdate.emplace_back(oldIfName);
+  if (ifDbDelta.isFullSync) {
+    // full snapshot: every tracked interface absent from it is removed
+    for (const auto& [oldIfName, _] : interfaceDb_) {
+      if (not newInterfaceDb.count(oldIfName)) {
+        toDel.emplace_back(oldIfName);
+      }
+    }
+  } else {
+    // delta: remove tracked interfaces which no longer qualify. Untouched
+    // interfaces are left as is.
+    for (const auto& info : ifDbDelta.updatedInterfaces) {
+      if (interfaceDb_.count(info.ifName) and
+          not newInterfaceDb.count(info.ifName)) {
+        toDel.emplace_back(info.ifName);
       }
-    } else {
-      // interface being removed!
-      toDel.emplace_back(oldIfName);
     }
   }
 
-  for (const auto& [newIfName, _] : newInterfaceDb) {
+  for (const auto& [newIfName, newInterface] : newInterfaceDb) {
     auto it = interfaceDb_.find(newIfName);
     if (it == interfaceDb_.end()) {
       // interface being added!
       toAdd.emplace_back(newIfName);
+    } else if (it->second != newInterface) {
+      // interface info has changed!
+      toUpdate.emplace_back(newIfName);
     }
-    // ATTN: intersection part has been processed already
   }
 
+  fb303::fbData->addStatValue(
+      "spark.interface_updates.processed",
+      ifDbDelta.updatedInterfaces.size(),
+      fb303::SUM);
+
   // remove the interfaces no longer in newdb
   deleteInterface(toDel);
 
@@ -2227,6 +2351,7 @@ Spark::deleteInterface(const std::vector<std::string>& toDel) {
     }
     // cleanup for this interface
     ifNameToHelloTimers_.erase(ifName);
+    ifNameToTokenBuckets_.erase(ifName);
     interfaceDb_.erase(ifName);
   }
 }
@@ -9,6 +9,7 @@
 
 #include <fmt/format.h>
 #include <folly/SocketAddress.h>
+#include <folly/TokenBucket.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <folly/stats/BucketedTimeSeries.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
@@ -49,7 +50,7 @@ class Spark final : public OpenrEventBase {
  public:
   Spark(
       // consumer Queue
-      messaging::RQueue<InterfaceDatabase> interfaceUpdatesQueue,
+      messaging::RQueue<InterfaceDatabaseDelta> interfaceUpdatesQueue,
       messaging::RQueue<thrift::InitializationEvent> initializationEventQueue,
       messaging::RQueue<AddressEvent> addrEventQueue,
       // producer Queue
@@ -117,6 +118,11 @@ class Spark final : public OpenrEventBase {
   // Initializes UDP socket for multicast neighbor discovery
   void prepareSocket() noexcept;
 
+  // Attach a classic BPF program to the multicast socket so that packets not
+  // sourced from an IPv6 link-local address, or carrying a hop-limit below
+  // kSparkHopLimit, are dropped by the kernel before reaching user space.
+  void attachSocketFilter() noexcept;
+
   // check neighbor's hello packet; return true if packet is valid and
   // passed the following checks:
   // (1) neighbor is not self (packet not looped back)
@@ -124,10 +130,17 @@ class Spark final : public OpenrEventBase {
   PacketValidationResult sanityCheckMsg(
       std::string const& neighborName, std::string const& ifName);
 
-  // Determine if we should process the next packte from this ifName, addr pair
+  // Determine if we should process the next packte from this ifName, addr pair.
+  // The per-interface token bucket is consulted first, followed by the
+  // per-(interface, address) time series.
   bool shouldProcessPacket(
       std::string const& ifName, folly::IPAddress const& addr);
 
+  // Cheap check on the first byte of the received buffer to make sure it can
+  // be a compact-serialized SparkHelloPacket. Used to drop garbage before
+  // paying for thrift deserialization.
+  static bool isValidPacketHeader(const uint8_t* buf, ssize_t len);
+
   // process hello packet from a neighbor. we want to see if
   // the neighbor could be added as adjacent peer.
   void processPacket();
@@ -166,11 +179,11 @@ class Spark final : public OpenrEventBase {
    * [Interface Update/Initialization Event Management]
    *
    * Spark will be the reader of following event:
-   *  1) Interface database update from LinkMonitor to appropriately
-   *     enable/disable neighbor discovery;
+   *  1) Interface database update (full snapshot or delta) from LinkMonitor
+   *     to appropriately enable/disable neighbor discovery;
    *  2) Open/R Initialization Event from LinkMonitor;
    */
-  void processInterfaceUpdates(InterfaceDatabase&& interfaceUpdates);
+  void processInterfaceUpdates(InterfaceDatabaseDelta&& interfaceUpdates);
   void processInitializationEvent(thrift::InitializationEvent&& event);
 
   // util function to delete interface in spark
@@ -547,6 +560,11 @@ class Spark final : public OpenrEventBase {
   std::vector<folly::BucketedTimeSeries<int64_t, std::chrono::steady_clock>>
       timeSeriesVector_{};
 
+  // Token bucket per tracked interface to bound the aggregated rate of
+  // packets we process from one interface, regardless of source address
+  std::unordered_map<std::string /* ifName */, folly::TokenBucket>
+      ifNameToTokenBuckets_{};
+
   // flag to indicate if ordered publication is enabled
   bool enableOrderedAdjPublication_{false};
 
@@ -578,6 +596,9 @@ class Spark final : public OpenrEventBase {
   // Optional rate-limit on processing inbound Spark messages
   std::optional<uint32_t> maybeMaxAllowedPps_;
 
+  // Optional rate-limit on processing inbound Spark messages per interface
+  std::optional<uint32_t> maybeMaxAllowedPpsPerInterface_;
+
   // Whether to throw parsing errors upwards, or suppress.
   // Fuzzer needs to see exceptions.
   bool isThrowParserErrorsOn_ = false;
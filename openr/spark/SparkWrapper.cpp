@@ -76,7 +76,12 @@ SparkWrapper::stop() {
 
 void
 SparkWrapper::updateInterfaceDb(const InterfaceDatabase& ifDb) {
-  interfaceUpdatesQueue_.push(ifDb);
+  interfaceUpdatesQueue_.push(InterfaceDatabaseDelta(ifDb));
+}
+
+void
+SparkWrapper::updateInterfaceDbDelta(const InterfaceDatabaseDelta& ifDbDelta) {
+  interfaceUpdatesQueue_.push(ifDbDelta);
 }
 
 void
@@ -86,8 +91,8 @@ SparkWrapper::sendPrefixDbSyncedSignal() {
 
 void
 SparkWrapper::sendNeighborDownEvent(
-    const std::string& ifName, const thrift::BinaryAddress& v6Addr) {
-  addrEventQueue_.push(AddressEvent{false, v6Addr, ifName});
+    const std::string& ifName, const thrift::BinaryAddress& addr) {
+  addrEventQueue_.push(AddressEvent{false, addr, ifName});
 }
 
 std::optional<NeighborEvents>
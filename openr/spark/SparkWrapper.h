@@ -49,12 +49,15 @@ class SparkWrapper {
   // add interfaceDb for Spark to tracking
   void updateInterfaceDb(const InterfaceDatabase& ifDb);
 
+  // add/update/remove only the interfaces carried in delta
+  void updateInterfaceDbDelta(const InterfaceDatabaseDelta& ifDbDelta);
+
   // send ADJ_DB_SYNC signal to Spark
   void sendPrefixDbSyncedSignal();
 
   // send neighbor down event to Spark
   void sendNeighborDownEvent(
-      const std::string& ifName, const thrift::BinaryAddress& v6Addr);
+      const std::string& ifName, const thrift::BinaryAddress& addr);
 
   // receive spark neighbor event
   std::optional<NeighborEvents> recvNeighborEvent(
@@ -111,7 +114,7 @@ class SparkWrapper {
       neighborUpdatesQueue_.getReader()};
 
   // Queue to receive interface update from LinkMonitor
-  messaging::ReplicateQueue<InterfaceDatabase> interfaceUpdatesQueue_;
+  messaging::ReplicateQueue<InterfaceDatabaseDelta> interfaceUpdatesQueue_;
 
   // Queue to receive interface update from PrefixManager
   messaging::ReplicateQueue<thrift::InitializationEvent>
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <pthread.h>
+#include <algorithm>
+#include <time.h>
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/logging/Init.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/common/Constants.h>
+#include <openr/config/Config.h>
+#include <openr/spark/SparkWrapper.h>
+#include <openr/tests/mocks/MockIoProvider.h>
+#include <openr/tests/utils/Utils.h>
+
+#define BENCHMARK_COUNTERS_NAME_PARAM(name, counters, param_name, ...) \
+  BENCHMARK_IMPL_COUNTERS(                                             \
+      FB_CONCATENATE(name, FB_CONCATENATE(_, param_name)),             \
+      FOLLY_PP_STRINGIZE(name) "(" FOLLY_PP_STRINGIZE(param_name) ")", \
+      counters,                                                        \
+      iters,                                                           \
+      unsigned,                                                        \
+      iters) {                                                         \
+    name(counters, iters, ##__VA_ARGS__);                              \
+  }
+
+FOLLY_INIT_LOGGING_CONFIG(
+    ".=WARNING"
+    ";default:async=true,sync_level=WARNING");
+
+namespace openr {
+namespace {
+// latency of every emulated link
+const int32_t kLinkLatencyMs{1};
+
+// max time to wait for the whole topology to form adjacencies
+const std::chrono::seconds kConvergenceTimeout{300};
+
+// polling interval while waiting for neighbor state
+const std::chrono::milliseconds kPollInterval{10};
+
+// window used to measure steady state CPU usage, in keepalive intervals
+const int32_t kSteadyStateKeepAlives{5};
+
+const std::string kTimeToAllAdjMs = "time_to_all_adj(ms)";
+const std::string kCpuUsPerAdjPerSec = "cpu_per_adj_per_sec(us)";
+const std::string kDetectionLatencyMs = "detection_latency(ms)";
+
+std::chrono::nanoseconds
+getCpuTime(clockid_t clockId) {
+  struct timespec ts;
+  ::clock_gettime(clockId, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+} // namespace
+
+/**
+ * Harness to bring up N Spark instances with M interfaces each, glued together
+ * over a single MockIoProvider.
+ *
+ * Topology is a circulant graph: interface `2k` of node `i` is connected to
+ * interface `2k + 1` of node `(i + k + 1) % N`. Hence every interface has
+ * exactly one neighbor and every node forms M adjacencies.
+ */
+class SparkHarness {
+ public:
+  SparkHarness() {
+    mockIoProvider_ = std::make_shared<MockIoProvider>();
+    mockIoProviderThread_ = std::make_unique<std::thread>(
+        [this]() { mockIoProvider_->start(); });
+    mockIoProvider_->waitUntilRunning();
+  }
+
+  ~SparkHarness() {
+    clear();
+    mockIoProvider_->stop();
+    mockIoProviderThread_->join();
+  }
+
+  // explicit cleanup
+  void
+  clear() {
+    nodes_.clear();
+  }
+
+  void
+  createTopology(
+      size_t numNodes,
+      size_t numIfaces,
+      int32_t keepAliveTimeS = 1,
+      int32_t holdTimeS = 2) {
+    CHECK_EQ(0, numIfaces % 2) << "Number of interfaces must be even";
+    CHECK_GT(numNodes, numIfaces / 2) << "Not enough nodes for interfaces";
+    numNodes_ = numNodes;
+    numIfaces_ = numIfaces;
+
+    IfNameAndifIndex ifNameAndIndex;
+    for (size_t node = 0; node < numNodes; ++node) {
+      for (size_t iface = 0; iface < numIfaces; ++iface) {
+        ifNameAndIndex.emplace_back(
+            getIfName(node, iface), getIfIndex(node, iface));
+      }
+    }
+    mockIoProvider_->addIfNameIfIndex(ifNameAndIndex);
+
+    links_.clear();
+    for (size_t node = 0; node < numNodes; ++node) {
+      for (size_t k = 0; k < numIfaces / 2; ++k) {
+        links_.emplace_back(
+            getIfName(node, 2 * k),
+            getIfName((node + k + 1) % numNodes, 2 * k + 1));
+      }
+    }
+    connectLinks();
+
+    for (size_t node = 0; node < numNodes; ++node) {
+      auto nodeName = getNodeName(node);
+      auto tConfig = getBasicOpenrConfig(nodeName, {}, false /* enableV4 */);
+      tConfig.spark_config()->keepalive_time_s() = keepAliveTimeS;
+      tConfig.spark_config()->hold_time_s() = holdTimeS;
+      tConfig.spark_config()->graceful_restart_time_s() =
+          std::max(6, 3 * keepAliveTimeS);
+      nodes_.emplace_back(std::make_unique<SparkWrapper>(
+          nodeName,
+          std::make_pair(
+              Constants::kOpenrVersion, Constants::kOpenrSupportedVersion),
+          mockIoProvider_,
+          std::make_shared<Config>(tConfig)));
+    }
+  }
+
+  // feed interfaces into every Spark to kick off neighbor discovery
+  void
+  startDiscovery() {
+    for (size_t node = 0; node < numNodes_; ++node) {
+      InterfaceDatabase ifDb;
+      for (size_t iface = 0; iface < numIfaces_; ++iface) {
+        auto ifIndex = getIfIndex(node, iface);
+        ifDb.emplace_back(InterfaceInfo(
+            getIfName(node, iface),
+            true /* isUp */,
+            ifIndex,
+            {folly::IPAddress::createNetwork(
+                fmt::format("fe80::{:x}/128", ifIndex))}));
+      }
+      nodes_.at(node)->updateInterfaceDb(ifDb);
+    }
+  }
+
+  // wait until every node has all of its adjacencies established
+  bool
+  waitForAllAdjacencies() {
+    const auto startTime = std::chrono::steady_clock::now();
+    size_t node = 0;
+    while (node < numNodes_) {
+      if (nodes_.at(node)->getActiveNeighborCount() == numIfaces_) {
+        ++node;
+        continue;
+      }
+      if (std::chrono::steady_clock::now() - startTime > kConvergenceTimeout) {
+        XLOG(ERR) << fmt::format(
+            "Timed out waiting for adjacencies on {}", getNodeName(node));
+        return false;
+      }
+      std::this_thread::sleep_for(kPollInterval);
+    }
+    return true;
+  }
+
+  // remove the link attached to interface 0 of the given node, and wait
+  // until both ends detect the failure
+  bool
+  failLinkAndWait(size_t node) {
+    const auto ifName = getIfName(node, 0);
+    const size_t peer = (node + 1) % numNodes_;
+    auto it = std::find_if(links_.begin(), links_.end(), [&](const auto& l) {
+      return l.first == ifName;
+    });
+    CHECK(it != links_.end());
+    links_.erase(it);
+    connectLinks();
+
+    const auto startTime = std::chrono::steady_clock::now();
+    while (nodes_.at(node)->getActiveNeighborCount() == numIfaces_ or
+           nodes_.at(peer)->getActiveNeighborCount() == numIfaces_) {
+      if (std::chrono::steady_clock::now() - startTime > kConvergenceTimeout) {
+        return false;
+      }
+      std::this_thread::sleep_for(kPollInterval);
+    }
+    return true;
+  }
+
+  // CPU consumed by the process, excluding MockIoProvider thread which busy
+  // polls the mailboxes
+  std::chrono::nanoseconds
+  getSparkCpuTime() {
+    clockid_t mockClockId;
+    CHECK_EQ(
+        0,
+        ::pthread_getcpuclockid(
+            mockIoProviderThread_->native_handle(), &mockClockId));
+    return getCpuTime(CLOCK_PROCESS_CPUTIME_ID) - getCpuTime(mockClockId);
+  }
+
+  size_t
+  getNumAdjacencies() const {
+    return numNodes_ * numIfaces_;
+  }
+
+ private:
+  static std::string
+  getNodeName(size_t node) {
+    return fmt::format("node-{}", node);
+  }
+
+  static std::string
+  getIfName(size_t node, size_t iface) {
+    return fmt::format("n{}-if{}", node, iface);
+  }
+
+  int
+  getIfIndex(size_t node, size_t iface) const {
+    return static_cast<int>(node * numIfaces_ + iface + 1);
+  }
+
+  void
+  connectLinks() {
+    ConnectedIfPairs connectedPairs;
+    for (const auto& [if1, if2] : links_) {
+      connectedPairs[if1].emplace_back(if2, kLinkLatencyMs);
+      connectedPairs[if2].emplace_back(if1, kLinkLatencyMs);
+    }
+    mockIoProvider_->setConnectedPairs(connectedPairs);
+  }
+
+  std::shared_ptr<MockIoProvider> mockIoProvider_{nullptr};
+  std::unique_ptr<std::thread> mockIoProviderThread_{nullptr};
+  std::vector<std::unique_ptr<SparkWrapper>> nodes_;
+  std::vector<std::pair<std::string, std::string>> links_;
+  size_t numNodes_{0};
+  size_t numIfaces_{0};
+};
+
+/**
+ * Benchmark for initial neighbor discovery:
+ * 1. Create N Spark instances with M interfaces each
+ * 2. Feed interfaces and measure the time until all adjacencies are
+ *    ESTABLISHED on every node
+ */
+static void
+BM_SparkAdjacencyEstablishment(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    size_t numNodes,
+    size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto harness = std::make_unique<SparkHarness>();
+    harness->createTopology(numNodes, numIfaces);
+
+    suspender.dismiss(); // Start measuring benchmark time
+    const auto startTime = std::chrono::steady_clock::now();
+    harness->startDiscovery();
+    CHECK(harness->waitForAllAdjacencies());
+    const auto endTime = std::chrono::steady_clock::now();
+    suspender.rehire(); // Stop measuring benchmark time
+
+    if (i == 0) {
+      counters[kTimeToAllAdjMs] =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              endTime - startTime)
+              .count();
+    }
+  }
+}
+
+/**
+ * Benchmark for steady state Spark CPU usage:
+ * 1. Bring up the topology and wait for all adjacencies
+ * 2. Measure CPU time spent over a few keepalive intervals, normalized per
+ *    adjacency per second
+ */
+static void
+BM_SparkSteadyStateCpu(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    size_t numNodes,
+    size_t numIfaces) {
+  auto suspender = folly::BenchmarkSuspender();
+  const int32_t keepAliveTimeS{1};
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto harness = std::make_unique<SparkHarness>();
+    harness->createTopology(numNodes, numIfaces, keepAliveTimeS);
+    harness->startDiscovery();
+    CHECK(harness->waitForAllAdjacencies());
+
+    const std::chrono::seconds window{kSteadyStateKeepAlives * keepAliveTimeS};
+    suspender.dismiss(); // Start measuring benchmark time
+    const auto cpuStart = harness->getSparkCpuTime();
+    std::this_thread::sleep_for(window);
+    const auto cpuEnd = harness->getSparkCpuTime();
+    suspender.rehire(); // Stop measuring benchmark time
+
+    if (i == 0) {
+      const auto cpuUs =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              cpuEnd - cpuStart)
+              .count();
+      counters[kCpuUsPerAdjPerSec] =
+          cpuUs / (harness->getNumAdjacencies() * window.count());
+    }
+  }
+}
+
+/**
+ * Benchmark for link failure detection:
+ * 1. Bring up the topology with given keepalive/hold time
+ * 2. Silently drop the link on one node (no interface down event) and measure
+ *    the time until both ends declare the adjacency down
+ */
+static void
+BM_SparkLinkFailureDetection(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    size_t numNodes,
+    int32_t keepAliveTimeS,
+    int32_t holdTimeS) {
+  auto suspender = folly::BenchmarkSuspender();
+
+  for (uint32_t i = 0; i < iters; i++) {
+    auto harness = std::make_unique<SparkHarness>();
+    harness->createTopology(numNodes, 2, keepAliveTimeS, holdTimeS);
+    harness->startDiscovery();
+    CHECK(harness->waitForAllAdjacencies());
+
+    suspender.dismiss(); // Start measuring benchmark time
+    const auto startTime = std::chrono::steady_clock::now();
+    CHECK(harness->failLinkAndWait(0));
+    const auto endTime = std::chrono::steady_clock::now();
+    suspender.rehire(); // Stop measuring benchmark time
+
+    if (i == 0) {
+      counters[kDetectionLatencyMs] =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              endTime - startTime)
+              .count();
+    }
+  }
+}
+
+// The first integer parameter is number of nodes
+// The second integer parameter is number of interfaces per node
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkAdjacencyEstablishment, counters, 10_2, 10, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkAdjacencyEstablishment, counters, 100_2, 100, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkAdjacencyEstablishment, counters, 100_8, 100, 8);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkAdjacencyEstablishment, counters, 1000_2, 1000, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkAdjacencyEstablishment, counters, 1000_4, 1000, 4);
+
+BENCHMARK_DRAW_LINE();
+
+// The first integer parameter is number of nodes
+// The second integer parameter is number of interfaces per node
+BENCHMARK_COUNTERS_NAME_PARAM(BM_SparkSteadyStateCpu, counters, 10_2, 10, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(BM_SparkSteadyStateCpu, counters, 100_2, 100, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(BM_SparkSteadyStateCpu, counters, 100_8, 100, 8);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkSteadyStateCpu, counters, 1000_2, 1000, 2);
+
+BENCHMARK_DRAW_LINE();
+
+// The first integer parameter is number of nodes
+// The second integer parameter is keepalive time in seconds
+// The third integer parameter is hold time in seconds
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkLinkFailureDetection, counters, 10_1_2, 10, 1, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkLinkFailureDetection, counters, 10_1_4, 10, 1, 4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkLinkFailureDetection, counters, 10_2_6, 10, 2, 6);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SparkLinkFailureDetection, counters, 100_1_2, 100, 1, 2);
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -16,6 +16,7 @@
 #include <openr/config/Config.h>
 #include <openr/spark/SparkWrapper.h>
 #include <openr/tests/mocks/MockIoProvider.h>
+#include <openr/tests/mocks/MockIoProviderUtils.h>
 #include <openr/tests/utils/Utils.h>
 
 using namespace openr;
@@ -362,6 +363,192 @@ TEST_F(SparkConfigFixture, MinHeartbeatHoldTimerTest) {
   }
 }
 
+/*
+ * This is the test fixture used for inbound packet protection testing.
+ * Per-interface rate-limit and kernel socket filter are enabled on node1.
+ */
+class SparkPacketProtectionFixture : public SimpleSparkFixture {
+ protected:
+  void
+  createConfig() override {
+    auto tConfig1 = getBasicOpenrConfig(nodeName1_);
+    auto tConfig2 = getBasicOpenrConfig(nodeName2_);
+    auto sparkConfig1 = *tConfig1.spark_config();
+    sparkConfig1.max_allowed_pps_per_interface() = 1000;
+    sparkConfig1.enable_socket_filter() = true;
+    tConfig1.spark_config() = sparkConfig1;
+
+    config1_ = std::make_shared<Config>(tConfig1);
+    config2_ = std::make_shared<Config>(tConfig2);
+  }
+
+  /*
+   * On top of iface1 <-> iface2 adjacency, node1 also tracks iface3, which
+   * is connected to an injector interface. Packets sent from the injector
+   * socket only reach node1 via iface3.
+   */
+  void
+  createAndConnect() override {
+    mockIoProvider_->addIfNameIfIndex(
+        {{iface1, ifIndex1},
+         {iface2, ifIndex2},
+         {iface3, ifIndex3},
+         {kInjectIface, kInjectIfIndex}});
+
+    ConnectedIfPairs connectedPairs = {
+        {iface1, {{iface2, 10}}},
+        {iface2, {{iface1, 10}}},
+        {iface3, {{kInjectIface, 10}}},
+        {kInjectIface, {{iface3, 10}}},
+    };
+    mockIoProvider_->setConnectedPairs(connectedPairs);
+
+    createConfig();
+    node1_ = createSpark(nodeName1_, config1_);
+    node2_ = createSpark(nodeName2_, config2_);
+
+    node1_->updateInterfaceDb(
+        {InterfaceInfo(
+             iface1 /* ifName */,
+             true /* isUp */,
+             ifIndex1 /* ifIndex */,
+             {ip1V4, ip1V6} /* networks */),
+         InterfaceInfo(
+             iface3 /* ifName */,
+             true /* isUp */,
+             ifIndex3 /* ifIndex */,
+             {ip1V4, ip1V6} /* networks */)});
+    node2_->updateInterfaceDb({InterfaceInfo(
+        iface2 /* ifName */,
+        true /* isUp */,
+        ifIndex2 /* ifIndex */,
+        {ip2V4, ip2V6} /* networks */)});
+
+    validate();
+
+    injectFd_ = MockIoProviderUtils::createSocketAndJoinGroup(
+        mockIoProvider_,
+        kInjectIfIndex,
+        folly::IPAddress(Constants::kSparkMcastAddr.str()));
+  }
+
+  // send `count` copies of `packet` towards node1's iface3
+  void
+  injectPackets(std::string const& packet, size_t count) {
+    const folly::IPAddress srcAddr("fe80::99");
+    const folly::IPAddress dstAddr(Constants::kSparkMcastAddr.str());
+    for (size_t i = 0; i < count; ++i) {
+      struct msghdr msg {};
+      MockIoProviderUtils::AlignedCtrlBuf<struct in6_pktinfo> u;
+      sockaddr_storage dstAddrStorage;
+      struct iovec entry;
+      MockIoProviderUtils::prepareSendMessage(
+          (MockIoProviderUtils::bufferArgs<struct in6_pktinfo>){
+              .msg = msg,
+              .data = const_cast<char*>(packet.data()),
+              .len = packet.size(),
+              .entry = entry,
+              .u = u,
+          },
+          (struct MockIoProviderUtils::networkArgs){
+              .srcIfIndex = kInjectIfIndex,
+              .srcIPAddr = srcAddr,
+              .dstIPAddr = dstAddr,
+              .dstPort = *config1_->getSparkConfig().neighbor_discovery_port(),
+              .dstAddrStorage = dstAddrStorage,
+          });
+      EXPECT_EQ(packet.size(), mockIoProvider_->sendmsg(injectFd_, &msg, 0));
+    }
+  }
+
+  static int64_t
+  getCounter(std::string const& key) {
+    auto counters = fb303::fbData->getCounters();
+    auto it = counters.find(key);
+    return it == counters.end() ? 0 : it->second;
+  }
+
+  // adjacency over iface1 must survive whatever is injected over iface3
+  void
+  verifyAdjacencyUp() {
+    const auto holdTime = std::chrono::seconds(
+        *config1_->getSparkConfig().hold_time_s());
+    EXPECT_FALSE(
+        node1_->waitForEvents(NB_DOWN, holdTime, holdTime).has_value());
+    EXPECT_TRUE(node1_->getActiveNeighborCount() == 1);
+    EXPECT_TRUE(node2_->getActiveNeighborCount() == 1);
+  }
+
+  const std::string kInjectIface{"iface-inject"};
+  const int kInjectIfIndex{4};
+  int injectFd_{-1};
+};
+
+TEST_F(SparkPacketProtectionFixture, AdjUpTest) {
+  // adjacency must be formed with protection enabled on one side
+  createAndConnect();
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_EQ(1, counters["spark.socket_filter_attached"]);
+}
+
+/*
+ * Flood iface3 well above `max_allowed_pps_per_interface`. Packets above the
+ * token bucket rate must be dropped before parsing, while the adjacency over
+ * iface1 is unaffected.
+ */
+TEST_F(SparkPacketProtectionFixture, InterfaceRateLimitTest) {
+  createAndConnect();
+
+  const auto rateLimitDrops =
+      getCounter("spark.packet_dropped.interface_rate_limit.sum");
+
+  // single byte carrying a valid compact field header, hence only the rate
+  // limit or the deserialization can reject it
+  injectPackets(std::string("\x1C"), 5000);
+
+  checkUntilTimeout(
+      [&]() {
+        return getCounter("spark.packet_dropped.interface_rate_limit.sum") >
+            rateLimitDrops;
+      },
+      std::chrono::seconds(5),
+      std::chrono::milliseconds(10));
+
+  verifyAdjacencyUp();
+}
+
+/*
+ * Packets not starting with a compact protocol field header are dropped
+ * before deserialization, while the adjacency over iface1 is unaffected.
+ */
+TEST_F(SparkPacketProtectionFixture, InvalidHeaderTest) {
+  createAndConnect();
+
+  const auto rateLimitDrops =
+      getCounter("spark.packet_dropped.interface_rate_limit.sum");
+  const auto headerDrops =
+      getCounter("spark.packet_dropped.invalid_header.sum");
+  const size_t numPackets{10};
+
+  injectPackets(std::string(64, '\xFF'), numPackets);
+
+  checkUntilTimeout(
+      [&]() {
+        return getCounter("spark.packet_dropped.invalid_header.sum") ==
+            headerDrops + numPackets;
+      },
+      std::chrono::seconds(5),
+      std::chrono::milliseconds(10));
+
+  // well below the interface rate, nothing is rate limited
+  EXPECT_EQ(
+      rateLimitDrops,
+      getCounter("spark.packet_dropped.interface_rate_limit.sum"));
+
+  verifyAdjacencyUp();
+}
+
 TEST_F(InitializationTestFixture, NeighborAdjDbHold) {
   // create 2 Spark instances with proper config and connect them
   createAndConnect();
@@ -642,6 +829,37 @@ TEST_F(SimpleSparkFixture, ExternalNeighborDown) {
   }
 }
 
+//
+// Spark will tear down neighbor upon unreachability of either its v6 or v4
+// transport address reported by NeighborMonitor, well before hold timer
+// expiry.
+//
+TEST_F(SimpleSparkFixture, NeighborUnreachableDown) {
+  for (const auto& addr : {ip2V6.first, ip2V4.first}) {
+    // create Spark instances and establish connections
+    createAndConnect();
+    const std::chrono::milliseconds holdTime(
+        *config1_->getSparkConfig().hold_time_s() * 1000);
+
+    LOG(INFO) << fmt::format("send {} unresolvable event", addr.str());
+    const auto startTime = std::chrono::steady_clock::now();
+    node1_->sendNeighborDownEvent(iface1, toBinaryAddress(addr));
+
+    // node-2 keeps sending keepalives, hold timer never expires on its own
+    auto events = node1_->waitForEvents(NB_DOWN, holdTime, holdTime);
+    ASSERT_TRUE(events.has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, holdTime);
+    EXPECT_EQ(iface1, events->back().localIfName);
+    EXPECT_EQ(nodeName2_, events->back().remoteNodeName);
+    LOG(INFO) << fmt::format(
+        "{} reported adjacency DOWN towards {}", nodeName1_, nodeName2_);
+
+    // start over with fresh instances for the next address family
+    node1_.reset();
+    node2_.reset();
+  }
+}
+
 //
 // Start 2 Spark instances and wait them forming adj. Then
 // restart one of them within GR window, make sure we get neighbor
@@ -892,6 +1110,62 @@ TEST_F(SimpleSparkFixture, InterfaceUpdateTest) {
       node1_->waitForEvents(NB_UP, waitTime, waitTime * 2).has_value());
 }
 
+//
+// Start 2 Spark instances and wait them forming adj. Then send incremental
+// interface updates to one instance. Interfaces not carried in the delta
+// should be left untouched while the ones carried should be applied.
+//
+TEST_F(SimpleSparkFixture, InterfaceDeltaUpdateTest) {
+  // create Spark instances and establish connections
+  createAndConnect();
+
+  auto waitTime = std::chrono::seconds(
+      *config1_->getSparkConfig().graceful_restart_time_s());
+
+  // delta carrying unrelated interface only. Adj over iface1 stays intact.
+  {
+    InterfaceDatabaseDelta ifDbDelta;
+    ifDbDelta.updatedInterfaces.emplace_back(InterfaceInfo(
+        "iface3" /* ifName */,
+        false /* isUp */,
+        3 /* ifIndex */,
+        {} /* networks */));
+    node1_->updateInterfaceDbDelta(ifDbDelta);
+
+    EXPECT_FALSE(
+        node1_->waitForEvents(NB_DOWN, waitTime, waitTime * 2).has_value());
+    ASSERT_TRUE(node1_->getActiveNeighborCount() == 1);
+  }
+
+  // delta bringing iface1 down. Adj DOWN should be reported ASAP.
+  {
+    InterfaceDatabaseDelta ifDbDelta;
+    ifDbDelta.updatedInterfaces.emplace_back(InterfaceInfo(
+        iface1 /* ifName */,
+        false /* isUp */,
+        ifIndex1 /* ifIndex */,
+        {ip1V4, ip1V6} /* networks */));
+    node1_->updateInterfaceDbDelta(ifDbDelta);
+
+    EXPECT_TRUE(node1_->waitForEvents(NB_DOWN).has_value());
+    ASSERT_TRUE(node1_->getTotalNeighborCount() == 0);
+  }
+
+  // delta bringing iface1 back. Adj UP should be reported.
+  {
+    InterfaceDatabaseDelta ifDbDelta;
+    ifDbDelta.updatedInterfaces.emplace_back(InterfaceInfo(
+        iface1 /* ifName */,
+        true /* isUp */,
+        ifIndex1 /* ifIndex */,
+        {ip1V4, ip1V6} /* networks */));
+    node1_->updateInterfaceDbDelta(ifDbDelta);
+
+    EXPECT_TRUE(node1_->waitForEvents(NB_UP).has_value());
+    ASSERT_TRUE(node1_->getActiveNeighborCount() == 1);
+  }
+}
+
 //
 // Start 2 Spark instances and wait them forming adj. Then
 // remove/add interface from one instance's perspective
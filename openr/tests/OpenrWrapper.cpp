@@ -329,7 +329,7 @@ OpenrWrapper<Serializer>::stop() {
 template <class Serializer>
 void
 OpenrWrapper<Serializer>::updateInterfaceDb(const InterfaceDatabase& ifDb) {
-  interfaceUpdatesQueue_.push(ifDb);
+  interfaceUpdatesQueue_.push(InterfaceDatabaseDelta(ifDb));
 }
 
 template <class Serializer>
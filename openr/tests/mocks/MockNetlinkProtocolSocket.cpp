@@ -183,7 +183,7 @@ MockNetlinkProtocolSocket::getAllIfAddresses() {
 }
 
 folly::SemiFuture<int>
-MockNetlinkProtocolSocket::addLink(const fbnl::Link& link) {
+MockNetlinkProtocolSocket::addLink(const fbnl::Link& link, bool publishEvent) {
   // Add or update link
   links_[link.getIfIndex()] = link;
 
@@ -191,7 +191,9 @@ MockNetlinkProtocolSocket::addLink(const fbnl::Link& link) {
   ifAddrs_.emplace(link.getIfIndex(), std::list<fbnl::IfAddress>());
 
   // Publish update via queue
-  netlinkEventsQueue_.push(link);
+  if (publishEvent) {
+    netlinkEventsQueue_.push(link);
+  }
 
   return folly::SemiFuture<int>(0);
 }
@@ -205,9 +207,77 @@ MockNetlinkProtocolSocket::getAllLinks() {
   return links;
 }
 
+folly::SemiFuture<int>
+MockNetlinkProtocolSocket::streamAllLinks(
+    std::function<void(fbnl::Link&&)> linkCb) {
+  for (auto& [_, link] : links_) {
+    linkCb(fbnl::Link(link));
+
+    // Emulate socket overrun after the first link got dumped
+    if (eventLossDuringDump_.exchange(false)) {
+      reportEventLoss();
+      return folly::SemiFuture<int>(-ENOBUFS);
+    }
+  }
+  return folly::SemiFuture<int>(0);
+}
+
+folly::SemiFuture<int>
+MockNetlinkProtocolSocket::streamAllIfAddresses(
+    std::function<void(fbnl::IfAddress&&)> addrCb) {
+  for (auto& [_, addrs] : ifAddrs_) {
+    for (auto& addr : addrs) {
+      addrCb(fbnl::IfAddress(addr));
+    }
+  }
+  return folly::SemiFuture<int>(0);
+}
+
+void
+MockNetlinkProtocolSocket::injectEventLoss(bool duringDump) {
+  if (duringDump) {
+    eventLossDuringDump_ = true;
+  } else {
+    reportEventLoss();
+  }
+}
+
+folly::SemiFuture<int>
+MockNetlinkProtocolSocket::addNeighbor(const fbnl::Neighbor& neighbor) {
+  // Neighbor must belong to existing link
+  if (not links_.count(neighbor.getIfIndex())) {
+    return folly::SemiFuture<int>(-ENXIO); // No such device or address
+  }
+
+  // Add or update neighbor
+  neighbors_.insert_or_assign(
+      std::make_pair(neighbor.getIfIndex(), neighbor.getDestination()),
+      neighbor);
+
+  // Publish update via queue
+  netlinkEventsQueue_.push(neighbor);
+  return folly::SemiFuture<int>(0);
+}
+
+folly::SemiFuture<int>
+MockNetlinkProtocolSocket::deleteNeighbor(const fbnl::Neighbor& neighbor) {
+  if (not neighbors_.erase(
+          std::make_pair(neighbor.getIfIndex(), neighbor.getDestination()))) {
+    return folly::SemiFuture<int>(-ENOENT);
+  }
+
+  // Publish update via queue
+  netlinkEventsQueue_.push(neighbor);
+  return folly::SemiFuture<int>(0);
+}
+
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Neighbor>, int>>
 MockNetlinkProtocolSocket::getAllNeighbors() {
-  CHECK(false) << "Not implemented";
+  std::vector<fbnl::Neighbor> neighbors;
+  for (auto& [_, neighbor] : neighbors_) {
+    neighbors.emplace_back(neighbor);
+  }
+  return neighbors;
 }
 
 } // namespace openr::fbnl
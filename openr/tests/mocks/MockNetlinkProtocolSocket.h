@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 
 #include <folly/io/async/EventBase.h>
@@ -43,9 +44,25 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
   explicit MockNetlinkProtocolSocket(folly::EventBase* evb);
 
   /**
-   * API to create links for testing purposes
+   * API to create links for testing purposes. Unset `publishEvent` to emulate
+   * loss of the LINK event.
    */
-  folly::SemiFuture<int> addLink(const fbnl::Link& link);
+  folly::SemiFuture<int> addLink(
+      const fbnl::Link& link, bool publishEvent = true);
+
+  /**
+   * API to emulate loss of events, i.e. netlink socket receive buffer overrun
+   * (ENOBUFS). With `duringDump` set, loss is reported while the next link
+   * dump is in progress instead, failing that dump with -ENOBUFS.
+   */
+  void injectEventLoss(bool duringDump = false);
+
+  /**
+   * API to add/update and delete neighbor entries for testing purposes. Each
+   * change is published as NEIGH event.
+   */
+  folly::SemiFuture<int> addNeighbor(const fbnl::Neighbor& neighbor);
+  folly::SemiFuture<int> deleteNeighbor(const fbnl::Neighbor& neighbor);
 
   /**
    * Overrides API of NetlinkProtocolSocket for testing
@@ -63,6 +80,11 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
   folly::SemiFuture<folly::Expected<std::vector<fbnl::Link>, int>> getAllLinks()
       override;
 
+  folly::SemiFuture<int> streamAllLinks(
+      std::function<void(fbnl::Link&&)> linkCb) override;
+  folly::SemiFuture<int> streamAllIfAddresses(
+      std::function<void(fbnl::IfAddress&&)> addrCb) override;
+
   folly::SemiFuture<folly::Expected<std::vector<fbnl::Neighbor>, int>>
   getAllNeighbors() override;
 
@@ -99,14 +121,21 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
   // NOTE: using map for ordered entries
   std::map<int, std::list<fbnl::IfAddress>> ifAddrs_;
 
+  // map<<ifIndex, destination> -> Neighbor>
+  // NOTE: using map for ordered entries
+  std::map<std::pair<int, folly::IPAddress>, fbnl::Neighbor> neighbors_;
+
   // map<protocolId -> map<prefix/label, Route>
   // NOTE: using map for ordered entries
   std::unordered_map<uint8_t, std::map<folly::CIDRNetwork, fbnl::Route>>
       unicastRoutes_;
   std::unordered_map<uint8_t, std::map<uint32_t, fbnl::Route>> mplsRoutes_;
 
-  // queue to publish LINK/ADDR updates
+  // queue to publish LINK/ADDR/NEIGH updates
   messaging::ReplicateQueue<NetlinkEvent> netlinkEventsQueue_;
+
+  // report event loss while next link dump is in progress
+  std::atomic<bool> eventLossDuringDump_{false};
 };
 
 } // namespace openr::fbnl
@@ -89,4 +89,28 @@ NetlinkEventsInjector::sendAddrEvent(
   }
 }
 
+void
+NetlinkEventsInjector::sendNeighborEvent(
+    const std::string& ifName,
+    const std::string& addr,
+    const int state,
+    const bool deleted) {
+  std::optional<int> ifIndex;
+  linkDb_.withRLock([&](auto& linkDb) { ifIndex = linkDb.at(ifName).ifIndex; });
+
+  // Send event to NetlinkProtocolSocket
+  CHECK(ifIndex.has_value()) << fmt::format("Unknown interface: {}", ifName);
+
+  fbnl::NeighborBuilder builder;
+  auto neighbor = builder.setIfIndex(ifIndex.value())
+                      .setDestination(folly::IPAddress(addr))
+                      .setState(state, deleted)
+                      .build();
+  if (deleted) {
+    nlSock_->deleteNeighbor(neighbor).get();
+  } else {
+    nlSock_->addNeighbor(neighbor).get();
+  }
+}
+
 } // namespace openr
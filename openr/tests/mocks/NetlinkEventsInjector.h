@@ -35,6 +35,14 @@ class NetlinkEventsInjector {
   void sendAddrEvent(
       const std::string& ifName, const std::string& prefix, const bool isValid);
 
+  // Send NEIGH event with given NUD state, e.g. NUD_FAILED, for neighbor
+  // `addr` on interface. Entry is removed from neighbor table if `deleted`.
+  void sendNeighborEvent(
+      const std::string& ifName,
+      const std::string& addr,
+      const int state,
+      const bool deleted = false);
+
  private:
   // mocked version of netlink protocols socket
   fbnl::MockNetlinkProtocolSocket* nlSock_{nullptr};
@@ -156,6 +156,13 @@ Watchdog::updateThreadCounters() {
         fmt::format("watchdog.evb_queue_size.{}", evb->getEvbName()),
         evb->getEvb()->getNotificationQueueSize());
   }
+
+  // Live memory of modules bound to dedicated jemalloc arenas. Unlike
+  // per-thread counters above, memory freed by other threads is accounted.
+  for (const auto& [name, bytes] : memory::getModuleArenaAllocatedBytes()) {
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.module_mem_usage_kb.{}", name), bytes / 1024);
+  }
 }
 
 void